@@ -0,0 +1,506 @@
+/*
+ * Native benchmarks for the quantum RNG library.
+ *
+ * Build and run with `npm run bench`, optionally followed by `-- <case>...`
+ * to select cases. With no arguments every case runs.
+ */
+#include "quantum_rng.h"
+#include "toeplitz.h"
+#include "statevector.h"
+#include "region.h"
+#include "block_ring.h"
+#include <pthread.h>
+#include <sched.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+static double now_sec(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+static double mb_per_sec(size_t bytes, double secs) {
+    return secs > 0 ? bytes / secs / (1024.0 * 1024.0) : 0.0;
+}
+
+// Keeps results of timed loops observable
+static volatile uint64_t bench_sink;
+
+static qrng_ctx *bench_ctx(void) {
+    qrng_ctx *ctx = NULL;
+    if (qrng_init(&ctx, NULL, 0) != QRNG_SUCCESS) {
+        fprintf(stderr, "qrng_init failed\n");
+        exit(1);
+    }
+    return ctx;
+}
+
+// Single-stream qrng_bytes against substream-parallel generation
+static void bench_bytes(void) {
+    static const size_t sizes[] = { 1 << 20, 8 << 20 };
+    qrng_ctx *ctx = bench_ctx();
+
+    printf("%-10s %12s %14s %14s\n", "bytes", "bytes", "serial MB/s", "parallel MB/s");
+    for (size_t i = 0; i < sizeof(sizes) / sizeof(sizes[0]); i++) {
+        size_t len = sizes[i];
+        uint8_t *out = malloc(len);
+        if (!out) exit(1);
+
+        size_t serial_len = len > (1 << 20) ? (1 << 20) : len;
+        double t0 = now_sec();
+        qrng_bytes(ctx, out, serial_len);
+        double serial = mb_per_sec(serial_len, now_sec() - t0);
+
+        t0 = now_sec();
+        qrng_bytes_parallel(ctx, out, len, 0);
+        double parallel = mb_per_sec(len, now_sec() - t0);
+
+        printf("%-10s %12zu %14.1f %14.1f\n", "", len, serial, parallel);
+        free(out);
+    }
+    qrng_free(ctx);
+}
+
+// Serial byte-wise entanglement against the chunk-parallel kernel
+static void bench_entangle(void) {
+    static const size_t sizes[] = { 64 << 10, 1 << 20, 16 << 20 };
+    qrng_ctx *ctx = bench_ctx();
+
+    printf("%-10s %12s %14s %14s\n", "entangle", "bytes", "serial MB/s", "parallel MB/s");
+    for (size_t i = 0; i < sizeof(sizes) / sizeof(sizes[0]); i++) {
+        size_t len = sizes[i];
+        uint8_t *a = calloc(len, 1), *b = calloc(len, 1);
+        if (!a || !b) exit(1);
+
+        // The serial path runs at a few MB/s; cap its sample size
+        size_t serial_len = len > (1 << 20) ? (1 << 20) : len;
+        double t0 = now_sec();
+        qrng_entangle_states(ctx, a, b, serial_len);
+        double serial = mb_per_sec(serial_len, now_sec() - t0);
+
+        int reps = 0;
+        t0 = now_sec();
+        double elapsed;
+        do {
+            qrng_entangle_states_parallel(ctx, a, b, len, 0);
+            reps++;
+        } while ((elapsed = now_sec() - t0) < 0.25);
+        double parallel = mb_per_sec(len * reps, elapsed);
+
+        printf("%-10s %12zu %14.1f %14.1f\n", "", len, serial, parallel);
+        free(a);
+        free(b);
+    }
+    qrng_free(ctx);
+}
+
+// Raw extractor throughput per ratio, then qrng_bytes with conditioning on
+static void bench_toeplitz(void) {
+    static const unsigned ratios[] = { 2, 4, 8 };
+    const size_t out_bits = QRNG_BUFFER_SIZE * 8;
+    const size_t out_len = 16 << 20;
+    qrng_ctx *ctx = bench_ctx();
+
+    printf("%-10s %12s %14s %14s %14s\n", "toeplitz", "ratio", "in MB/s", "out MB/s", "bytes MB/s");
+    for (size_t i = 0; i < sizeof(ratios) / sizeof(ratios[0]); i++) {
+        size_t in_bits = out_bits * ratios[i];
+        size_t blocks = out_len / (out_bits / 8);
+        uint8_t *seed = malloc(qrng_toeplitz_seed_bytes(in_bits, out_bits));
+        uint8_t *in = malloc(blocks * in_bits / 8);
+        uint8_t *out = malloc(out_len);
+        if (!seed || !in || !out) exit(1);
+
+        qrng_bytes(ctx, seed, qrng_toeplitz_seed_bytes(in_bits, out_bits));
+        memset(in, 0xa5, blocks * in_bits / 8);
+        qrng_toeplitz *t = qrng_toeplitz_create(seed, in_bits, out_bits);
+        if (!t) exit(1);
+
+        double t0 = now_sec();
+        qrng_toeplitz_extract(t, in, out, blocks);
+        double elapsed = now_sec() - t0;
+
+        // Generation dominates once conditioning is on; keep the sample small
+        size_t gen_len = 256 << 10;
+        qrng_set_conditioning(ctx, ratios[i]);
+        double g0 = now_sec();
+        qrng_bytes(ctx, out, gen_len);
+        double gen = mb_per_sec(gen_len, now_sec() - g0);
+
+        printf("%-10s %12u %14.1f %14.1f %14.1f\n", "", ratios[i],
+               mb_per_sec(blocks * in_bits / 8, elapsed), mb_per_sec(out_len, elapsed), gen);
+        qrng_toeplitz_destroy(t);
+        free(seed);
+        free(in);
+        free(out);
+    }
+    qrng_free(ctx);
+}
+
+// Context creation cost, and what the lazy path pays on its first read
+static void bench_init(void) {
+    enum { ROUNDS = 200 };
+    uint8_t buf[16];
+
+    printf("%-10s %12s %14s %14s\n", "init", "mode", "init us", "first read us");
+    for (int fast = 0; fast < 2; fast++) {
+        double init = 0, first = 0;
+        for (int i = 0; i < ROUNDS; i++) {
+            qrng_ctx *ctx = NULL;
+            double t0 = now_sec();
+            qrng_error err = fast ? qrng_init_fast(&ctx, NULL, 0) : qrng_init(&ctx, NULL, 0);
+            double t1 = now_sec();
+            if (err != QRNG_SUCCESS) exit(1);
+            qrng_bytes(ctx, buf, sizeof(buf));
+            double t2 = now_sec();
+
+            init += t1 - t0;
+            first += t2 - t1;
+            qrng_free(ctx);
+        }
+        printf("%-10s %12s %14.2f %14.2f\n", "", fast ? "fast" : "full",
+               init / ROUNDS * 1e6, first / ROUNDS * 1e6);
+    }
+}
+
+static int cmp_double(const void *a, const void *b) {
+    double x = *(const double *)a, y = *(const double *)b;
+    return (x > y) - (x < y);
+}
+
+// Per-call latency of small reads while reseeding every 64 KB, inline
+// through qrng_reseed against the background schedule
+static void bench_reseed(void) {
+    enum { CALLS = 8192, READ = 128, EVERY = 64 << 10 };
+    static const char *modes[] = { "none", "inline", "scheduled" };
+    double *lat = malloc(CALLS * sizeof(double));
+    uint8_t buf[READ], seed[QRNG_RESEED_BYTES];
+    if (!lat) exit(1);
+
+    printf("%-10s %12s %14s %14s %14s\n", "reseed", "mode", "p50 us", "p99.9 us", "max us");
+    for (int mode = 0; mode < 3; mode++) {
+        qrng_ctx *ctx = bench_ctx();
+        qrng_bytes(ctx, seed, sizeof(seed));
+        if (mode == 2) qrng_set_reseed_schedule(ctx, EVERY, 0);
+
+        for (int i = 0; i < CALLS; i++) {
+            double t0 = now_sec();
+            if (mode == 1 && i % (EVERY / READ) == 0) qrng_reseed(ctx, seed, sizeof(seed));
+            qrng_bytes(ctx, buf, READ);
+            lat[i] = (now_sec() - t0) * 1e6;
+        }
+
+        qsort(lat, CALLS, sizeof(double), cmp_double);
+        printf("%-10s %12s %14.2f %14.2f %14.2f\n", "", modes[mode],
+               lat[CALLS / 2], lat[CALLS * 999 / 1000], lat[CALLS - 1]);
+        qrng_free(ctx);
+    }
+    free(lat);
+}
+
+// Layers of single-qubit gates over every qubit, low qubits first, applied
+// gate by gate and then as one fused circuit
+static void bench_sim(void) {
+    static const unsigned sizes[] = { 16, 20, 24 };
+
+    printf("%-10s %12s %10s %14s %14s\n", "sim", "qubits", "mode", "ms/gate", "MB/s");
+    for (size_t i = 0; i < sizeof(sizes) / sizeof(sizes[0]); i++) {
+        qrng_state *s = qrng_state_create(sizes[i]);
+        qrng_circuit *c = qrng_circuit_create();
+        if (!s || !c) exit(1);
+
+        int layers = sizes[i] < 20 ? 64 : 4;
+        for (int l = 0; l < layers; l++) {
+            for (unsigned q = 0; q < s->qubits; q++) {
+                qrng_circuit_add(c, (l & 1) ? QRNG_GATE_RY : QRNG_GATE_H, q, 0, 0.3);
+            }
+        }
+        size_t gates = qrng_circuit_length(c);
+        size_t bytes = gates * s->dim * 2 * sizeof(double);
+
+        double t0 = now_sec();
+        for (int l = 0; l < layers; l++) {
+            for (unsigned q = 0; q < s->qubits; q++) {
+                qrng_state_apply(s, (l & 1) ? QRNG_GATE_RY : QRNG_GATE_H, q, 0, 0.3);
+            }
+        }
+        double gate_secs = now_sec() - t0;
+
+        t0 = now_sec();
+        qrng_circuit_run(c, s, 0);
+        double fused_secs = now_sec() - t0;
+
+        printf("%-10s %12u %10s %14.3f %14.1f\n", "", sizes[i], "gate",
+               gate_secs / gates * 1e3, mb_per_sec(bytes, gate_secs));
+        printf("%-10s %12u %10s %14.3f %14.1f\n", "", sizes[i], "fused",
+               fused_secs / gates * 1e3, mb_per_sec(bytes, fused_secs));
+        qrng_circuit_destroy(c);
+        qrng_state_destroy(s);
+    }
+}
+
+// Shots sampled from a uniform superposition, where every block holds shots
+static void bench_shots(void) {
+    static const size_t counts[] = { 1000, 100000, 1000000 };
+    qrng_ctx *ctx = bench_ctx();
+    uint64_t *out = malloc(counts[2] * sizeof(uint64_t));
+    if (!out || qrng_sim_attach(ctx, 22) != QRNG_SUCCESS) exit(1);
+
+    qrng_state *s = qrng_sim_state(ctx);
+    for (unsigned q = 0; q < s->qubits; q++) qrng_state_apply(s, QRNG_GATE_H, q, 0, 0);
+
+    printf("%-10s %12s %14s %14s\n", "shots", "shots", "ms", "ns/shot");
+    for (size_t i = 0; i < sizeof(counts) / sizeof(counts[0]); i++) {
+        double t0 = now_sec();
+        if (qrng_sample_shots(ctx, counts[i], out) != QRNG_SUCCESS) exit(1);
+        double secs = now_sec() - t0;
+        printf("%-10s %12zu %14.2f %14.1f\n", "", counts[i], secs * 1e3, secs / counts[i] * 1e9);
+    }
+
+    free(out);
+    qrng_free(ctx);
+}
+
+// Random 8-byte reads across a 1 GiB pool on base pages and on hugepages.
+// The pool is filled from a splitmix64 stream seeded by the generator; its
+// contents do not matter, only the page faults and TLB reach.
+static void bench_hugepages(void) {
+    enum { READS = 1 << 25 };
+    const size_t size = (size_t)1 << 30;
+    const size_t words = size / sizeof(uint64_t);
+    qrng_ctx *ctx = bench_ctx();
+
+    printf("%-10s %12s %14s %14s\n", "hugepages", "pages", "fill ms", "ns/read");
+    for (int huge = 0; huge < 2; huge++) {
+        qrng_region r;
+        if (qrng_region_alloc(&r, size, huge ? 0 : QRNG_REGION_NO_HUGEPAGES) != 0) {
+            printf("%-10s %12s %14s %14s\n", "", huge ? "huge" : "small", "-", "-");
+            continue;
+        }
+        uint64_t *pool = r.base;
+
+        uint64_t x = qrng_uint64(ctx);
+        double t0 = now_sec();
+        for (size_t i = 0; i < words; i++) {
+            uint64_t z = (x += 0x9e3779b97f4a7c15ULL);
+            z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+            z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+            pool[i] = z ^ (z >> 31);
+        }
+        double fill = now_sec() - t0;
+
+        uint64_t idx = qrng_uint64(ctx), sum = 0;
+        t0 = now_sec();
+        for (size_t i = 0; i < READS; i++) {
+            idx ^= idx << 13;
+            idx ^= idx >> 7;
+            idx ^= idx << 17;
+            sum += pool[idx & (words - 1)];
+        }
+        double reads = now_sec() - t0;
+
+        bench_sink = sum;
+        printf("%-10s %12s %14.1f %14.2f\n", "", qrng_page_kind_name(r.kind),
+               fill * 1e3, reads / READS * 1e9);
+        qrng_region_free(&r);
+    }
+    qrng_free(ctx);
+}
+
+// Per-call latency of request-sized reads with a gap between requests,
+// generated inline against served from the background refill pool
+static void bench_refill(void) {
+    enum { CALLS = 2048, READ = 512, POOL = 256 << 10 };
+    double *lat = malloc(CALLS * sizeof(double));
+    uint8_t buf[READ];
+    if (!lat) exit(1);
+
+    printf("%-10s %12s %14s %14s %14s %12s\n", "refill", "mode", "p50 us", "p99 us", "max us", "underflows");
+    for (int pooled = 0; pooled < 2; pooled++) {
+        qrng_ctx *ctx = bench_ctx();
+        if (pooled && qrng_set_background_refill(ctx, POOL) != QRNG_SUCCESS) exit(1);
+
+        // Idle time between requests, which is when the producer runs
+        struct timespec gap = { 0, 1000 * 1000 };
+
+        // Let the producer fill both halves first
+        qrng_refill_stats stats = { 0 };
+        while (pooled && qrng_get_refill_stats(ctx, &stats) == QRNG_SUCCESS && stats.refills < 2) {
+            nanosleep(&gap, NULL);
+        }
+
+        for (int i = 0; i < CALLS; i++) {
+            double t0 = now_sec();
+            qrng_bytes(ctx, buf, READ);
+            lat[i] = (now_sec() - t0) * 1e6;
+            nanosleep(&gap, NULL);
+        }
+
+        if (pooled) qrng_get_refill_stats(ctx, &stats);
+        qsort(lat, CALLS, sizeof(double), cmp_double);
+        printf("%-10s %12s %14.2f %14.2f %14.2f %12llu\n", "", pooled ? "pool" : "inline",
+               lat[CALLS / 2], lat[CALLS * 99 / 100], lat[CALLS - 1],
+               (unsigned long long)stats.underflows);
+        qrng_free(ctx);
+    }
+    free(lat);
+}
+
+// Block ring against the same FIFO behind a mutex, with every thread
+// pushing and popping one block per operation
+enum { RING_OPS = 1 << 17, RING_BLOCKS = 256 };
+
+typedef struct {
+    pthread_mutex_t lock;
+    uint8_t *blocks;
+    size_t head, tail;
+} locked_fifo;
+
+typedef struct {
+    qrng_block_ring *ring;
+    locked_fifo *fifo;
+    size_t ops;
+} ring_worker;
+
+static void *ring_worker_run(void *arg) {
+    ring_worker *w = arg;
+    uint8_t block[QRNG_RING_BLOCK] = { 1 };
+    uint64_t sum = 0;
+
+    for (size_t i = 0; i < w->ops; i++) {
+        if (w->ring) {
+            while (qrng_block_ring_push(w->ring, block) != 0) sched_yield();
+            while (qrng_block_ring_pop(w->ring, block) != 0) sched_yield();
+        } else {
+            locked_fifo *f = w->fifo;
+            pthread_mutex_lock(&f->lock);
+            memcpy(f->blocks + (f->tail++ % RING_BLOCKS) * QRNG_RING_BLOCK, block, QRNG_RING_BLOCK);
+            pthread_mutex_unlock(&f->lock);
+            pthread_mutex_lock(&f->lock);
+            memcpy(block, f->blocks + (f->head++ % RING_BLOCKS) * QRNG_RING_BLOCK, QRNG_RING_BLOCK);
+            pthread_mutex_unlock(&f->lock);
+        }
+        sum += block[i % QRNG_RING_BLOCK];
+    }
+    bench_sink = sum;
+    return NULL;
+}
+
+static void bench_ring(void) {
+    static const unsigned counts[] = { 1, 2, 4, 8, 16, 32, 64 };
+    pthread_t threads[64];
+    ring_worker workers[64];
+
+    printf("%-10s %12s %14s %14s\n", "ring", "threads", "ring Mops/s", "mutex Mops/s");
+    for (size_t c = 0; c < sizeof(counts) / sizeof(counts[0]); c++) {
+        unsigned n = counts[c];
+        double rate[2];
+
+        for (int locked = 0; locked < 2; locked++) {
+            qrng_block_ring *ring = locked ? NULL : qrng_block_ring_create(NULL, RING_BLOCKS, 0);
+            locked_fifo fifo = { .blocks = malloc(RING_BLOCKS * QRNG_RING_BLOCK) };
+            pthread_mutex_init(&fifo.lock, NULL);
+            if ((!locked && !ring) || !fifo.blocks) exit(1);
+
+            double t0 = now_sec();
+            for (unsigned i = 0; i < n; i++) {
+                workers[i] = (ring_worker){ ring, &fifo, RING_OPS / n };
+                pthread_create(&threads[i], NULL, ring_worker_run, &workers[i]);
+            }
+            for (unsigned i = 0; i < n; i++) pthread_join(threads[i], NULL);
+            rate[locked] = (RING_OPS / n) * n / (now_sec() - t0) / 1e6;
+
+            pthread_mutex_destroy(&fifo.lock);
+            free(fifo.blocks);
+            qrng_block_ring_destroy(ring);
+        }
+        printf("%-10s %12u %14.2f %14.2f\n", "", n, rate[0], rate[1]);
+    }
+}
+
+// Threads generating through their own qrng_tls_bytes() contexts against
+// one shared context behind a mutex
+enum { TLS_BYTES = 1 << 20, TLS_READ = 4096 };
+
+typedef struct {
+    qrng_ctx *shared;
+    pthread_mutex_t *lock;
+    size_t bytes;
+} tls_worker;
+
+static void *tls_worker_run(void *arg) {
+    tls_worker *w = arg;
+    uint8_t buf[TLS_READ];
+
+    for (size_t done = 0; done < w->bytes; done += TLS_READ) {
+        if (w->shared) {
+            pthread_mutex_lock(w->lock);
+            qrng_bytes(w->shared, buf, TLS_READ);
+            pthread_mutex_unlock(w->lock);
+        } else {
+            qrng_tls_bytes(buf, TLS_READ);
+        }
+    }
+    bench_sink = buf[0];
+    return NULL;
+}
+
+static void bench_tls(void) {
+    static const unsigned counts[] = { 1, 2, 4, 8 };
+    pthread_t threads[8];
+    tls_worker workers[8];
+    pthread_mutex_t lock = PTHREAD_MUTEX_INITIALIZER;
+    qrng_ctx *shared = bench_ctx();
+
+    printf("%-10s %12s %14s %14s\n", "tls", "threads", "tls MB/s", "mutex MB/s");
+    for (size_t c = 0; c < sizeof(counts) / sizeof(counts[0]); c++) {
+        unsigned n = counts[c];
+        double rate[2];
+
+        for (int locked = 0; locked < 2; locked++) {
+            double t0 = now_sec();
+            for (unsigned i = 0; i < n; i++) {
+                workers[i] = (tls_worker){ locked ? shared : NULL, &lock, TLS_BYTES / n };
+                pthread_create(&threads[i], NULL, tls_worker_run, &workers[i]);
+            }
+            for (unsigned i = 0; i < n; i++) pthread_join(threads[i], NULL);
+            rate[locked] = mb_per_sec(TLS_BYTES / n * n, now_sec() - t0);
+        }
+        printf("%-10s %12u %14.1f %14.1f\n", "", n, rate[0], rate[1]);
+    }
+    qrng_free(shared);
+}
+
+typedef struct {
+    const char *name;
+    void (*run)(void);
+} bench_case;
+
+static const bench_case cases[] = {
+    { "bytes", bench_bytes },
+    { "entangle", bench_entangle },
+    { "toeplitz", bench_toeplitz },
+    { "reseed", bench_reseed },
+    { "init", bench_init },
+    { "sim", bench_sim },
+    { "shots", bench_shots },
+    { "hugepages", bench_hugepages },
+    { "refill", bench_refill },
+    { "ring", bench_ring },
+    { "tls", bench_tls },
+};
+
+int main(int argc, char **argv) {
+    size_t ncases = sizeof(cases) / sizeof(cases[0]);
+
+    for (size_t i = 0; i < ncases; i++) {
+        int selected = argc < 2;
+        for (int a = 1; a < argc; a++) {
+            if (strcmp(argv[a], cases[i].name) == 0) selected = 1;
+        }
+        if (selected) cases[i].run();
+    }
+    return 0;
+}
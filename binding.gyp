@@ -3,12 +3,37 @@
     "target_name": "quantum_rng",
     "sources": [ 
       "src/binding.cc",
-      "src/quantum_rng/quantum_rng.c"
+      "src/quantum_rng/quantum_rng.c",
+      "src/quantum_rng/tls.c",
+      "src/parallel/parallel.c",
+      "src/health/health.c",
+      "src/extractor/toeplitz.c",
+      "src/entropy/sponge.c",
+      "src/entropy/seed_queue.c",
+      "src/entropy/jitter.c",
+      "src/entropy/sources.c",
+      "src/entropy/mixer.c",
+      "src/simulator/statevector.c",
+      "src/memory/region.c",
+      "src/numa/topology.c",
+      "src/numa/node_pool.c",
+      "src/producer/producer.c",
+      "src/ring/block_ring.c",
+      "src/ring/shm_ring.c"
     ],
     "include_dirs": [
       "<!@(node -p \"require('node-addon-api').include\")",
       "src/quantum_rng",
       "src/common",
+      "src/parallel",
+      "src/health",
+      "src/extractor",
+      "src/entropy",
+      "src/simulator",
+      "src/memory",
+      "src/numa",
+      "src/producer",
+      "src/ring",
       "src"
     ],
     "defines": [ 
@@ -30,6 +55,9 @@
         ],
         "cflags_cc": [
           "-std=c++17"
+        ],
+        "libraries": [
+          "-lrt"
         ]
       }]
     ]
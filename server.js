@@ -46,9 +46,63 @@ app.use(express.json());
 
 // Initialize quantum RNG
 console.log('Initializing QuantumRNG instance...');
-const rng = new QuantumRNG();
+// Seed from the OS and defer warm-up so the process starts serving sooner
+const rng = new QuantumRNG({ fastInit: true });
 console.log('QuantumRNG instance created successfully');
 
+// Feed OS, hardware, jitter and interrupt entropy into the generator from a
+// background thread
+rng.enableEntropySources();
+
+// Reseed in the background after 1 MiB of output or a minute, whichever first
+rng.setReseedSchedule(
+    Number(process.env.QRNG_RESEED_EVERY_BYTES) || 1024 * 1024,
+    Number(process.env.QRNG_RESEED_EVERY_MS) || 60 * 1000
+);
+
+// Serve getBytes from per-NUMA-node pools filled by node-local refill
+// threads, when QRNG_NODE_POOL_BYTES is set
+if (Number(process.env.QRNG_NODE_POOL_BYTES) > 0) {
+    rng.enableNodePools(Number(process.env.QRNG_NODE_POOL_BYTES));
+}
+
+// Serve requests from a double-buffered pool kept full by a background
+// producer thread, when QRNG_REFILL_BYTES is set
+if (Number(process.env.QRNG_REFILL_BYTES) > 0) {
+    rng.setBackgroundRefill(Number(process.env.QRNG_REFILL_BYTES));
+}
+
+// Or size that pool, and the threads refilling it, to measured demand
+// within a memory budget of QRNG_REFILL_MAX_BYTES and a CPU budget of
+// QRNG_REFILL_MAX_THREADS, holding QRNG_REFILL_TARGET_MS of demand per half
+if (Number(process.env.QRNG_REFILL_MAX_BYTES) > 0) {
+    rng.setAdaptiveRefill(
+        Number(process.env.QRNG_REFILL_MAX_BYTES),
+        Number(process.env.QRNG_REFILL_MAX_THREADS) || 0,
+        Number(process.env.QRNG_REFILL_TARGET_MS) || 0
+    );
+}
+
+// Share one lock-free ring of 4 KiB blocks, kept full by QRNG_RING_PRODUCERS
+// refill threads, with every instance in the process when QRNG_RING_BLOCKS
+// is set
+if (Number(process.env.QRNG_RING_BLOCKS) > 0) {
+    rng.enableBlockRing(
+        Number(process.env.QRNG_RING_BLOCKS),
+        Number(process.env.QRNG_RING_PRODUCERS) || 2
+    );
+}
+
+// Share pre-generated blocks with every process on the host, e.g. Node
+// cluster or PM2 workers, through the shared-memory segment named by
+// QRNG_SHM_RING. The first process to join produces for the others.
+if (process.env.QRNG_SHM_RING) {
+    rng.joinShmRing(
+        process.env.QRNG_SHM_RING,
+        Number(process.env.QRNG_SHM_RING_BLOCKS) || 1024
+    );
+}
+
 // Add boolean and choice functions to rng object
 rng.boolean = function(probability = 0.5) {
     return this.getDouble() < probability;
@@ -100,13 +154,205 @@ v1Router.use('/docs', swaggerUi.serve, swaggerUi.setup(swaggerDocs));
  *                   example: 1.0.0
  *                 entropy:
  *                   type: number
- *                   example: 8.2
+ *                   description: Min-entropy per output bit over recent output (0-1)
+ *                   example: 0.89
+ *                 healthTests:
+ *                   type: object
+ *                   description: Continuous SP 800-90B health test counters
+ *                   properties:
+ *                     windows:
+ *                       type: integer
+ *                     rctFailures:
+ *                       type: integer
+ *                     aptFailures:
+ *                       type: integer
+ *                     chiFailures:
+ *                       type: integer
+ *                     failures:
+ *                       type: integer
+ *                     lastChiSquare:
+ *                       type: number
+ *                     lastChiPValue:
+ *                       type: number
+ *                 entropySources:
+ *                   type: array
+ *                   description: Per-source counters of the background entropy mixer
+ *                   items:
+ *                     type: object
+ *                     properties:
+ *                       name:
+ *                         type: string
+ *                         example: getrandom
+ *                       polls:
+ *                         type: integer
+ *                       failures:
+ *                         type: integer
+ *                       bytes:
+ *                         type: integer
+ *                       creditedBits:
+ *                         type: integer
+ *                 nodePools:
+ *                   type: array
+ *                   description: Per-NUMA-node byte pools, empty unless QRNG_NODE_POOL_BYTES is set
+ *                   items:
+ *                     type: object
+ *                     properties:
+ *                       node:
+ *                         type: integer
+ *                       capacity:
+ *                         type: integer
+ *                       fill:
+ *                         type: integer
+ *                       refills:
+ *                         type: integer
+ *                       served:
+ *                         type: integer
+ *                       waits:
+ *                         type: integer
+ *                       bound:
+ *                         type: boolean
+ *                       pinned:
+ *                         type: boolean
+ *                 refill:
+ *                   type: object
+ *                   nullable: true
+ *                   description: Background refill pool, null unless QRNG_REFILL_BYTES or QRNG_REFILL_MAX_BYTES is set. Watermarks cover the time since the previous health check.
+ *                   properties:
+ *                     capacity:
+ *                       type: integer
+ *                     level:
+ *                       type: integer
+ *                     lowWater:
+ *                       type: integer
+ *                     highWater:
+ *                       type: integer
+ *                     served:
+ *                       type: integer
+ *                     swaps:
+ *                       type: integer
+ *                     underflows:
+ *                       type: integer
+ *                     refills:
+ *                       type: integer
+ *                     failures:
+ *                       type: integer
+ *                     meanRefillUs:
+ *                       type: number
+ *                     adaptive:
+ *                       type: boolean
+ *                       description: Pool sized from demand
+ *                     demandBps:
+ *                       type: integer
+ *                       description: Bytes/s requested, exponentially weighted average
+ *                     fillBps:
+ *                       type: integer
+ *                       description: Bytes/s one refill thread fills, exponentially weighted average
+ *                     target:
+ *                       type: integer
+ *                       description: Pool bytes the controller last chose
+ *                     maxCapacity:
+ *                       type: integer
+ *                     threads:
+ *                       type: integer
+ *                       description: Refill threads the controller last chose
+ *                     maxThreads:
+ *                       type: integer
+ *                     grows:
+ *                       type: integer
+ *                     shrinks:
+ *                       type: integer
+ *                     threadRaises:
+ *                       type: integer
+ *                     threadCuts:
+ *                       type: integer
+ *                     clipped:
+ *                       type: integer
+ *                       description: Decisions capped by the memory or CPU budget
+ *                     reclaims:
+ *                       type: integer
+ *                       description: Unread full halves dropped to shrink the pool
+ *                 blockRing:
+ *                   type: object
+ *                   nullable: true
+ *                   description: Shared block ring, null unless QRNG_RING_BLOCKS is set
+ *                   properties:
+ *                     capacity:
+ *                       type: integer
+ *                     depth:
+ *                       type: integer
+ *                     producers:
+ *                       type: integer
+ *                     pushed:
+ *                       type: integer
+ *                     popped:
+ *                       type: integer
+ *                     misses:
+ *                       type: integer
+ *                     sleeps:
+ *                       type: integer
+ *                     failures:
+ *                       type: integer
+ *                 shmRing:
+ *                   type: object
+ *                   nullable: true
+ *                   description: Host-wide shared-memory ring, null unless QRNG_SHM_RING is set
+ *                   properties:
+ *                     capacity:
+ *                       type: integer
+ *                     depth:
+ *                       type: integer
+ *                     pushed:
+ *                       type: integer
+ *                     popped:
+ *                       type: integer
+ *                     misses:
+ *                       type: integer
+ *                     sleeps:
+ *                       type: integer
+ *                     failures:
+ *                       type: integer
+ *                     recoveries:
+ *                       type: integer
+ *                     rejoins:
+ *                       type: integer
+ *                     producerPid:
+ *                       type: integer
+ *                     producerAlive:
+ *                       type: boolean
+ *                     isProducer:
+ *                       type: boolean
+ *                 pool:
+ *                   type: object
+ *                   description: Native work-stealing task pool
+ *                   properties:
+ *                     workers:
+ *                       type: integer
+ *                     threads:
+ *                       type: integer
+ *                     cpuLimit:
+ *                       type: integer
+ *                       description: CPUs allowed by the cgroup quota, 0 if unlimited
+ *                     tasks:
+ *                       type: integer
+ *                     steals:
+ *                       type: integer
+ *                     injected:
+ *                       type: integer
+ *                     sleeps:
+ *                       type: integer
  */
 v1Router.get('/health', (req, res) => {
     res.json({
         status: 'ok',
         version: QuantumRNG.getVersion(),
-        entropy: rng.getEntropyEstimate()
+        entropy: rng.getEntropyEstimate(),
+        healthTests: rng.getHealthStats(),
+        entropySources: rng.getEntropySources(),
+        nodePools: rng.getNodePoolStats(),
+        refill: rng.getRefillStats(),
+        blockRing: rng.getBlockRingStats(),
+        shmRing: rng.getShmRingStats(),
+        pool: QuantumRNG.getPoolStats()
     });
 });
 
@@ -146,7 +392,7 @@ v1Router.get('/health', (req, res) => {
  *       500:
  *         description: Server error
  */
-v1Router.get('/qrng/bytes/:count', (req, res) => {
+v1Router.get('/qrng/bytes/:count', async (req, res) => {
     try {
         const count = parseInt(req.params.count);
         if (isNaN(count) || count <= 0 || count > 1024) {
@@ -155,7 +401,8 @@ v1Router.get('/qrng/bytes/:count', (req, res) => {
             });
         }
         
-        const bytes = rng.getBytes(count);
+        // Generated on the native task pool, off the event loop
+        const bytes = await rng.getBytesAsync(count);
         res.json({
             bytes: bytes.toString('hex'),
             raw: Array.from(bytes)
@@ -383,6 +630,110 @@ v1Router.post('/qrng/choice', (req, res) => {
     }
 });
 
+// Limits for simulated circuits: 2^20 amplitudes are 16 MiB
+const CIRCUIT_MAX_QUBITS = 20;
+const CIRCUIT_MAX_GATES = 1000;
+const CIRCUIT_MAX_SHOTS = 100000;
+
+/**
+ * @swagger
+ * /v1/qrng/circuit:
+ *   post:
+ *     summary: Run a quantum circuit
+ *     description: Simulates a circuit on a state vector and returns a histogram of measurement shots
+ *     tags: [Random]
+ *     requestBody:
+ *       required: true
+ *       content:
+ *         application/json:
+ *           schema:
+ *             type: object
+ *             required:
+ *               - qubits
+ *               - gates
+ *             properties:
+ *               qubits:
+ *                 type: integer
+ *                 minimum: 1
+ *                 maximum: 20
+ *                 example: 2
+ *               gates:
+ *                 type: array
+ *                 maxItems: 1000
+ *                 items:
+ *                   type: object
+ *                   required:
+ *                     - gate
+ *                     - target
+ *                   properties:
+ *                     gate:
+ *                       type: string
+ *                       enum: [h, x, y, z, s, t, phase, rx, ry, rz, cnot]
+ *                     target:
+ *                       type: integer
+ *                     control:
+ *                       type: integer
+ *                       description: Control qubit for cnot
+ *                     theta:
+ *                       type: number
+ *                       description: Angle in radians for phase and rotations
+ *                 example: [{ "gate": "h", "target": 0 }, { "gate": "cnot", "control": 0, "target": 1 }]
+ *               shots:
+ *                 type: integer
+ *                 minimum: 1
+ *                 maximum: 100000
+ *                 default: 1024
+ *     responses:
+ *       200:
+ *         description: Shot histogram keyed by bitstring, highest qubit first
+ *         content:
+ *           application/json:
+ *             schema:
+ *               type: object
+ *               properties:
+ *                 qubits:
+ *                   type: integer
+ *                 shots:
+ *                   type: integer
+ *                 counts:
+ *                   type: object
+ *                   additionalProperties:
+ *                     type: integer
+ *                   example: { "00": 519, "11": 505 }
+ *       400:
+ *         description: Invalid circuit
+ *       500:
+ *         description: Server error
+ */
+v1Router.post('/qrng/circuit', (req, res) => {
+    const { qubits, gates, shots = 1024 } = req.body;
+
+    if (!Number.isInteger(qubits) || qubits < 1 || qubits > CIRCUIT_MAX_QUBITS) {
+        return res.status(400).json({
+            error: `Qubits must be an integer between 1 and ${CIRCUIT_MAX_QUBITS}`
+        });
+    }
+    if (!Array.isArray(gates) || gates.length > CIRCUIT_MAX_GATES) {
+        return res.status(400).json({
+            error: `Gates must be an array of at most ${CIRCUIT_MAX_GATES} gates`
+        });
+    }
+    if (!Number.isInteger(shots) || shots < 1 || shots > CIRCUIT_MAX_SHOTS) {
+        return res.status(400).json({
+            error: `Shots must be an integer between 1 and ${CIRCUIT_MAX_SHOTS}`
+        });
+    }
+
+    try {
+        rng.simReset(qubits);
+        rng.simRun(gates.map(g => [g.gate, g.target, g.gate === 'cnot' ? g.control : g.theta]));
+        res.json({ qubits, shots, counts: rng.simSample(shots) });
+    } catch (err) {
+        const status = err instanceof TypeError || err instanceof RangeError ? 400 : 500;
+        res.status(status).json({ error: err.message });
+    }
+});
+
 // Mount v1 router
 app.use('/v1', v1Router);
 
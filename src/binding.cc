@@ -1,8 +1,91 @@
 #include <napi.h>
+#include <algorithm>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
 
 // Declare C linkage for quantum_rng functions
 extern "C" {
 #include "quantum_rng.h"
+#include "mixer.h"
+#include "parallel.h"
+#include "statevector.h"
+#include "node_pool.h"
+#include "block_ring.h"
+#include "shm_ring.h"
+}
+
+// Process-wide entropy mixer, started by the first enableEntropySources()
+// call and shared by every instance for the life of the process
+static qrng_seed_queue* entropy_queue = nullptr;
+static qrng_mixer* entropy_mixer = nullptr;
+static std::once_flag entropy_once;
+
+// Process-wide per-NUMA-node pools, created by the first enableNodePools()
+// call and shared by every instance that enables them
+static qrng_node_pools* node_pools = nullptr;
+static std::once_flag node_pools_once;
+
+// Process-wide block ring, created by the first enableBlockRing() call and
+// shared by every instance, on any thread, that enables it
+static qrng_block_ring* block_ring = nullptr;
+static std::once_flag block_ring_once;
+
+// Host-wide shared-memory ring, joined by the first joinShmRing() call. The
+// process that creates the segment also runs its producer.
+static qrng_shm_ring* shm_ring = nullptr;
+static std::once_flag shm_ring_once;
+
+// Work handed to the native task pool by the *Async methods. The body runs
+// on a pool worker with a work context of the instance; finish and the
+// promise run back on the JS thread.
+struct PoolWork {
+    Napi::Promise::Deferred deferred;
+    Napi::ThreadSafeFunction tsfn;
+    std::vector<Napi::ObjectReference> keep;   // Buffers the body writes to, instance
+    std::function<qrng_error()> run;
+    std::function<qrng_error()> finish;        // Hands the work context back
+    std::function<Napi::Value(Napi::Env)> result;
+    qrng_error err = QRNG_SUCCESS;
+
+    explicit PoolWork(Napi::Env env) : deferred(Napi::Promise::Deferred::New(env)) {}
+};
+
+static void SettlePoolWork(Napi::Env env, Napi::Function, PoolWork* work) {
+    if (env != nullptr) {
+        Napi::HandleScope scope(env);
+        qrng_error err = work->finish ? work->finish() : QRNG_SUCCESS;
+        if (work->err == QRNG_SUCCESS) work->err = err;
+        if (work->err != QRNG_SUCCESS) {
+            work->deferred.Reject(Napi::Error::New(env, qrng_error_string(work->err)).Value());
+        } else {
+            work->deferred.Resolve(work->result ? work->result(env) : env.Undefined());
+        }
+    }
+    delete work;
+}
+
+static void RunPoolWork(void* arg) {
+    PoolWork* work = static_cast<PoolWork*>(arg);
+    work->err = work->run();
+    work->tsfn.NonBlockingCall(work, SettlePoolWork);
+    work->tsfn.Release();
+}
+
+static Napi::Value QueuePoolWork(Napi::Env env, PoolWork* work) {
+    Napi::Promise promise = work->deferred.Promise();
+    work->tsfn = Napi::ThreadSafeFunction::New(
+        env, Napi::Function::New(env, [](const Napi::CallbackInfo&) {}),
+        "QuantumRNG.poolWork", 0, 1);
+
+    if (qrng_pool_submit(RunPoolWork, work) != 0) {
+        work->err = QRNG_ERROR_NULL_BUFFER;
+        work->tsfn.Release();
+        SettlePoolWork(env, Napi::Function(), work);
+    }
+    return promise;
 }
 
 class QuantumRNG : public Napi::ObjectWrap<QuantumRNG> {
@@ -14,17 +97,56 @@ public:
 private:
     static Napi::FunctionReference constructor;
     qrng_ctx* ctx;
+    bool useNodePools = false;
+    uint64_t workSplits = 0;           // Contexts split off for async work
+    std::vector<qrng_ctx*> idleWork;   // Work contexts not in use, JS thread only
+
+    qrng_error TakeWorkCtx(const Napi::CallbackInfo& info, PoolWork* work, qrng_ctx** child);
 
     // Wrapped methods
     Napi::Value GetBytes(const Napi::CallbackInfo& info);
+    Napi::Value GetBytesAsync(const Napi::CallbackInfo& info);
     Napi::Value GetUInt64(const Napi::CallbackInfo& info);
     Napi::Value GetDouble(const Napi::CallbackInfo& info);
+    Napi::Value GetUInt32Array(const Napi::CallbackInfo& info);
+    Napi::Value GetUInt64Array(const Napi::CallbackInfo& info);
+    Napi::Value GetFloat32Array(const Napi::CallbackInfo& info);
+    Napi::Value GetFloat64Array(const Napi::CallbackInfo& info);
     Napi::Value GetRange32(const Napi::CallbackInfo& info);
     Napi::Value GetRange64(const Napi::CallbackInfo& info);
+    Napi::Value GetRange32Array(const Napi::CallbackInfo& info);
+    Napi::Value GetRange64Array(const Napi::CallbackInfo& info);
     Napi::Value GetEntropyEstimate(const Napi::CallbackInfo& info);
+    Napi::Value GetHealthStats(const Napi::CallbackInfo& info);
+    Napi::Value SetEntropyPolicy(const Napi::CallbackInfo& info);
+    Napi::Value GetEntropyBudget(const Napi::CallbackInfo& info);
+    Napi::Value SetConditioning(const Napi::CallbackInfo& info);
+    Napi::Value SetReseedSchedule(const Napi::CallbackInfo& info);
+    Napi::Value EnableEntropySources(const Napi::CallbackInfo& info);
+    Napi::Value AddEntropy(const Napi::CallbackInfo& info);
+    Napi::Value GetEntropySources(const Napi::CallbackInfo& info);
+    Napi::Value EnableNodePools(const Napi::CallbackInfo& info);
+    Napi::Value GetNodePoolStats(const Napi::CallbackInfo& info);
+    Napi::Value SetBackgroundRefill(const Napi::CallbackInfo& info);
+    Napi::Value SetAdaptiveRefill(const Napi::CallbackInfo& info);
+    Napi::Value GetRefillStats(const Napi::CallbackInfo& info);
+    Napi::Value EnableBlockRing(const Napi::CallbackInfo& info);
+    Napi::Value GetBlockRingStats(const Napi::CallbackInfo& info);
+    Napi::Value JoinShmRing(const Napi::CallbackInfo& info);
+    Napi::Value GetShmRingStats(const Napi::CallbackInfo& info);
     Napi::Value Reseed(const Napi::CallbackInfo& info);
     Napi::Value EntangleStates(const Napi::CallbackInfo& info);
+    Napi::Value EntangleStatesAsync(const Napi::CallbackInfo& info);
+    Napi::Value EntangleMany(const Napi::CallbackInfo& info);
     Napi::Value MeasureState(const Napi::CallbackInfo& info);
+    Napi::Value SimReset(const Napi::CallbackInfo& info);
+    Napi::Value SimGate(const Napi::CallbackInfo& info);
+    Napi::Value SimRun(const Napi::CallbackInfo& info);
+    Napi::Value SimProbability(const Napi::CallbackInfo& info);
+    Napi::Value SimMeasure(const Napi::CallbackInfo& info);
+    Napi::Value SimMeasureAll(const Napi::CallbackInfo& info);
+    Napi::Value SimSample(const Napi::CallbackInfo& info);
+    static Napi::Value GetPoolStats(const Napi::CallbackInfo& info);
     static Napi::Value GetVersion(const Napi::CallbackInfo& info);
 };
 
@@ -35,14 +157,48 @@ Napi::Object QuantumRNG::Init(Napi::Env env, Napi::Object exports) {
 
     Napi::Function func = DefineClass(env, "QuantumRNG", {
         InstanceMethod("getBytes", &QuantumRNG::GetBytes),
+        InstanceMethod("getBytesAsync", &QuantumRNG::GetBytesAsync),
         InstanceMethod("getUInt64", &QuantumRNG::GetUInt64),
         InstanceMethod("getDouble", &QuantumRNG::GetDouble),
+        InstanceMethod("getUInt32Array", &QuantumRNG::GetUInt32Array),
+        InstanceMethod("getUInt64Array", &QuantumRNG::GetUInt64Array),
+        InstanceMethod("getFloat32Array", &QuantumRNG::GetFloat32Array),
+        InstanceMethod("getFloat64Array", &QuantumRNG::GetFloat64Array),
         InstanceMethod("getRange32", &QuantumRNG::GetRange32),
         InstanceMethod("getRange64", &QuantumRNG::GetRange64),
+        InstanceMethod("getRange32Array", &QuantumRNG::GetRange32Array),
+        InstanceMethod("getRange64Array", &QuantumRNG::GetRange64Array),
         InstanceMethod("getEntropyEstimate", &QuantumRNG::GetEntropyEstimate),
+        InstanceMethod("getHealthStats", &QuantumRNG::GetHealthStats),
+        InstanceMethod("setEntropyPolicy", &QuantumRNG::SetEntropyPolicy),
+        InstanceMethod("getEntropyBudget", &QuantumRNG::GetEntropyBudget),
+        InstanceMethod("setConditioning", &QuantumRNG::SetConditioning),
+        InstanceMethod("setReseedSchedule", &QuantumRNG::SetReseedSchedule),
+        InstanceMethod("enableEntropySources", &QuantumRNG::EnableEntropySources),
+        InstanceMethod("addEntropy", &QuantumRNG::AddEntropy),
+        InstanceMethod("getEntropySources", &QuantumRNG::GetEntropySources),
+        InstanceMethod("enableNodePools", &QuantumRNG::EnableNodePools),
+        InstanceMethod("getNodePoolStats", &QuantumRNG::GetNodePoolStats),
+        InstanceMethod("setBackgroundRefill", &QuantumRNG::SetBackgroundRefill),
+        InstanceMethod("setAdaptiveRefill", &QuantumRNG::SetAdaptiveRefill),
+        InstanceMethod("getRefillStats", &QuantumRNG::GetRefillStats),
+        InstanceMethod("enableBlockRing", &QuantumRNG::EnableBlockRing),
+        InstanceMethod("getBlockRingStats", &QuantumRNG::GetBlockRingStats),
+        InstanceMethod("joinShmRing", &QuantumRNG::JoinShmRing),
+        InstanceMethod("getShmRingStats", &QuantumRNG::GetShmRingStats),
         InstanceMethod("reseed", &QuantumRNG::Reseed),
         InstanceMethod("entangleStates", &QuantumRNG::EntangleStates),
+        InstanceMethod("entangleStatesAsync", &QuantumRNG::EntangleStatesAsync),
+        InstanceMethod("entangleMany", &QuantumRNG::EntangleMany),
         InstanceMethod("measureState", &QuantumRNG::MeasureState),
+        InstanceMethod("simReset", &QuantumRNG::SimReset),
+        InstanceMethod("simGate", &QuantumRNG::SimGate),
+        InstanceMethod("simRun", &QuantumRNG::SimRun),
+        InstanceMethod("simProbability", &QuantumRNG::SimProbability),
+        InstanceMethod("simMeasure", &QuantumRNG::SimMeasure),
+        InstanceMethod("simMeasureAll", &QuantumRNG::SimMeasureAll),
+        InstanceMethod("simSample", &QuantumRNG::SimSample),
+        StaticMethod("getPoolStats", &QuantumRNG::GetPoolStats),
         StaticMethod("getVersion", &QuantumRNG::GetVersion)
     });
 
@@ -59,7 +215,15 @@ QuantumRNG::QuantumRNG(const Napi::CallbackInfo& info)
     try {
         fprintf(stderr, "QuantumRNG constructor start\n");
         
-        if (info.Length() > 0 && !info[0].IsBuffer()) {
+        // Accepts (seed?, options?) where options is { fastInit: boolean }.
+        // A Buffer or undefined seed puts the options second, so
+        // (undefined, options) works as well as (options).
+        size_t optionsArg = 0;
+        if (info.Length() > 0 && info[0].IsBuffer()) {
+            optionsArg = 1;
+        } else if (info.Length() > 1 && info[0].IsUndefined()) {
+            optionsArg = 1;
+        } else if (info.Length() > 0 && !info[0].IsObject() && !info[0].IsUndefined()) {
             fprintf(stderr, "Invalid seed type\n");
             throw Napi::TypeError::New(env, "Seed must be a Buffer");
         }
@@ -67,15 +231,22 @@ QuantumRNG::QuantumRNG(const Napi::CallbackInfo& info)
         const uint8_t* seed = nullptr;
         size_t seed_len = 0;
 
-        if (info.Length() > 0) {
+        if (info.Length() > 0 && info[0].IsBuffer()) {
             fprintf(stderr, "Processing seed buffer\n");
             Napi::Buffer<uint8_t> seedBuffer = info[0].As<Napi::Buffer<uint8_t>>();
             seed = seedBuffer.Data();
             seed_len = seedBuffer.Length();
         }
 
-        fprintf(stderr, "Calling qrng_init\n");
-        qrng_error err = qrng_init(&ctx, seed, seed_len);
+        bool fastInit = false;
+        if (info.Length() > optionsArg && info[optionsArg].IsObject()) {
+            Napi::Value fast = info[optionsArg].As<Napi::Object>().Get("fastInit");
+            fastInit = fast.IsBoolean() && fast.As<Napi::Boolean>().Value();
+        }
+
+        fprintf(stderr, "Calling %s\n", fastInit ? "qrng_init_fast" : "qrng_init");
+        qrng_error err = fastInit ? qrng_init_fast(&ctx, seed, seed_len)
+                                  : qrng_init(&ctx, seed, seed_len);
         fprintf(stderr, "qrng_init returned: %d\n", err);
         if (err != QRNG_SUCCESS) {
             if (ctx) {
@@ -90,6 +261,9 @@ QuantumRNG::QuantumRNG(const Napi::CallbackInfo& info)
 }
 
 QuantumRNG::~QuantumRNG() {
+    for (qrng_ctx* work : idleWork) {
+        qrng_free(work);
+    }
     if (ctx) {
         qrng_free(ctx);
         ctx = nullptr;
@@ -107,7 +281,9 @@ Napi::Value QuantumRNG::GetBytes(const Napi::CallbackInfo& info) {
     size_t length = info[0].As<Napi::Number>().Uint32Value();
     Napi::Buffer<uint8_t> buffer = Napi::Buffer<uint8_t>::New(env, length);
 
-    qrng_error err = qrng_bytes(ctx, buffer.Data(), length);
+    qrng_error err = useNodePools
+        ? qrng_node_pools_bytes(node_pools, buffer.Data(), length)
+        : qrng_bytes_parallel(ctx, buffer.Data(), length, 0);
     if (err != QRNG_SUCCESS) {
         Napi::Error::New(env, qrng_error_string(err)).ThrowAsJavaScriptException();
         return env.Null();
@@ -116,18 +292,155 @@ Napi::Value QuantumRNG::GetBytes(const Napi::CallbackInfo& info) {
     return buffer;
 }
 
+// Async work runs on a work context split from the instance, so it keeps
+// the instance's reseed schedule and conditioning without touching the
+// instance state from a worker. Work contexts are kept between requests,
+// one per request in flight, and are detached from the seed queue so that
+// queued seeds go to the instance. When the work settles, the health
+// counters its context gathered are merged into the instance's and the
+// context is handed back. The work also holds the instance, whose budget
+// it is charged to.
+qrng_error QuantumRNG::TakeWorkCtx(const Napi::CallbackInfo& info, PoolWork* work, qrng_ctx** child) {
+    if (idleWork.empty()) {
+        qrng_ctx* split = nullptr;
+        qrng_error err = qrng_split(ctx, workSplits++, &split);
+        if (err != QRNG_SUCCESS) return err;
+        qrng_attach_seed_queue(split, nullptr);
+        idleWork.push_back(split);
+    }
+    qrng_ctx* taken = idleWork.back();
+    idleWork.pop_back();
+
+    work->keep.push_back(Napi::Persistent(info.This().As<Napi::Object>()));
+    work->finish = [this, taken]() {
+        qrng_error err = qrng_merge_health(ctx, taken);
+        idleWork.push_back(taken);
+        return err;
+    };
+    *child = taken;
+    return QRNG_SUCCESS;
+}
+
+Napi::Value QuantumRNG::GetBytesAsync(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+
+    if (info.Length() < 1 || !info[0].IsNumber()) {
+        Napi::TypeError::New(env, "Number of bytes required").ThrowAsJavaScriptException();
+        return env.Null();
+    }
+
+    size_t length = info[0].As<Napi::Number>().Uint32Value();
+    Napi::Buffer<uint8_t> buffer = Napi::Buffer<uint8_t>::New(env, length);
+    uint8_t* out = buffer.Data();
+    bool pools = useNodePools;
+
+    PoolWork* work = new PoolWork(env);
+    work->keep.push_back(Napi::Persistent(buffer.As<Napi::Object>()));
+
+    // The instance's entropy policy decides now; the bytes are charged to
+    // it once delivered
+    qrng_ctx* child = nullptr;
+    qrng_error err = pools ? QRNG_SUCCESS : qrng_reserve_entropy(ctx, length);
+    if (err == QRNG_SUCCESS && !pools) err = TakeWorkCtx(info, work, &child);
+    if (err != QRNG_SUCCESS) {
+        delete work;
+        Napi::Error::New(env, qrng_error_string(err)).ThrowAsJavaScriptException();
+        return env.Null();
+    }
+
+    // Bytes the instance's background pool and block rings already hold
+    // are copied here, which also counts the request towards the demand
+    // the pool is sized to; only the rest is generated on the task pool
+    size_t ready = pools ? 0 : qrng_read_refill(ctx, out, length);
+
+    qrng_ctx* owner = ctx;
+    work->run = [out, length, ready, pools, owner, child]() {
+        if (pools) return qrng_node_pools_bytes(node_pools, out, length);
+
+        qrng_error err = ready < length || length == 0
+            ? qrng_bytes_parallel(child, out + ready, length - ready, 0)
+            : QRNG_SUCCESS;
+        if (err == QRNG_SUCCESS) qrng_charge_entropy(owner, length);
+        return err;
+    };
+    work->result = [work](Napi::Env) -> Napi::Value { return work->keep[0].Value(); };
+    return QueuePoolWork(env, work);
+}
+
 Napi::Value QuantumRNG::GetUInt64(const Napi::CallbackInfo& info) {
     Napi::Env env = info.Env();
-    uint64_t value = qrng_uint64(ctx);
+    uint64_t value;
+    qrng_error err = qrng_uint64_checked(ctx, &value);
+    if (err != QRNG_SUCCESS) {
+        Napi::Error::New(env, qrng_error_string(err)).ThrowAsJavaScriptException();
+        return env.Null();
+    }
     return Napi::BigInt::New(env, value);
 }
 
 Napi::Value QuantumRNG::GetDouble(const Napi::CallbackInfo& info) {
     Napi::Env env = info.Env();
-    double value = qrng_double(ctx);
+    double value;
+    qrng_error err = qrng_double_checked(ctx, &value);
+    if (err != QRNG_SUCCESS) {
+        Napi::Error::New(env, qrng_error_string(err)).ThrowAsJavaScriptException();
+        return env.Null();
+    }
     return Napi::Number::New(env, value);
 }
 
+// Shared body of the typed-array getters: allocate `count` elements, taken
+// from argument countArg, and let the fill function write them in place.
+template <typename T, typename Fill>
+static Napi::Value FillTypedArray(const Napi::CallbackInfo& info, Fill fill, size_t countArg = 0) {
+    Napi::Env env = info.Env();
+
+    if (info.Length() <= countArg || !info[countArg].IsNumber()) {
+        Napi::TypeError::New(env, "Number of elements required").ThrowAsJavaScriptException();
+        return env.Null();
+    }
+
+    size_t count = info[countArg].As<Napi::Number>().Uint32Value();
+    Napi::TypedArrayOf<T> array = Napi::TypedArrayOf<T>::New(env, count);
+    if (count == 0) {
+        return array;
+    }
+
+    qrng_error err = fill(array.Data(), count);
+    if (err != QRNG_SUCCESS) {
+        Napi::Error::New(env, qrng_error_string(err)).ThrowAsJavaScriptException();
+        return env.Null();
+    }
+
+    return array;
+}
+
+Napi::Value QuantumRNG::GetUInt32Array(const Napi::CallbackInfo& info) {
+    return FillTypedArray<uint32_t>(info, [this](uint32_t* out, size_t n) {
+        return qrng_fill_u32(ctx, out, n);
+    });
+}
+
+Napi::Value QuantumRNG::GetUInt64Array(const Napi::CallbackInfo& info) {
+    return FillTypedArray<uint64_t>(info, [this](uint64_t* out, size_t n) {
+        return qrng_fill_u64(ctx, out, n);
+    });
+}
+
+Napi::Value QuantumRNG::GetFloat32Array(const Napi::CallbackInfo& info) {
+    return FillTypedArray<float>(info, [this](float* out, size_t n) {
+        return qrng_fill_f32(ctx, out, n);
+    });
+}
+
+Napi::Value QuantumRNG::GetFloat64Array(const Napi::CallbackInfo& info) {
+    // Optional second argument selects the open interval (0,1)
+    bool open = info.Length() > 1 && info[1].ToBoolean().Value();
+    return FillTypedArray<double>(info, [this, open](double* out, size_t n) {
+        return open ? qrng_fill_f64_open(ctx, out, n) : qrng_fill_f64(ctx, out, n);
+    });
+}
+
 Napi::Value QuantumRNG::GetRange32(const Napi::CallbackInfo& info) {
     Napi::Env env = info.Env();
 
@@ -139,7 +452,12 @@ Napi::Value QuantumRNG::GetRange32(const Napi::CallbackInfo& info) {
     int32_t min = info[0].As<Napi::Number>().Int32Value();
     int32_t max = info[1].As<Napi::Number>().Int32Value();
 
-    int32_t value = qrng_range32(ctx, min, max);
+    int32_t value;
+    qrng_error err = qrng_range32_checked(ctx, min, max, &value);
+    if (err != QRNG_SUCCESS) {
+        Napi::Error::New(env, qrng_error_string(err)).ThrowAsJavaScriptException();
+        return env.Null();
+    }
     return Napi::Number::New(env, value);
 }
 
@@ -163,16 +481,483 @@ Napi::Value QuantumRNG::GetRange64(const Napi::CallbackInfo& info) {
         return env.Null();
     }
 
-    uint64_t value = qrng_range64(ctx, min, max);
+    uint64_t value;
+    qrng_error err = qrng_range64_checked(ctx, min, max, &value);
+    if (err != QRNG_SUCCESS) {
+        Napi::Error::New(env, qrng_error_string(err)).ThrowAsJavaScriptException();
+        return env.Null();
+    }
     return Napi::BigInt::New(env, value);
 }
 
+Napi::Value QuantumRNG::GetRange32Array(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+
+    if (info.Length() < 3 || !info[0].IsNumber() || !info[1].IsNumber()) {
+        Napi::TypeError::New(env, "Min, max and count required").ThrowAsJavaScriptException();
+        return env.Null();
+    }
+
+    int32_t min = info[0].As<Napi::Number>().Int32Value();
+    int32_t max = info[1].As<Napi::Number>().Int32Value();
+
+    return FillTypedArray<int32_t>(info, [this, min, max](int32_t* out, size_t n) {
+        return qrng_range32_array(ctx, min, max, out, n);
+    }, 2);
+}
+
+Napi::Value QuantumRNG::GetRange64Array(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+
+    if (info.Length() < 3 || !info[0].IsBigInt() || !info[1].IsBigInt()) {
+        Napi::TypeError::New(env, "Min, max and count required").ThrowAsJavaScriptException();
+        return env.Null();
+    }
+
+    bool lossless;
+    uint64_t min = info[0].As<Napi::BigInt>().Uint64Value(&lossless);
+    if (!lossless) {
+        Napi::Error::New(env, "Loss of precision in min value").ThrowAsJavaScriptException();
+        return env.Null();
+    }
+    uint64_t max = info[1].As<Napi::BigInt>().Uint64Value(&lossless);
+    if (!lossless) {
+        Napi::Error::New(env, "Loss of precision in max value").ThrowAsJavaScriptException();
+        return env.Null();
+    }
+
+    return FillTypedArray<uint64_t>(info, [this, min, max](uint64_t* out, size_t n) {
+        return qrng_range64_array(ctx, min, max, out, n);
+    }, 2);
+}
+
 Napi::Value QuantumRNG::GetEntropyEstimate(const Napi::CallbackInfo& info) {
     Napi::Env env = info.Env();
     double entropy = qrng_get_entropy_estimate(ctx);
     return Napi::Number::New(env, entropy);
 }
 
+Napi::Value QuantumRNG::GetHealthStats(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+
+    qrng_health_stats stats;
+    qrng_error err = qrng_get_health_stats(ctx, &stats);
+    if (err != QRNG_SUCCESS) {
+        Napi::Error::New(env, qrng_error_string(err)).ThrowAsJavaScriptException();
+        return env.Null();
+    }
+
+    Napi::Object result = Napi::Object::New(env);
+    result.Set("windows", Napi::Number::New(env, (double)stats.windows));
+    result.Set("rctFailures", Napi::Number::New(env, (double)stats.rct_failures));
+    result.Set("aptFailures", Napi::Number::New(env, (double)stats.apt_failures));
+    result.Set("chiFailures", Napi::Number::New(env, (double)stats.chi_failures));
+    result.Set("failures", Napi::Number::New(env, (double)stats.failures));
+    result.Set("lastChiSquare", Napi::Number::New(env, stats.last_chi_square));
+    result.Set("lastChiPValue", Napi::Number::New(env, stats.last_chi_pvalue));
+    return result;
+}
+
+static const char* const kEntropyPolicyNames[] = { "none", "block", "reseed", "fail" };
+
+Napi::Value QuantumRNG::SetEntropyPolicy(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+
+    if (info.Length() < 1 || !info[0].IsString()) {
+        Napi::TypeError::New(env, "Policy name required").ThrowAsJavaScriptException();
+        return env.Null();
+    }
+
+    std::string name = info[0].As<Napi::String>().Utf8Value();
+    for (int i = 0; i <= QRNG_ENTROPY_POLICY_FAIL; i++) {
+        if (name == kEntropyPolicyNames[i]) {
+            qrng_set_entropy_policy(ctx, (qrng_entropy_policy)i);
+            return env.Undefined();
+        }
+    }
+
+    Napi::TypeError::New(env, "Policy must be one of none, block, reseed, fail").ThrowAsJavaScriptException();
+    return env.Null();
+}
+
+Napi::Value QuantumRNG::GetEntropyBudget(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+
+    qrng_entropy_budget budget;
+    qrng_error err = qrng_get_entropy_budget(ctx, &budget);
+    if (err != QRNG_SUCCESS) {
+        Napi::Error::New(env, qrng_error_string(err)).ThrowAsJavaScriptException();
+        return env.Null();
+    }
+
+    Napi::Object result = Napi::Object::New(env);
+    result.Set("creditedBits", Napi::Number::New(env, (double)budget.credited_bits));
+    result.Set("drawnBits", Napi::Number::New(env, (double)budget.drawn_bits));
+    result.Set("availableBits", Napi::Number::New(env, (double)budget.available_bits));
+    result.Set("reseeds", Napi::Number::New(env, (double)budget.reseeds));
+    result.Set("scheduledReseeds", Napi::Number::New(env, (double)budget.scheduled_reseeds));
+    result.Set("policy", Napi::String::New(env, kEntropyPolicyNames[budget.policy]));
+    return result;
+}
+
+Napi::Value QuantumRNG::SetConditioning(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+
+    if (info.Length() < 1 || !info[0].IsNumber()) {
+        Napi::TypeError::New(env, "Conditioning ratio required").ThrowAsJavaScriptException();
+        return env.Null();
+    }
+
+    int32_t ratio = info[0].As<Napi::Number>().Int32Value();
+    if (ratio < 0 || ratio > QRNG_MAX_CONDITIONING_RATIO) {
+        Napi::RangeError::New(env, "Conditioning ratio must be between 0 and 8").ThrowAsJavaScriptException();
+        return env.Null();
+    }
+
+    qrng_error err = qrng_set_conditioning(ctx, (unsigned)ratio);
+    if (err != QRNG_SUCCESS) {
+        Napi::Error::New(env, qrng_error_string(err)).ThrowAsJavaScriptException();
+        return env.Null();
+    }
+    return env.Undefined();
+}
+
+Napi::Value QuantumRNG::SetReseedSchedule(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+
+    if (info.Length() < 2 || !info[0].IsNumber() || !info[1].IsNumber()) {
+        Napi::TypeError::New(env, "Byte and millisecond thresholds required").ThrowAsJavaScriptException();
+        return env.Null();
+    }
+
+    int64_t bytes = info[0].As<Napi::Number>().Int64Value();
+    int64_t ms = info[1].As<Napi::Number>().Int64Value();
+    if (bytes < 0 || ms < 0) {
+        Napi::RangeError::New(env, "Thresholds must not be negative").ThrowAsJavaScriptException();
+        return env.Null();
+    }
+
+    qrng_error err = qrng_set_reseed_schedule(ctx, (uint64_t)bytes, (uint64_t)ms);
+    if (err != QRNG_SUCCESS) {
+        Napi::Error::New(env, qrng_error_string(err)).ThrowAsJavaScriptException();
+        return env.Null();
+    }
+    return env.Undefined();
+}
+
+Napi::Value QuantumRNG::EnableEntropySources(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+
+    std::call_once(entropy_once, []() {
+        qrng_seed_queue* queue = qrng_seed_queue_create(64);
+        qrng_mixer* mixer = queue ? qrng_mixer_create(queue) : nullptr;
+        if (mixer && qrng_mixer_add_default_sources(mixer) > 0 && qrng_mixer_start(mixer) == 0) {
+            entropy_queue = queue;
+            entropy_mixer = mixer;
+            return;
+        }
+        qrng_mixer_destroy(mixer);
+        qrng_seed_queue_destroy(queue);
+    });
+
+    if (!entropy_mixer) {
+        Napi::Error::New(env, "Failed to start entropy sources").ThrowAsJavaScriptException();
+        return env.Null();
+    }
+
+    qrng_attach_seed_queue(ctx, entropy_queue);
+    return env.Undefined();
+}
+
+Napi::Value QuantumRNG::AddEntropy(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+
+    if (info.Length() < 2 || !info[0].IsBuffer() || !info[1].IsNumber()) {
+        Napi::TypeError::New(env, "Seed buffer and entropy bits required").ThrowAsJavaScriptException();
+        return env.Null();
+    }
+    if (!entropy_mixer) {
+        Napi::Error::New(env, "Entropy sources are not enabled").ThrowAsJavaScriptException();
+        return env.Null();
+    }
+
+    Napi::Buffer<uint8_t> seed = info[0].As<Napi::Buffer<uint8_t>>();
+    int64_t bits = info[1].As<Napi::Number>().Int64Value();
+    if (bits < 0 || bits > UINT32_MAX) {
+        Napi::RangeError::New(env, "Entropy bits out of range").ThrowAsJavaScriptException();
+        return env.Null();
+    }
+
+    if (qrng_mixer_add_seed(entropy_mixer, seed.Data(), seed.Length(), (uint32_t)bits) != 0) {
+        Napi::Error::New(env, "Entropy inbox is full").ThrowAsJavaScriptException();
+        return env.Null();
+    }
+    return env.Undefined();
+}
+
+Napi::Value QuantumRNG::GetEntropySources(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    Napi::Array result = Napi::Array::New(env);
+    if (!entropy_mixer) return result;
+
+    qrng_source_stats stats[QRNG_MIXER_MAX_SOURCES + 1];
+    size_t n = qrng_mixer_get_stats(entropy_mixer, stats, QRNG_MIXER_MAX_SOURCES + 1);
+    for (size_t i = 0; i < n; i++) {
+        Napi::Object source = Napi::Object::New(env);
+        source.Set("name", Napi::String::New(env, stats[i].name));
+        source.Set("polls", Napi::Number::New(env, (double)stats[i].polls));
+        source.Set("failures", Napi::Number::New(env, (double)stats[i].failures));
+        source.Set("bytes", Napi::Number::New(env, (double)stats[i].bytes));
+        source.Set("creditedBits", Napi::Number::New(env, (double)stats[i].credited_bits));
+        result.Set((uint32_t)i, source);
+    }
+    return result;
+}
+
+Napi::Value QuantumRNG::EnableNodePools(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+
+    if (info.Length() < 1 || !info[0].IsNumber()) {
+        Napi::TypeError::New(env, "Pool bytes per node required").ThrowAsJavaScriptException();
+        return env.Null();
+    }
+
+    int64_t bytes = info[0].As<Napi::Number>().Int64Value();
+    if (bytes <= 0) {
+        Napi::RangeError::New(env, "Pool size must be positive").ThrowAsJavaScriptException();
+        return env.Null();
+    }
+
+    // The first caller's context seeds every node; later sizes are ignored
+    std::call_once(node_pools_once, [this, bytes]() {
+        node_pools = qrng_node_pools_create(ctx, (size_t)bytes);
+    });
+
+    if (!node_pools) {
+        Napi::Error::New(env, "Failed to start node pools").ThrowAsJavaScriptException();
+        return env.Null();
+    }
+
+    useNodePools = true;
+    return env.Undefined();
+}
+
+Napi::Value QuantumRNG::GetNodePoolStats(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    Napi::Array result = Napi::Array::New(env);
+    if (!node_pools) return result;
+
+    qrng_node_pool_stats stats[QRNG_NUMA_MAX_NODES];
+    size_t n = qrng_node_pools_get_stats(node_pools, stats, QRNG_NUMA_MAX_NODES);
+    for (size_t i = 0; i < n; i++) {
+        Napi::Object pool = Napi::Object::New(env);
+        pool.Set("node", Napi::Number::New(env, stats[i].node));
+        pool.Set("capacity", Napi::Number::New(env, (double)stats[i].capacity));
+        pool.Set("fill", Napi::Number::New(env, (double)stats[i].fill));
+        pool.Set("refills", Napi::Number::New(env, (double)stats[i].refills));
+        pool.Set("served", Napi::Number::New(env, (double)stats[i].served));
+        pool.Set("waits", Napi::Number::New(env, (double)stats[i].waits));
+        pool.Set("bound", Napi::Boolean::New(env, stats[i].bound != 0));
+        pool.Set("pinned", Napi::Boolean::New(env, stats[i].pinned != 0));
+        result.Set((uint32_t)i, pool);
+    }
+    return result;
+}
+
+Napi::Value QuantumRNG::SetBackgroundRefill(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+
+    if (info.Length() < 1 || !info[0].IsNumber()) {
+        Napi::TypeError::New(env, "Pool bytes required").ThrowAsJavaScriptException();
+        return env.Null();
+    }
+
+    int64_t bytes = info[0].As<Napi::Number>().Int64Value();
+    if (bytes < 0) {
+        Napi::RangeError::New(env, "Pool size must not be negative").ThrowAsJavaScriptException();
+        return env.Null();
+    }
+
+    qrng_error err = qrng_set_background_refill(ctx, (size_t)bytes);
+    if (err != QRNG_SUCCESS) {
+        Napi::Error::New(env, qrng_error_string(err)).ThrowAsJavaScriptException();
+        return env.Null();
+    }
+    return env.Undefined();
+}
+
+Napi::Value QuantumRNG::SetAdaptiveRefill(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+
+    if (info.Length() < 1 || !info[0].IsNumber()) {
+        Napi::TypeError::New(env, "Memory budget in bytes required").ThrowAsJavaScriptException();
+        return env.Null();
+    }
+
+    int64_t bytes = info[0].As<Napi::Number>().Int64Value();
+    int64_t threads = info.Length() > 1 && info[1].IsNumber()
+        ? info[1].As<Napi::Number>().Int64Value() : 0;
+    int64_t targetMs = info.Length() > 2 && info[2].IsNumber()
+        ? info[2].As<Napi::Number>().Int64Value() : 0;
+    if (bytes < 0 || threads < 0 || targetMs < 0 || targetMs > UINT32_MAX) {
+        Napi::RangeError::New(env, "Budgets must not be negative").ThrowAsJavaScriptException();
+        return env.Null();
+    }
+
+    // A zero memory budget stops the producer, as in setBackgroundRefill()
+    qrng_refill_budget budget = { (size_t)bytes, (size_t)threads, (uint32_t)targetMs };
+    qrng_error err = qrng_set_adaptive_refill(ctx, bytes ? &budget : nullptr);
+    if (err != QRNG_SUCCESS) {
+        Napi::Error::New(env, qrng_error_string(err)).ThrowAsJavaScriptException();
+        return env.Null();
+    }
+    return env.Undefined();
+}
+
+Napi::Value QuantumRNG::GetRefillStats(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+
+    qrng_refill_stats stats;
+    if (qrng_get_refill_stats(ctx, &stats) != QRNG_SUCCESS) {
+        return env.Null();
+    }
+
+    Napi::Object result = Napi::Object::New(env);
+    result.Set("capacity", Napi::Number::New(env, (double)stats.capacity));
+    result.Set("level", Napi::Number::New(env, (double)stats.level));
+    result.Set("lowWater", Napi::Number::New(env, (double)stats.low_water));
+    result.Set("highWater", Napi::Number::New(env, (double)stats.high_water));
+    result.Set("served", Napi::Number::New(env, (double)stats.served));
+    result.Set("swaps", Napi::Number::New(env, (double)stats.swaps));
+    result.Set("underflows", Napi::Number::New(env, (double)stats.underflows));
+    result.Set("refills", Napi::Number::New(env, (double)stats.refills));
+    result.Set("failures", Napi::Number::New(env, (double)stats.failures));
+    result.Set("meanRefillUs", Napi::Number::New(env, stats.mean_refill_us));
+    result.Set("adaptive", Napi::Boolean::New(env, stats.adaptive != 0));
+    result.Set("demandBps", Napi::Number::New(env, (double)stats.demand_bps));
+    result.Set("fillBps", Napi::Number::New(env, (double)stats.fill_bps));
+    result.Set("target", Napi::Number::New(env, (double)stats.target));
+    result.Set("maxCapacity", Napi::Number::New(env, (double)stats.max_capacity));
+    result.Set("threads", Napi::Number::New(env, stats.threads));
+    result.Set("maxThreads", Napi::Number::New(env, stats.max_threads));
+    result.Set("grows", Napi::Number::New(env, (double)stats.grows));
+    result.Set("shrinks", Napi::Number::New(env, (double)stats.shrinks));
+    result.Set("threadRaises", Napi::Number::New(env, (double)stats.thread_raises));
+    result.Set("threadCuts", Napi::Number::New(env, (double)stats.thread_cuts));
+    result.Set("clipped", Napi::Number::New(env, (double)stats.clipped));
+    result.Set("reclaims", Napi::Number::New(env, (double)stats.reclaims));
+    return result;
+}
+
+Napi::Value QuantumRNG::EnableBlockRing(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+
+    if (info.Length() < 2 || !info[0].IsNumber() || !info[1].IsNumber()) {
+        Napi::TypeError::New(env, "Block count and producer count required").ThrowAsJavaScriptException();
+        return env.Null();
+    }
+
+    int64_t blocks = info[0].As<Napi::Number>().Int64Value();
+    int64_t producers = info[1].As<Napi::Number>().Int64Value();
+    if (blocks <= 0 || producers < 1 || producers > QRNG_RING_MAX_PRODUCERS) {
+        Napi::RangeError::New(env, "Block count must be positive and producers between 1 and 64")
+            .ThrowAsJavaScriptException();
+        return env.Null();
+    }
+
+    // The first caller's context seeds the producers; later sizes are ignored
+    std::call_once(block_ring_once, [this, blocks, producers]() {
+        block_ring = qrng_block_ring_create(ctx, (size_t)blocks, (unsigned)producers);
+    });
+
+    if (!block_ring) {
+        Napi::Error::New(env, "Failed to start block ring").ThrowAsJavaScriptException();
+        return env.Null();
+    }
+
+    qrng_error err = qrng_attach_block_ring(ctx, block_ring);
+    if (err != QRNG_SUCCESS) {
+        Napi::Error::New(env, qrng_error_string(err)).ThrowAsJavaScriptException();
+        return env.Null();
+    }
+    return env.Undefined();
+}
+
+Napi::Value QuantumRNG::GetBlockRingStats(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    if (!block_ring) return env.Null();
+
+    qrng_block_ring_stats stats;
+    qrng_block_ring_get_stats(block_ring, &stats);
+
+    Napi::Object result = Napi::Object::New(env);
+    result.Set("capacity", Napi::Number::New(env, (double)stats.capacity));
+    result.Set("depth", Napi::Number::New(env, (double)stats.depth));
+    result.Set("producers", Napi::Number::New(env, stats.producers));
+    result.Set("pushed", Napi::Number::New(env, (double)stats.pushed));
+    result.Set("popped", Napi::Number::New(env, (double)stats.popped));
+    result.Set("misses", Napi::Number::New(env, (double)stats.misses));
+    result.Set("sleeps", Napi::Number::New(env, (double)stats.sleeps));
+    result.Set("failures", Napi::Number::New(env, (double)stats.failures));
+    return result;
+}
+
+Napi::Value QuantumRNG::JoinShmRing(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+
+    if (info.Length() < 2 || !info[0].IsString() || !info[1].IsNumber()) {
+        Napi::TypeError::New(env, "Segment name and block count required").ThrowAsJavaScriptException();
+        return env.Null();
+    }
+
+    std::string name = info[0].As<Napi::String>().Utf8Value();
+    int64_t blocks = info[1].As<Napi::Number>().Int64Value();
+    if (name.empty() || name.size() > QRNG_SHM_RING_NAME_MAX + 1 || blocks <= 0) {
+        Napi::RangeError::New(env, "Invalid segment name or block count").ThrowAsJavaScriptException();
+        return env.Null();
+    }
+
+    // The first caller's name and size win; later calls share the handle
+    std::call_once(shm_ring_once, [this, &name, blocks]() {
+        shm_ring = qrng_shm_ring_join(name.c_str(), (size_t)blocks, ctx);
+    });
+
+    if (!shm_ring) {
+        Napi::Error::New(env, "Failed to join shared ring").ThrowAsJavaScriptException();
+        return env.Null();
+    }
+
+    qrng_error err = qrng_attach_shm_ring(ctx, shm_ring);
+    if (err != QRNG_SUCCESS) {
+        Napi::Error::New(env, qrng_error_string(err)).ThrowAsJavaScriptException();
+        return env.Null();
+    }
+    return env.Undefined();
+}
+
+Napi::Value QuantumRNG::GetShmRingStats(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    if (!shm_ring) return env.Null();
+
+    qrng_shm_ring_stats stats;
+    qrng_shm_ring_get_stats(shm_ring, &stats);
+
+    Napi::Object result = Napi::Object::New(env);
+    result.Set("capacity", Napi::Number::New(env, (double)stats.capacity));
+    result.Set("depth", Napi::Number::New(env, (double)stats.depth));
+    result.Set("pushed", Napi::Number::New(env, (double)stats.pushed));
+    result.Set("popped", Napi::Number::New(env, (double)stats.popped));
+    result.Set("misses", Napi::Number::New(env, (double)stats.misses));
+    result.Set("sleeps", Napi::Number::New(env, (double)stats.sleeps));
+    result.Set("failures", Napi::Number::New(env, (double)stats.failures));
+    result.Set("recoveries", Napi::Number::New(env, (double)stats.recoveries));
+    result.Set("rejoins", Napi::Number::New(env, (double)stats.rejoins));
+    result.Set("producerPid", Napi::Number::New(env, stats.producer_pid));
+    result.Set("producerAlive", Napi::Boolean::New(env, stats.producer_alive != 0));
+    result.Set("isProducer", Napi::Boolean::New(env, stats.is_producer != 0));
+    return result;
+}
+
 Napi::Value QuantumRNG::Reseed(const Napi::CallbackInfo& info) {
     Napi::Env env = info.Env();
 
@@ -208,7 +993,91 @@ Napi::Value QuantumRNG::EntangleStates(const Napi::CallbackInfo& info) {
         return env.Null();
     }
 
-    qrng_error err = qrng_entangle_states(ctx, state1.Data(), state2.Data(), state1.Length());
+    qrng_error err = state1.Length() >= QRNG_PARALLEL_MIN_LEN
+        ? qrng_entangle_states_parallel(ctx, state1.Data(), state2.Data(), state1.Length(), 0)
+        : qrng_entangle_states(ctx, state1.Data(), state2.Data(), state1.Length());
+    if (err != QRNG_SUCCESS) {
+        Napi::Error::New(env, qrng_error_string(err)).ThrowAsJavaScriptException();
+        return env.Null();
+    }
+
+    return env.Undefined();
+}
+
+Napi::Value QuantumRNG::EntangleStatesAsync(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+
+    if (info.Length() < 2 || !info[0].IsBuffer() || !info[1].IsBuffer()) {
+        Napi::TypeError::New(env, "Two state buffers required").ThrowAsJavaScriptException();
+        return env.Null();
+    }
+
+    Napi::Buffer<uint8_t> state1 = info[0].As<Napi::Buffer<uint8_t>>();
+    Napi::Buffer<uint8_t> state2 = info[1].As<Napi::Buffer<uint8_t>>();
+
+    if (state1.Length() != state2.Length()) {
+        Napi::Error::New(env, "State buffers must be the same length").ThrowAsJavaScriptException();
+        return env.Null();
+    }
+
+    // The buffers must not be touched from JS until the promise settles
+    uint8_t* a = state1.Data();
+    uint8_t* b = state2.Data();
+    size_t length = state1.Length();
+
+    PoolWork* work = new PoolWork(env);
+    work->keep.push_back(Napi::Persistent(state1.As<Napi::Object>()));
+    work->keep.push_back(Napi::Persistent(state2.As<Napi::Object>()));
+    qrng_ctx* child = nullptr;
+    qrng_error err = TakeWorkCtx(info, work, &child);
+    if (err != QRNG_SUCCESS) {
+        delete work;
+        Napi::Error::New(env, qrng_error_string(err)).ThrowAsJavaScriptException();
+        return env.Null();
+    }
+
+    work->run = [a, b, length, child]() {
+        return length >= QRNG_PARALLEL_MIN_LEN
+            ? qrng_entangle_states_parallel(child, a, b, length, 0)
+            : qrng_entangle_states(child, a, b, length);
+    };
+    return QueuePoolWork(env, work);
+}
+
+Napi::Value QuantumRNG::EntangleMany(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+
+    if (info.Length() < 1 || !info[0].IsArray()) {
+        Napi::TypeError::New(env, "Array of state buffers required").ThrowAsJavaScriptException();
+        return env.Null();
+    }
+
+    Napi::Array array = info[0].As<Napi::Array>();
+    if (array.Length() < 2) {
+        Napi::TypeError::New(env, "At least two state buffers required").ThrowAsJavaScriptException();
+        return env.Null();
+    }
+
+    std::vector<uint8_t*> states;
+    size_t length = 0;
+    for (uint32_t i = 0; i < array.Length(); i++) {
+        Napi::Value value = array[i];
+        if (!value.IsBuffer()) {
+            Napi::TypeError::New(env, "State buffers must be Buffers").ThrowAsJavaScriptException();
+            return env.Null();
+        }
+
+        Napi::Buffer<uint8_t> state = value.As<Napi::Buffer<uint8_t>>();
+        if (i == 0) {
+            length = state.Length();
+        } else if (state.Length() != length) {
+            Napi::Error::New(env, "State buffers must be the same length").ThrowAsJavaScriptException();
+            return env.Null();
+        }
+        states.push_back(state.Data());
+    }
+
+    qrng_error err = qrng_entangle_many(ctx, states.data(), states.size(), length);
     if (err != QRNG_SUCCESS) {
         Napi::Error::New(env, qrng_error_string(err)).ThrowAsJavaScriptException();
         return env.Null();
@@ -236,6 +1105,289 @@ Napi::Value QuantumRNG::MeasureState(const Napi::CallbackInfo& info) {
     return env.Undefined();
 }
 
+Napi::Value QuantumRNG::SimReset(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+
+    if (info.Length() < 1 || !info[0].IsNumber()) {
+        Napi::TypeError::New(env, "Qubit count required").ThrowAsJavaScriptException();
+        return env.Null();
+    }
+
+    int32_t qubits = info[0].As<Napi::Number>().Int32Value();
+    if (qubits < 1 || qubits > QRNG_SIM_MAX_QUBITS) {
+        Napi::RangeError::New(env, "Qubit count must be between 1 and 28").ThrowAsJavaScriptException();
+        return env.Null();
+    }
+
+    qrng_error err = qrng_sim_attach(ctx, (unsigned)qubits);
+    if (err != QRNG_SUCCESS) {
+        Napi::Error::New(env, qrng_error_string(err)).ThrowAsJavaScriptException();
+        return env.Null();
+    }
+    return env.Undefined();
+}
+
+// Indexed by qrng_gate_kind
+static const char* const kGateNames[] = {
+    "h", "x", "y", "z", "s", "t", "phase", "rx", "ry", "rz", "cnot"
+};
+
+// Returns the attached register, or throws and returns nullptr
+static qrng_state* SimStateOrThrow(Napi::Env env, qrng_ctx* ctx) {
+    qrng_state* s = qrng_sim_state(ctx);
+    if (!s) {
+        Napi::Error::New(env, "No simulator register; call simReset() first").ThrowAsJavaScriptException();
+    }
+    return s;
+}
+
+// Reads a qubit index argument, throws and returns -1 when out of range
+static int32_t QubitArg(Napi::Env env, Napi::Value value, const qrng_state* s) {
+    int32_t q = value.As<Napi::Number>().Int32Value();
+    if (q < 0 || (unsigned)q >= s->qubits) {
+        Napi::RangeError::New(env, "Qubit index out of range").ThrowAsJavaScriptException();
+        return -1;
+    }
+    return q;
+}
+
+struct SimGateArgs {
+    qrng_gate_kind kind;
+    unsigned target;
+    unsigned control;
+    double theta;
+};
+
+// Parses (name, target, arg) where arg is the control qubit for cnot and the
+// angle for phase and rotations. Throws and returns false on bad input.
+static bool ParseGate(Napi::Env env, Napi::Value name, Napi::Value target, Napi::Value arg,
+                      const qrng_state* s, SimGateArgs* gate) {
+    if (!name.IsString() || !target.IsNumber()) {
+        Napi::TypeError::New(env, "Gate name and target qubit required").ThrowAsJavaScriptException();
+        return false;
+    }
+
+    std::string str = name.As<Napi::String>().Utf8Value();
+    int kind = -1;
+    for (int i = 0; i <= QRNG_GATE_CNOT; i++) {
+        if (str == kGateNames[i]) {
+            kind = i;
+            break;
+        }
+    }
+    if (kind < 0) {
+        Napi::TypeError::New(env, "Gate must be one of h, x, y, z, s, t, phase, rx, ry, rz, cnot").ThrowAsJavaScriptException();
+        return false;
+    }
+
+    bool needsArg = kind == QRNG_GATE_CNOT || kind >= QRNG_GATE_PHASE;
+    if (needsArg && !arg.IsNumber()) {
+        Napi::TypeError::New(env, kind == QRNG_GATE_CNOT ? "Control qubit required" : "Angle required").ThrowAsJavaScriptException();
+        return false;
+    }
+
+    int32_t t = QubitArg(env, target, s);
+    if (t < 0) return false;
+
+    gate->kind = (qrng_gate_kind)kind;
+    gate->target = (unsigned)t;
+    gate->control = 0;
+    gate->theta = 0.0;
+    if (kind == QRNG_GATE_CNOT) {
+        int32_t c = QubitArg(env, arg, s);
+        if (c < 0) return false;
+        if (c == t) {
+            Napi::RangeError::New(env, "Control and target must differ").ThrowAsJavaScriptException();
+            return false;
+        }
+        gate->control = (unsigned)c;
+    } else if (needsArg) {
+        gate->theta = arg.As<Napi::Number>().DoubleValue();
+    }
+    return true;
+}
+
+Napi::Value QuantumRNG::SimGate(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+
+    qrng_state* s = SimStateOrThrow(env, ctx);
+    if (!s) return env.Null();
+
+    SimGateArgs gate;
+    if (!ParseGate(env, info[0], info[1], info[2], s, &gate)) return env.Null();
+
+    qrng_error err = qrng_state_apply(s, gate.kind, gate.target, gate.control, gate.theta);
+    if (err != QRNG_SUCCESS) {
+        Napi::Error::New(env, qrng_error_string(err)).ThrowAsJavaScriptException();
+        return env.Null();
+    }
+    return env.Undefined();
+}
+
+Napi::Value QuantumRNG::SimRun(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+
+    if (info.Length() < 1 || !info[0].IsArray()) {
+        Napi::TypeError::New(env, "Array of gates required").ThrowAsJavaScriptException();
+        return env.Null();
+    }
+
+    size_t threads = 0;
+    if (info.Length() > 1 && info[1].IsNumber()) {
+        int32_t n = info[1].As<Napi::Number>().Int32Value();
+        threads = n > 0 ? (size_t)n : 0;
+    }
+
+    qrng_state* s = SimStateOrThrow(env, ctx);
+    if (!s) return env.Null();
+
+    std::unique_ptr<qrng_circuit, decltype(&qrng_circuit_destroy)> circuit(
+        qrng_circuit_create(), qrng_circuit_destroy);
+    if (!circuit) {
+        Napi::Error::New(env, "Failed to allocate circuit").ThrowAsJavaScriptException();
+        return env.Null();
+    }
+
+    // Each gate is [name, target, arg?]
+    Napi::Array gates = info[0].As<Napi::Array>();
+    for (uint32_t i = 0; i < gates.Length(); i++) {
+        Napi::Value value = gates[i];
+        if (!value.IsArray()) {
+            Napi::TypeError::New(env, "Each gate must be an array [name, target, arg]").ThrowAsJavaScriptException();
+            return env.Null();
+        }
+        Napi::Array entry = value.As<Napi::Array>();
+
+        SimGateArgs gate;
+        if (!ParseGate(env, entry[0u], entry[1u], entry[2u], s, &gate)) return env.Null();
+
+        qrng_error err = qrng_circuit_add(circuit.get(), gate.kind, gate.target, gate.control, gate.theta);
+        if (err != QRNG_SUCCESS) {
+            Napi::Error::New(env, qrng_error_string(err)).ThrowAsJavaScriptException();
+            return env.Null();
+        }
+    }
+
+    qrng_error err = qrng_circuit_run(circuit.get(), s, threads);
+    if (err != QRNG_SUCCESS) {
+        Napi::Error::New(env, qrng_error_string(err)).ThrowAsJavaScriptException();
+        return env.Null();
+    }
+    return env.Undefined();
+}
+
+Napi::Value QuantumRNG::SimProbability(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+
+    if (info.Length() < 1 || !info[0].IsNumber()) {
+        Napi::TypeError::New(env, "Qubit index required").ThrowAsJavaScriptException();
+        return env.Null();
+    }
+
+    qrng_state* s = SimStateOrThrow(env, ctx);
+    if (!s) return env.Null();
+    int32_t qubit = QubitArg(env, info[0], s);
+    if (qubit < 0) return env.Null();
+
+    return Napi::Number::New(env, qrng_state_probability(s, (unsigned)qubit));
+}
+
+Napi::Value QuantumRNG::SimMeasure(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+
+    if (info.Length() < 1 || !info[0].IsNumber()) {
+        Napi::TypeError::New(env, "Qubit index required").ThrowAsJavaScriptException();
+        return env.Null();
+    }
+
+    qrng_state* s = SimStateOrThrow(env, ctx);
+    if (!s) return env.Null();
+    int32_t qubit = QubitArg(env, info[0], s);
+    if (qubit < 0) return env.Null();
+
+    int outcome;
+    qrng_error err = qrng_sim_measure(ctx, (unsigned)qubit, &outcome);
+    if (err != QRNG_SUCCESS) {
+        Napi::Error::New(env, qrng_error_string(err)).ThrowAsJavaScriptException();
+        return env.Null();
+    }
+    return Napi::Number::New(env, outcome);
+}
+
+Napi::Value QuantumRNG::SimMeasureAll(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+
+    if (!SimStateOrThrow(env, ctx)) return env.Null();
+
+    uint64_t outcome;
+    qrng_error err = qrng_sim_measure_all(ctx, &outcome);
+    if (err != QRNG_SUCCESS) {
+        Napi::Error::New(env, qrng_error_string(err)).ThrowAsJavaScriptException();
+        return env.Null();
+    }
+    return Napi::Number::New(env, (double)outcome);
+}
+
+// Upper bound on shots per simSample() call, 128 MiB of outcomes
+static const int64_t kMaxShots = 1 << 24;
+
+Napi::Value QuantumRNG::SimSample(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+
+    if (info.Length() < 1 || !info[0].IsNumber()) {
+        Napi::TypeError::New(env, "Shot count required").ThrowAsJavaScriptException();
+        return env.Null();
+    }
+
+    int64_t shots = info[0].As<Napi::Number>().Int64Value();
+    if (shots < 1 || shots > kMaxShots) {
+        Napi::RangeError::New(env, "Shot count must be between 1 and 16777216").ThrowAsJavaScriptException();
+        return env.Null();
+    }
+
+    qrng_state* s = SimStateOrThrow(env, ctx);
+    if (!s) return env.Null();
+
+    std::vector<uint64_t> outcomes((size_t)shots);
+    qrng_error err = qrng_sample_shots(ctx, outcomes.size(), outcomes.data());
+    if (err != QRNG_SUCCESS) {
+        Napi::Error::New(env, qrng_error_string(err)).ThrowAsJavaScriptException();
+        return env.Null();
+    }
+
+    // Histogram keyed by bitstring, highest qubit first
+    std::sort(outcomes.begin(), outcomes.end());
+    Napi::Object counts = Napi::Object::New(env);
+    std::string key(s->qubits, '0');
+    for (size_t i = 0; i < outcomes.size();) {
+        size_t j = i;
+        while (j < outcomes.size() && outcomes[j] == outcomes[i]) j++;
+        for (unsigned q = 0; q < s->qubits; q++) {
+            key[s->qubits - 1 - q] = (outcomes[i] >> q) & 1 ? '1' : '0';
+        }
+        counts.Set(key, Napi::Number::New(env, (double)(j - i)));
+        i = j;
+    }
+    return counts;
+}
+
+Napi::Value QuantumRNG::GetPoolStats(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+
+    qrng_pool_stats stats;
+    qrng_pool_get_stats(&stats);
+
+    Napi::Object result = Napi::Object::New(env);
+    result.Set("workers", Napi::Number::New(env, (double)stats.workers));
+    result.Set("threads", Napi::Number::New(env, (double)stats.threads));
+    result.Set("cpuLimit", Napi::Number::New(env, (double)stats.cpu_limit));
+    result.Set("tasks", Napi::Number::New(env, (double)stats.tasks));
+    result.Set("steals", Napi::Number::New(env, (double)stats.steals));
+    result.Set("injected", Napi::Number::New(env, (double)stats.injected));
+    result.Set("sleeps", Napi::Number::New(env, (double)stats.sleeps));
+    return result;
+}
+
 Napi::Value QuantumRNG::GetVersion(const Napi::CallbackInfo& info) {
     return Napi::String::New(info.Env(), qrng_version());
 }
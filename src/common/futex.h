@@ -0,0 +1,39 @@
+#ifndef QUANTUM_FUTEX_H
+#define QUANTUM_FUTEX_H
+
+#include <stdint.h>
+#include <errno.h>
+#include <limits.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/syscall.h>
+#include <linux/futex.h>
+
+// Thin futex(2) wrappers for 32-bit words that are otherwise driven with
+// __atomic builtins. Private wakeups stay within the process; shared ones
+// also reach other processes mapping the same page.
+
+// Sleep while *addr == expected. Returns on wakeup, mismatch or signal, so
+// callers re-check their condition in a loop.
+static inline void qrng_futex_wait(uint32_t *addr, uint32_t expected, int shared) {
+    syscall(SYS_futex, addr, shared ? FUTEX_WAIT : FUTEX_WAIT_PRIVATE,
+            expected, NULL, NULL, 0);
+}
+
+// As qrng_futex_wait(), giving up after ms milliseconds. Returns -1 on
+// timeout and 0 otherwise.
+static inline int qrng_futex_wait_ms(uint32_t *addr, uint32_t expected, int shared,
+                                     uint32_t ms) {
+    struct timespec timeout = { ms / 1000, (long)(ms % 1000) * 1000000L };
+    long r = syscall(SYS_futex, addr, shared ? FUTEX_WAIT : FUTEX_WAIT_PRIVATE,
+                     expected, &timeout, NULL, 0);
+    return r != 0 && errno == ETIMEDOUT ? -1 : 0;
+}
+
+// Wake every waiter on addr
+static inline void qrng_futex_wake(uint32_t *addr, int shared) {
+    syscall(SYS_futex, addr, shared ? FUTEX_WAKE : FUTEX_WAKE_PRIVATE,
+            INT_MAX, NULL, NULL, 0);
+}
+
+#endif /* QUANTUM_FUTEX_H */
@@ -0,0 +1,45 @@
+#ifndef QUANTUM_SIMD_H
+#define QUANTUM_SIMD_H
+
+// Vector ISA selection. The addon is built with -march=native, so these follow
+// whatever the build host supports; every kernel keeps a portable scalar path.
+#if defined(__AVX512F__) && defined(__AVX512DQ__) && defined(__AVX512BW__) && \
+    defined(__AVX512VL__)
+#define QRNG_SIMD_AVX512 1
+#elif defined(__AVX2__)
+#define QRNG_SIMD_AVX2 1
+#endif
+
+#if defined(QRNG_SIMD_AVX512) || defined(QRNG_SIMD_AVX2)
+#include <immintrin.h>
+#endif
+
+#include <stdint.h>
+
+#define QRNG_LANES 8    /**< 64-bit lanes processed per vector step */
+
+// Bijective 64-bit finalizer applied independently to QRNG_LANES words.
+// Scalar builds rely on the fixed trip count for auto-vectorisation.
+static inline void qrng_mix_lanes(uint64_t *x) {
+#if defined(QRNG_SIMD_AVX512)
+    __m512i v = _mm512_loadu_si512(x);
+    v = _mm512_xor_si512(v, _mm512_srli_epi64(v, 30));
+    v = _mm512_mullo_epi64(v, _mm512_set1_epi64((long long)0xbf58476d1ce4e5b9ULL));
+    v = _mm512_xor_si512(v, _mm512_srli_epi64(v, 27));
+    v = _mm512_mullo_epi64(v, _mm512_set1_epi64((long long)0x94d049bb133111ebULL));
+    v = _mm512_xor_si512(v, _mm512_srli_epi64(v, 31));
+    _mm512_storeu_si512(x, v);
+#else
+    for (int l = 0; l < QRNG_LANES; l++) {
+        uint64_t v = x[l];
+        v ^= v >> 30;
+        v *= 0xbf58476d1ce4e5b9ULL;
+        v ^= v >> 27;
+        v *= 0x94d049bb133111ebULL;
+        v ^= v >> 31;
+        x[l] = v;
+    }
+#endif
+}
+
+#endif /* QUANTUM_SIMD_H */
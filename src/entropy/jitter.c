@@ -0,0 +1,202 @@
+#ifndef _GNU_SOURCE
+#define _GNU_SOURCE   // SCHED_IDLE
+#endif
+#include "jitter.h"
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <pthread.h>
+#include <sched.h>
+#include <unistd.h>
+#include <sys/resource.h>
+#include <sys/syscall.h>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+#define QRNG_JITTER_SAMPLES (QRNG_JITTER_SEED_BITS * QRNG_JITTER_OSR)
+#define QRNG_JITTER_MAX_SAMPLES (QRNG_JITTER_SAMPLES * 16)
+#define QRNG_JITTER_MEM_STEPS 128     // Cache lines touched per sample
+#define QRNG_JITTER_BACKOFF_NS (20 * 1000 * 1000)
+
+struct qrng_jitter {
+    qrng_seed_queue *queue;
+    pthread_t thread;
+    int stop;                  // Set by qrng_jitter_stop (atomic)
+    qrng_jitter_stats stats;   // Updated by the collector thread (atomic)
+};
+
+typedef struct {
+    uint8_t *mem;
+    size_t index;
+    uint64_t prev_delta;
+    int64_t prev_delta2;
+} jitter_state;
+
+static inline uint64_t jitter_clock(void) {
+#if defined(__x86_64__) || defined(__i386__)
+    return __rdtsc();
+#else
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC_RAW, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+#endif
+}
+
+// Time one pass of memory and ALU work whose length depends on the clock
+static uint64_t jitter_measure(jitter_state *st) {
+    uint64_t t0 = jitter_clock();
+
+    // Scattered read-modify-writes; the stride is odd in cache lines, so
+    // successive passes land on different sets
+    volatile uint8_t *mem = st->mem;
+    size_t index = st->index;
+    for (int i = 0; i < QRNG_JITTER_MEM_STEPS; i++) {
+        index = (index + 64 * 67 + 1) & (QRNG_JITTER_MEM_SIZE - 1);
+        mem[index] = (uint8_t)(mem[index] + 1);
+    }
+    st->index = index;
+
+    // Data-dependent ALU fold
+    uint64_t fold = t0;
+    for (uint64_t i = 0, n = 1 + (t0 & 15); i < n; i++) {
+        fold = (fold << 7 | fold >> 57) ^ (fold * 0x9E3779B97F4A7C15ULL);
+    }
+    __asm__ volatile("" : : "r"(fold));
+
+    return jitter_clock() - t0;
+}
+
+// Jitterentropy-style stuck test: a sample whose delta or first or second
+// derivative is zero carries no credit
+static int jitter_stuck(jitter_state *st, uint64_t delta) {
+    int64_t delta2 = (int64_t)(delta - st->prev_delta);
+    int64_t delta3 = delta2 - st->prev_delta2;
+    st->prev_delta = delta;
+    st->prev_delta2 = delta2;
+    return delta == 0 || delta2 == 0 || delta3 == 0;
+}
+
+static int jitter_seed(jitter_state *st, uint8_t *seed, qrng_jitter_stats *stats) {
+    qrng_sponge sponge;
+    qrng_sponge_init(&sponge);
+
+    uint64_t good = 0, taken = 0;
+    uint64_t batch[QRNG_SPONGE_RATE / sizeof(uint64_t)];
+    size_t fill = 0;
+
+    while (good < QRNG_JITTER_SAMPLES && taken < QRNG_JITTER_MAX_SAMPLES) {
+        uint64_t delta = jitter_measure(st);
+        taken++;
+
+        // Stuck samples are still absorbed, they are just not counted
+        if (!jitter_stuck(st, delta)) good++;
+
+        batch[fill++] = delta;
+        if (fill == sizeof(batch) / sizeof(batch[0])) {
+            qrng_sponge_absorb(&sponge, batch, sizeof(batch));
+            fill = 0;
+        }
+    }
+    qrng_sponge_absorb(&sponge, batch, fill * sizeof(uint64_t));
+
+    if (stats) {
+        __atomic_fetch_add(&stats->samples, taken, __ATOMIC_RELAXED);
+        __atomic_fetch_add(&stats->stuck, taken - good, __ATOMIC_RELAXED);
+    }
+
+    int ok = good >= QRNG_JITTER_SAMPLES;
+    if (ok) qrng_sponge_squeeze(&sponge, seed, QRNG_SEED_BYTES);
+    qrng_sponge_clear(&sponge);
+    memset(batch, 0, sizeof(batch));
+    return ok ? 0 : -1;
+}
+
+int qrng_jitter_collect(uint8_t *seed) {
+    if (!seed) return -1;
+
+    jitter_state st;
+    memset(&st, 0, sizeof(st));
+    st.mem = calloc(1, QRNG_JITTER_MEM_SIZE);
+    if (!st.mem) return -1;
+
+    int ret = jitter_seed(&st, seed, NULL);
+    free(st.mem);
+    return ret;
+}
+
+static void jitter_sleep(void) {
+    struct timespec ts = { 0, QRNG_JITTER_BACKOFF_NS };
+    nanosleep(&ts, NULL);
+}
+
+static void *jitter_thread(void *arg) {
+    qrng_jitter *j = arg;
+
+    // Only run on otherwise idle cores; fall back to the lowest nice value
+    struct sched_param param = { 0 };
+    if (pthread_setschedparam(pthread_self(), SCHED_IDLE, &param) != 0) {
+        setpriority(PRIO_PROCESS, (id_t)syscall(SYS_gettid), 19);
+    }
+
+    jitter_state st;
+    memset(&st, 0, sizeof(st));
+    st.mem = calloc(1, QRNG_JITTER_MEM_SIZE);
+    if (!st.mem) return NULL;
+
+    uint8_t seed[QRNG_SEED_BYTES];
+    int pending = 0;
+
+    while (!__atomic_load_n(&j->stop, __ATOMIC_ACQUIRE)) {
+        if (!pending) {
+            if (jitter_seed(&st, seed, &j->stats) != 0) {
+                __atomic_fetch_add(&j->stats.failures, 1, __ATOMIC_RELAXED);
+                jitter_sleep();
+                continue;
+            }
+            pending = 1;
+        }
+
+        if (qrng_seed_queue_push(j->queue, seed, QRNG_JITTER_SEED_BITS) == 0) {
+            __atomic_fetch_add(&j->stats.seeds, 1, __ATOMIC_RELAXED);
+            pending = 0;
+        } else {
+            jitter_sleep();
+        }
+    }
+
+    memset(seed, 0, sizeof(seed));
+    free(st.mem);
+    return NULL;
+}
+
+qrng_jitter *qrng_jitter_start(qrng_seed_queue *q) {
+    if (!q) return NULL;
+
+    qrng_jitter *j = calloc(1, sizeof(qrng_jitter));
+    if (!j) return NULL;
+    j->queue = q;
+
+    if (pthread_create(&j->thread, NULL, jitter_thread, j) != 0) {
+        free(j);
+        return NULL;
+    }
+    return j;
+}
+
+void qrng_jitter_stop(qrng_jitter *j) {
+    if (j) {
+        __atomic_store_n(&j->stop, 1, __ATOMIC_RELEASE);
+        pthread_join(j->thread, NULL);
+        free(j);
+    }
+}
+
+void qrng_jitter_get_stats(const qrng_jitter *j, qrng_jitter_stats *stats) {
+    if (!j || !stats) return;
+    stats->samples = __atomic_load_n(&j->stats.samples, __ATOMIC_RELAXED);
+    stats->stuck = __atomic_load_n(&j->stats.stuck, __ATOMIC_RELAXED);
+    stats->seeds = __atomic_load_n(&j->stats.seeds, __ATOMIC_RELAXED);
+    stats->failures = __atomic_load_n(&j->stats.failures, __ATOMIC_RELAXED);
+}
@@ -0,0 +1,69 @@
+#ifndef QUANTUM_JITTER_H
+#define QUANTUM_JITTER_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include "seed_queue.h"
+
+/**
+ * @file jitter.h
+ * @brief CPU execution-time jitter entropy collector
+ *
+ * Times short runs of memory and ALU work with the cycle counter. Cache,
+ * TLB, pipeline and interrupt effects make the durations vary unpredictably;
+ * the raw deltas are absorbed into a sponge and squeezed into seeds. A
+ * background collector runs at idle priority and keeps a seed queue topped
+ * up so consumers never wait on it.
+ */
+
+#define QRNG_JITTER_OSR 3             /**< Samples taken per credited bit */
+#define QRNG_JITTER_SEED_BITS 256     /**< Entropy credited per seed */
+#define QRNG_JITTER_MEM_SIZE (64 * 1024) /**< Memory walked by each sample */
+
+typedef struct qrng_jitter qrng_jitter;
+
+/**
+ * @brief Collector counters
+ */
+typedef struct {
+    uint64_t samples;          /**< Timing samples taken */
+    uint64_t stuck;            /**< Samples rejected by the stuck test */
+    uint64_t seeds;            /**< Seeds pushed to the queue */
+    uint64_t failures;         /**< Seed attempts abandoned for too many stuck samples */
+} qrng_jitter_stats;
+
+/**
+ * @brief Collect one seed on the calling thread
+ *
+ * @param seed[out] Receives QRNG_SEED_BYTES of conditioned seed
+ * @return 0 on success, -1 if the timer is too coarse to credit
+ */
+int qrng_jitter_collect(uint8_t *seed);
+
+/**
+ * @brief Start a background collector
+ *
+ * The collector pushes seeds credited with QRNG_JITTER_SEED_BITS each and
+ * backs off while the queue is full.
+ *
+ * @param q Queue to feed; must outlive the collector
+ * @return Collector handle, or NULL if the thread could not be started
+ */
+qrng_jitter *qrng_jitter_start(qrng_seed_queue *q);
+
+/**
+ * @brief Stop and free a collector
+ *
+ * @param j Collector
+ */
+void qrng_jitter_stop(qrng_jitter *j);
+
+/**
+ * @brief Read collector counters
+ *
+ * @param j Collector
+ * @param stats[out] Receives the counters
+ */
+void qrng_jitter_get_stats(const qrng_jitter *j, qrng_jitter_stats *stats);
+
+#endif /* QUANTUM_JITTER_H */
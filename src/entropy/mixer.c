@@ -0,0 +1,318 @@
+#include "mixer.h"
+#include "sponge.h"
+#include "jitter.h"
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <errno.h>
+#include <pthread.h>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+#define QRNG_MIXER_MAX_PENDING 4096    // Credit held while the queue is full
+#define QRNG_MIXER_IDLE_MS 1000        // Longest sleep with no source due
+#define QRNG_MIXER_JITTER_SEEDS 4      // Seeds the jitter collector keeps ready
+
+typedef struct {
+    qrng_source src;
+    uint64_t next_poll_ms;
+    qrng_source_stats stats;           // Written by the poller (atomic)
+} source_slot;
+
+struct qrng_mixer {
+    qrng_seed_queue *queue;
+    pthread_mutex_t lock;              // Guards registry count, inbox and stop
+    pthread_cond_t wake;
+    pthread_t thread;
+    int running;
+    int stop;
+
+    source_slot slots[QRNG_MIXER_MAX_SOURCES];
+    size_t nslots;
+
+    uint8_t inbox[QRNG_MIXER_INBOX_BYTES];
+    size_t inbox_len;
+    uint64_t inbox_bits;
+    qrng_source_stats seed_stats;
+
+    qrng_interrupt_state interrupts;
+    qrng_seed_queue *jitter_queue;     // Filled by jitter at idle priority
+    qrng_jitter *jitter;
+
+    // Poller-owned
+    qrng_sponge sponge;
+    uint64_t pending_bits;
+};
+
+static uint64_t now_ms(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000 + (uint64_t)ts.tv_nsec / 1000000;
+}
+
+static uint64_t timestamp(void) {
+#if defined(__x86_64__) || defined(__i386__)
+    return __rdtsc();
+#else
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC_RAW, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+#endif
+}
+
+qrng_mixer *qrng_mixer_create(qrng_seed_queue *q) {
+    if (!q) return NULL;
+
+    qrng_mixer *m = calloc(1, sizeof(qrng_mixer));
+    if (!m) return NULL;
+
+    m->queue = q;
+    pthread_mutex_init(&m->lock, NULL);
+    pthread_cond_init(&m->wake, NULL);
+    qrng_sponge_init(&m->sponge);
+    m->seed_stats.name = "seed";
+    return m;
+}
+
+void qrng_mixer_destroy(qrng_mixer *m) {
+    if (!m) return;
+
+    pthread_mutex_lock(&m->lock);
+    m->stop = 1;
+    pthread_cond_signal(&m->wake);
+    pthread_mutex_unlock(&m->lock);
+
+    if (m->running) pthread_join(m->thread, NULL);
+    qrng_jitter_stop(m->jitter);
+    qrng_seed_queue_destroy(m->jitter_queue);
+
+    pthread_cond_destroy(&m->wake);
+    pthread_mutex_destroy(&m->lock);
+    free(m->interrupts.counts);
+    qrng_sponge_clear(&m->sponge);
+    memset(m->inbox, 0, sizeof(m->inbox));
+    free(m);
+}
+
+int qrng_mixer_add_source(qrng_mixer *m, const qrng_source *src) {
+    if (!m || !src || !src->poll || src->rating_millibits > 8000) return -1;
+
+    pthread_mutex_lock(&m->lock);
+    if (m->nslots == QRNG_MIXER_MAX_SOURCES) {
+        pthread_mutex_unlock(&m->lock);
+        return -1;
+    }
+
+    source_slot *slot = &m->slots[m->nslots];
+    memset(slot, 0, sizeof(*slot));
+    slot->src = *src;
+    slot->stats.name = src->name;
+    slot->next_poll_ms = 0;
+    m->nslots++;
+    pthread_cond_signal(&m->wake);
+    pthread_mutex_unlock(&m->lock);
+    return 0;
+}
+
+// Jitter samples take milliseconds of CPU, so they are gathered by a
+// collector thread at idle priority and the poller only pops finished seeds
+static int start_jitter(qrng_mixer *m) {
+    if (m->jitter) return 0;
+
+    m->jitter_queue = qrng_seed_queue_create(QRNG_MIXER_JITTER_SEEDS);
+    if (!m->jitter_queue) return -1;
+
+    m->jitter = qrng_jitter_start(m->jitter_queue);
+    if (!m->jitter) {
+        qrng_seed_queue_destroy(m->jitter_queue);
+        m->jitter_queue = NULL;
+        return -1;
+    }
+    return 0;
+}
+
+int qrng_mixer_add_default_sources(qrng_mixer *m) {
+    if (!m) return 0;
+
+    int jitter = start_jitter(m) == 0;
+    const qrng_source defaults[] = {
+        { "getrandom", qrng_source_getrandom, NULL, 8000, 1000 },
+        { "rdseed", qrng_source_rdseed, NULL, 4000, 100 },
+        { "rdrand", qrng_source_rdrand, NULL, 1000, 100 },
+        { "jitter", qrng_source_jitter, m->jitter_queue, 8000, 250 },
+        { "interrupts", qrng_source_interrupts, &m->interrupts, 1000, 500 },
+    };
+
+    int added = 0;
+    for (size_t i = 0; i < sizeof(defaults) / sizeof(defaults[0]); i++) {
+        const qrng_source *src = &defaults[i];
+        if (src->poll == qrng_source_rdseed && !qrng_cpu_has_rdseed()) continue;
+        if (src->poll == qrng_source_rdrand && !qrng_cpu_has_rdrand()) continue;
+        if (src->poll == qrng_source_jitter && !jitter) continue;
+        if (qrng_mixer_add_source(m, src) == 0) added++;
+    }
+    return added;
+}
+
+int qrng_mixer_add_seed(qrng_mixer *m, const uint8_t *data, size_t len, uint32_t bits) {
+    if (!m || (!data && len > 0)) return -1;
+
+    pthread_mutex_lock(&m->lock);
+    if (len > QRNG_MIXER_INBOX_BYTES - m->inbox_len) {
+        pthread_mutex_unlock(&m->lock);
+        return -1;
+    }
+
+    memcpy(m->inbox + m->inbox_len, data, len);
+    m->inbox_len += len;
+    m->inbox_bits += bits < len * 8 ? bits : len * 8;
+    pthread_cond_signal(&m->wake);
+    pthread_mutex_unlock(&m->lock);
+    return 0;
+}
+
+// Absorb one sample with its source and length, so samples from different
+// sources can never be confused for each other
+static void absorb_sample(qrng_mixer *m, uint32_t id, const uint8_t *buf,
+                          size_t len, uint64_t bits) {
+    uint64_t header[3] = { id, len, timestamp() };
+    qrng_sponge_absorb(&m->sponge, header, sizeof(header));
+    qrng_sponge_absorb(&m->sponge, buf, len);
+
+    m->pending_bits += bits;
+    if (m->pending_bits > QRNG_MIXER_MAX_PENDING) {
+        m->pending_bits = QRNG_MIXER_MAX_PENDING;
+    }
+}
+
+static void emit_seeds(qrng_mixer *m) {
+    uint8_t seed[QRNG_SEED_BYTES];
+
+    while (m->pending_bits >= QRNG_MIXER_SEED_BITS) {
+        qrng_sponge_squeeze(&m->sponge, seed, sizeof(seed));
+        if (qrng_seed_queue_push(m->queue, seed, QRNG_MIXER_SEED_BITS) != 0) break;
+        m->pending_bits -= QRNG_MIXER_SEED_BITS;
+    }
+    memset(seed, 0, sizeof(seed));
+}
+
+static void stat_add(uint64_t *field, uint64_t v) {
+    __atomic_fetch_add(field, v, __ATOMIC_RELAXED);
+}
+
+static void *mixer_thread(void *arg) {
+    qrng_mixer *m = arg;
+    uint8_t buf[QRNG_SOURCE_MAX_POLL];
+    uint8_t inbox[QRNG_MIXER_INBOX_BYTES];
+
+    for (;;) {
+        // Drain caller seeds under the lock, absorb them outside it
+        pthread_mutex_lock(&m->lock);
+        if (m->stop) {
+            pthread_mutex_unlock(&m->lock);
+            break;
+        }
+        size_t inbox_len = m->inbox_len;
+        uint64_t inbox_bits = m->inbox_bits;
+        memcpy(inbox, m->inbox, inbox_len);
+        memset(m->inbox, 0, inbox_len);
+        m->inbox_len = 0;
+        m->inbox_bits = 0;
+        size_t nslots = m->nslots;
+        pthread_mutex_unlock(&m->lock);
+
+        if (inbox_len > 0) {
+            absorb_sample(m, QRNG_MIXER_MAX_SOURCES, inbox, inbox_len, inbox_bits);
+            stat_add(&m->seed_stats.polls, 1);
+            stat_add(&m->seed_stats.bytes, inbox_len);
+            stat_add(&m->seed_stats.credited_bits, inbox_bits);
+            memset(inbox, 0, inbox_len);
+        }
+
+        // Poll every due source in one batch
+        uint64_t now = now_ms();
+        uint64_t next = now + QRNG_MIXER_IDLE_MS;
+        for (size_t i = 0; i < nslots; i++) {
+            source_slot *slot = &m->slots[i];
+            if (slot->next_poll_ms <= now) {
+                size_t len = 0;
+                if (slot->src.poll(slot->src.arg, buf, &len) == 0 && len > 0) {
+                    if (len > QRNG_SOURCE_MAX_POLL) len = QRNG_SOURCE_MAX_POLL;
+                    uint64_t bits = (uint64_t)len * slot->src.rating_millibits / 1000;
+                    absorb_sample(m, (uint32_t)i, buf, len, bits);
+                    stat_add(&slot->stats.polls, 1);
+                    stat_add(&slot->stats.bytes, len);
+                    stat_add(&slot->stats.credited_bits, bits);
+                } else {
+                    stat_add(&slot->stats.failures, 1);
+                }
+                slot->next_poll_ms = now_ms() + slot->src.interval_ms;
+            }
+            if (slot->next_poll_ms < next) next = slot->next_poll_ms;
+        }
+        memset(buf, 0, sizeof(buf));
+
+        emit_seeds(m);
+
+        // Sleep until the next source is due or someone wakes us
+        pthread_mutex_lock(&m->lock);
+        if (!m->stop && m->inbox_len == 0 && m->nslots == nslots) {
+            uint64_t wait = next > now_ms() ? next - now_ms() : 0;
+            if (wait > 0) {
+                struct timespec ts;
+                clock_gettime(CLOCK_REALTIME, &ts);
+                ts.tv_sec += wait / 1000;
+                ts.tv_nsec += (long)(wait % 1000) * 1000000;
+                if (ts.tv_nsec >= 1000000000L) {
+                    ts.tv_sec++;
+                    ts.tv_nsec -= 1000000000L;
+                }
+                pthread_cond_timedwait(&m->wake, &m->lock, &ts);
+            }
+        }
+        pthread_mutex_unlock(&m->lock);
+    }
+
+    return NULL;
+}
+
+int qrng_mixer_start(qrng_mixer *m) {
+    if (!m) return -1;
+
+    pthread_mutex_lock(&m->lock);
+    int ret = 0;
+    if (!m->running) {
+        ret = pthread_create(&m->thread, NULL, mixer_thread, m) == 0 ? 0 : -1;
+        m->running = ret == 0;
+    }
+    pthread_mutex_unlock(&m->lock);
+    return ret;
+}
+
+size_t qrng_mixer_get_stats(qrng_mixer *m, qrng_source_stats *stats, size_t max) {
+    if (!m || !stats) return 0;
+
+    pthread_mutex_lock(&m->lock);
+    size_t n = 0;
+    for (size_t i = 0; i < m->nslots && n < max; i++, n++) {
+        const qrng_source_stats *s = &m->slots[i].stats;
+        stats[n].name = s->name;
+        stats[n].polls = __atomic_load_n(&s->polls, __ATOMIC_RELAXED);
+        stats[n].failures = __atomic_load_n(&s->failures, __ATOMIC_RELAXED);
+        stats[n].bytes = __atomic_load_n(&s->bytes, __ATOMIC_RELAXED);
+        stats[n].credited_bits = __atomic_load_n(&s->credited_bits, __ATOMIC_RELAXED);
+    }
+    if (n < max) {
+        const qrng_source_stats *s = &m->seed_stats;
+        stats[n].name = s->name;
+        stats[n].polls = __atomic_load_n(&s->polls, __ATOMIC_RELAXED);
+        stats[n].failures = 0;
+        stats[n].bytes = __atomic_load_n(&s->bytes, __ATOMIC_RELAXED);
+        stats[n].credited_bits = __atomic_load_n(&s->credited_bits, __ATOMIC_RELAXED);
+        n++;
+    }
+    pthread_mutex_unlock(&m->lock);
+    return n;
+}
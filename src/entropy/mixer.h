@@ -0,0 +1,109 @@
+#ifndef QUANTUM_MIXER_H
+#define QUANTUM_MIXER_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include "sources.h"
+#include "seed_queue.h"
+
+/**
+ * @file mixer.h
+ * @brief Multi-source entropy mixer
+ *
+ * Polls a registry of sources on one background thread, absorbs every
+ * sample into a single sponge and squeezes a seed into the queue whenever
+ * QRNG_MIXER_SEED_BITS of credit has accumulated. Contexts attached to
+ * the queue absorb those seeds on refill, so sources never run on the
+ * request path.
+ */
+
+#define QRNG_MIXER_MAX_SOURCES 16      /**< Registry capacity */
+#define QRNG_MIXER_SEED_BITS 256       /**< Credit carried by each seed */
+#define QRNG_MIXER_INBOX_BYTES 4096    /**< Queued user seed bytes */
+
+typedef struct qrng_mixer qrng_mixer;
+
+/**
+ * @brief Per-source counters
+ */
+typedef struct {
+    const char *name;
+    uint64_t polls;                    /**< Successful polls */
+    uint64_t failures;                 /**< Polls that returned nothing */
+    uint64_t bytes;                    /**< Bytes absorbed */
+    uint64_t credited_bits;            /**< Entropy credited */
+} qrng_source_stats;
+
+/**
+ * @brief Create a mixer feeding a queue
+ *
+ * @param q Queue to feed; must outlive the mixer
+ * @return New mixer, or NULL on allocation failure
+ */
+qrng_mixer *qrng_mixer_create(qrng_seed_queue *q);
+
+/**
+ * @brief Stop the poller and free the mixer
+ *
+ * @param m Mixer
+ */
+void qrng_mixer_destroy(qrng_mixer *m);
+
+/**
+ * @brief Register a source
+ *
+ * May be called while the poller runs.
+ *
+ * @param m Mixer
+ * @param src Source description, copied
+ * @return 0 on success, -1 if the registry is full or src is invalid
+ */
+int qrng_mixer_add_source(qrng_mixer *m, const qrng_source *src);
+
+/**
+ * @brief Register the built-in sources this machine supports
+ *
+ * getrandom, RDSEED and RDRAND when cpuid reports them, CPU jitter, and
+ * /proc/interrupts deltas when the file is readable. Jitter is gathered by
+ * a qrng_jitter collector at idle priority owned by the mixer; the poller
+ * only takes its finished seeds.
+ *
+ * @param m Mixer
+ * @return Number of sources registered
+ */
+int qrng_mixer_add_default_sources(qrng_mixer *m);
+
+/**
+ * @brief Queue caller-supplied seed material
+ *
+ * Absorbed on the poller's next pass. Credit is capped at 8 bits per byte.
+ *
+ * @param m Mixer
+ * @param data Seed bytes
+ * @param len Seed length
+ * @param bits Entropy to credit
+ * @return 0 on success, -1 if the inbox is full
+ */
+int qrng_mixer_add_seed(qrng_mixer *m, const uint8_t *data, size_t len, uint32_t bits);
+
+/**
+ * @brief Start the poller thread
+ *
+ * @param m Mixer
+ * @return 0 on success, -1 on failure
+ */
+int qrng_mixer_start(qrng_mixer *m);
+
+/**
+ * @brief Read per-source counters
+ *
+ * The last entry, named "seed", covers qrng_mixer_add_seed().
+ *
+ * @param m Mixer
+ * @param stats[out] Array of at least max entries
+ * @param max Capacity of stats
+ * @return Number of entries written
+ */
+size_t qrng_mixer_get_stats(qrng_mixer *m, qrng_source_stats *stats, size_t max);
+
+#endif /* QUANTUM_MIXER_H */
@@ -0,0 +1,112 @@
+#include "seed_queue.h"
+#include <stdlib.h>
+#include <string.h>
+
+#define QRNG_CACHE_LINE 64
+
+// Vyukov's bounded MPMC queue. Each cell's sequence number says whether it
+// is free for the producer at position pos (sequence == pos) or holds the
+// value for the consumer at pos (sequence == pos + 1).
+typedef struct {
+    uint64_t sequence;
+    uint32_t bits;
+    uint8_t seed[QRNG_SEED_BYTES];
+} __attribute__((aligned(QRNG_CACHE_LINE))) seed_cell;
+
+struct qrng_seed_queue {
+    seed_cell *cells;
+    size_t mask;
+    uint64_t enqueue_pos __attribute__((aligned(QRNG_CACHE_LINE)));
+    uint64_t dequeue_pos __attribute__((aligned(QRNG_CACHE_LINE)));
+};
+
+qrng_seed_queue *qrng_seed_queue_create(size_t capacity) {
+    size_t n = 2;
+    while (n < capacity) n <<= 1;
+
+    qrng_seed_queue *q = aligned_alloc(QRNG_CACHE_LINE, sizeof(qrng_seed_queue));
+    if (!q) return NULL;
+    memset(q, 0, sizeof(*q));
+
+    q->cells = aligned_alloc(QRNG_CACHE_LINE, n * sizeof(seed_cell));
+    if (!q->cells) {
+        free(q);
+        return NULL;
+    }
+    memset(q->cells, 0, n * sizeof(seed_cell));
+
+    for (size_t i = 0; i < n; i++) {
+        q->cells[i].sequence = i;
+    }
+    q->mask = n - 1;
+    return q;
+}
+
+void qrng_seed_queue_destroy(qrng_seed_queue *q) {
+    if (q) {
+        memset(q->cells, 0, (q->mask + 1) * sizeof(seed_cell));
+        free(q->cells);
+        free(q);
+    }
+}
+
+int qrng_seed_queue_push(qrng_seed_queue *q, const uint8_t *seed, uint32_t bits) {
+    uint64_t pos = __atomic_load_n(&q->enqueue_pos, __ATOMIC_RELAXED);
+    seed_cell *cell;
+
+    for (;;) {
+        cell = &q->cells[pos & q->mask];
+        uint64_t seq = __atomic_load_n(&cell->sequence, __ATOMIC_ACQUIRE);
+        int64_t diff = (int64_t)(seq - pos);
+
+        if (diff == 0) {
+            if (__atomic_compare_exchange_n(&q->enqueue_pos, &pos, pos + 1, 1,
+                                            __ATOMIC_RELAXED, __ATOMIC_RELAXED)) {
+                break;
+            }
+        } else if (diff < 0) {
+            return -1;
+        } else {
+            pos = __atomic_load_n(&q->enqueue_pos, __ATOMIC_RELAXED);
+        }
+    }
+
+    memcpy(cell->seed, seed, QRNG_SEED_BYTES);
+    cell->bits = bits;
+    __atomic_store_n(&cell->sequence, pos + 1, __ATOMIC_RELEASE);
+    return 0;
+}
+
+int qrng_seed_queue_pop(qrng_seed_queue *q, uint8_t *seed, uint32_t *bits) {
+    uint64_t pos = __atomic_load_n(&q->dequeue_pos, __ATOMIC_RELAXED);
+    seed_cell *cell;
+
+    for (;;) {
+        cell = &q->cells[pos & q->mask];
+        uint64_t seq = __atomic_load_n(&cell->sequence, __ATOMIC_ACQUIRE);
+        int64_t diff = (int64_t)(seq - (pos + 1));
+
+        if (diff == 0) {
+            if (__atomic_compare_exchange_n(&q->dequeue_pos, &pos, pos + 1, 1,
+                                            __ATOMIC_RELAXED, __ATOMIC_RELAXED)) {
+                break;
+            }
+        } else if (diff < 0) {
+            return -1;
+        } else {
+            pos = __atomic_load_n(&q->dequeue_pos, __ATOMIC_RELAXED);
+        }
+    }
+
+    memcpy(seed, cell->seed, QRNG_SEED_BYTES);
+    *bits = cell->bits;
+    memset(cell->seed, 0, QRNG_SEED_BYTES);
+    __atomic_store_n(&cell->sequence, pos + q->mask + 1, __ATOMIC_RELEASE);
+    return 0;
+}
+
+size_t qrng_seed_queue_size(const qrng_seed_queue *q) {
+    uint64_t tail = __atomic_load_n(&q->dequeue_pos, __ATOMIC_ACQUIRE);
+    uint64_t head = __atomic_load_n(&q->enqueue_pos, __ATOMIC_ACQUIRE);
+    return head > tail ? (size_t)(head - tail) : 0;
+}
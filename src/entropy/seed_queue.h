@@ -0,0 +1,65 @@
+#ifndef QUANTUM_SEED_QUEUE_H
+#define QUANTUM_SEED_QUEUE_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include "sponge.h"
+
+/**
+ * @file seed_queue.h
+ * @brief Lock-free queue of conditioned seeds
+ *
+ * Bounded multi-producer multi-consumer ring carrying QRNG_SEED_BYTES seeds
+ * and the entropy credited to each. Push and pop never block or take a
+ * lock, so collectors can feed it from background threads while generating
+ * contexts drain it on refill.
+ */
+
+typedef struct qrng_seed_queue qrng_seed_queue;
+
+/**
+ * @brief Create a queue
+ *
+ * @param capacity Slots, rounded up to a power of two
+ * @return New queue, or NULL on allocation failure
+ */
+qrng_seed_queue *qrng_seed_queue_create(size_t capacity);
+
+/**
+ * @brief Free a queue
+ *
+ * No producer or consumer may still be using it.
+ *
+ * @param q Queue to free
+ */
+void qrng_seed_queue_destroy(qrng_seed_queue *q);
+
+/**
+ * @brief Enqueue a seed
+ *
+ * @param q Queue
+ * @param seed QRNG_SEED_BYTES of conditioned seed
+ * @param bits Entropy credited to the seed
+ * @return 0 on success, -1 if the queue is full
+ */
+int qrng_seed_queue_push(qrng_seed_queue *q, const uint8_t *seed, uint32_t bits);
+
+/**
+ * @brief Dequeue a seed
+ *
+ * @param q Queue
+ * @param seed[out] Receives QRNG_SEED_BYTES of seed
+ * @param bits[out] Receives the credited entropy
+ * @return 0 on success, -1 if the queue is empty
+ */
+int qrng_seed_queue_pop(qrng_seed_queue *q, uint8_t *seed, uint32_t *bits);
+
+/**
+ * @brief Approximate number of queued seeds
+ *
+ * @param q Queue
+ * @return Seeds waiting to be popped
+ */
+size_t qrng_seed_queue_size(const qrng_seed_queue *q);
+
+#endif /* QUANTUM_SEED_QUEUE_H */
@@ -0,0 +1,164 @@
+#include "sources.h"
+#include "jitter.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <ctype.h>
+#include <errno.h>
+#include <sys/random.h>
+
+#if defined(__x86_64__)
+#include <cpuid.h>
+#include <immintrin.h>
+#endif
+
+#define QRNG_SOURCE_WORDS 4            // 64-bit words per hardware poll
+#define QRNG_RDSEED_RETRIES 16
+
+int qrng_source_getrandom(void *arg, uint8_t *buf, size_t *len) {
+    (void)arg;
+    ssize_t n = getrandom(buf, QRNG_SEED_BYTES, GRND_NONBLOCK);
+    if (n <= 0) return -1;
+    *len = (size_t)n;
+    return 0;
+}
+
+#if defined(__x86_64__)
+int qrng_cpu_has_rdseed(void) {
+    unsigned a, b, c, d;
+    if (!__get_cpuid_count(7, 0, &a, &b, &c, &d)) return 0;
+    return (b & bit_RDSEED) != 0;
+}
+
+int qrng_cpu_has_rdrand(void) {
+    unsigned a, b, c, d;
+    if (!__get_cpuid(1, &a, &b, &c, &d)) return 0;
+    return (c & bit_RDRND) != 0;
+}
+
+__attribute__((target("rdseed")))
+int qrng_source_rdseed(void *arg, uint8_t *buf, size_t *len) {
+    (void)arg;
+    size_t n = 0;
+    for (int i = 0; i < QRNG_SOURCE_WORDS; i++) {
+        unsigned long long w;
+        int ok = 0;
+        // RDSEED fails transiently when the conditioner is drained
+        for (int r = 0; r < QRNG_RDSEED_RETRIES && !ok; r++) {
+            ok = _rdseed64_step(&w);
+        }
+        if (!ok) break;
+        memcpy(buf + n, &w, sizeof(w));
+        n += sizeof(w);
+    }
+    if (n == 0) return -1;
+    *len = n;
+    return 0;
+}
+
+__attribute__((target("rdrnd")))
+int qrng_source_rdrand(void *arg, uint8_t *buf, size_t *len) {
+    (void)arg;
+    size_t n = 0;
+    for (int i = 0; i < QRNG_SOURCE_WORDS; i++) {
+        unsigned long long w;
+        if (!_rdrand64_step(&w)) break;
+        memcpy(buf + n, &w, sizeof(w));
+        n += sizeof(w);
+    }
+    if (n == 0) return -1;
+    *len = n;
+    return 0;
+}
+#else
+int qrng_cpu_has_rdseed(void) { return 0; }
+int qrng_cpu_has_rdrand(void) { return 0; }
+
+int qrng_source_rdseed(void *arg, uint8_t *buf, size_t *len) {
+    (void)arg; (void)buf; (void)len;
+    return -1;
+}
+
+int qrng_source_rdrand(void *arg, uint8_t *buf, size_t *len) {
+    (void)arg; (void)buf; (void)len;
+    return -1;
+}
+#endif
+
+int qrng_source_jitter(void *arg, uint8_t *buf, size_t *len) {
+    qrng_seed_queue *q = arg;
+    if (q) {
+        uint32_t bits;
+        if (qrng_seed_queue_pop(q, buf, &bits) != 0) return -1;
+    } else if (qrng_jitter_collect(buf) != 0) {
+        return -1;
+    }
+    *len = QRNG_SEED_BYTES;
+    return 0;
+}
+
+// Total of the per-CPU counts on one /proc/interrupts line
+static uint64_t interrupt_total(const char *line) {
+    const char *p = strchr(line, ':');
+    if (!p) return 0;
+    p++;
+
+    uint64_t total = 0;
+    for (;;) {
+        while (*p == ' ' || *p == '\t') p++;
+        if (!isdigit((unsigned char)*p)) break;
+        total += strtoull(p, (char **)&p, 10);
+    }
+    return total;
+}
+
+int qrng_source_interrupts(void *arg, uint8_t *buf, size_t *len) {
+    qrng_interrupt_state *st = arg;
+    if (!st) return -1;
+
+    FILE *f = fopen("/proc/interrupts", "r");
+    if (!f) return -1;
+
+    char *line = NULL;
+    size_t cap = 0;
+    size_t index = 0, n = 0;
+    int first = 1;
+
+    while (getline(&line, &cap, f) >= 0) {
+        // The header row lists CPUs
+        if (first) {
+            first = 0;
+            continue;
+        }
+
+        if (index >= st->lines) {
+            uint64_t *grown = realloc(st->counts, (index + 1) * 2 * sizeof(uint64_t));
+            if (!grown) break;
+            memset(grown + st->lines, 0, ((index + 1) * 2 - st->lines) * sizeof(uint64_t));
+            st->counts = grown;
+            st->lines = (index + 1) * 2;
+        }
+
+        uint64_t total = interrupt_total(line);
+        uint64_t delta = total - st->counts[index];
+        st->counts[index] = total;
+        index++;
+
+        // Only counters that moved carry timing information
+        if (delta != 0 && n < QRNG_SOURCE_MAX_POLL) {
+            buf[n++] = (uint8_t)delta;
+        }
+    }
+
+    free(line);
+    fclose(f);
+
+    // Counts since boot are not fresh
+    if (!st->primed) {
+        st->primed = 1;
+        return -1;
+    }
+    if (n == 0) return -1;
+    *len = n;
+    return 0;
+}
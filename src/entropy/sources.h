@@ -0,0 +1,70 @@
+#ifndef QUANTUM_SOURCES_H
+#define QUANTUM_SOURCES_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+/**
+ * @file sources.h
+ * @brief Pluggable entropy sources
+ *
+ * A source is a poll function plus a rating and an interval. The mixer
+ * calls each source from its own thread no more often than its interval and
+ * credits rating_millibits / 1000 bits for every byte the poll returns.
+ */
+
+#define QRNG_SOURCE_MAX_POLL 256       /**< Largest buffer handed to a poll */
+
+/**
+ * @brief Poll a source
+ *
+ * @param arg Source argument
+ * @param buf Output buffer of QRNG_SOURCE_MAX_POLL bytes
+ * @param len[out] Bytes written
+ * @return 0 on success, -1 if the source has nothing to give right now
+ */
+typedef int (*qrng_source_poll_fn)(void *arg, uint8_t *buf, size_t *len);
+
+/**
+ * @brief Source registration
+ */
+typedef struct {
+    const char *name;                  /**< Static name for stats */
+    qrng_source_poll_fn poll;          /**< Called from the mixer thread */
+    void *arg;                         /**< Passed to poll */
+    uint32_t rating_millibits;         /**< Credited entropy per byte, 0..8000 */
+    uint32_t interval_ms;              /**< Minimum time between polls */
+} qrng_source;
+
+/**
+ * @brief Counters remembered between interrupt source polls
+ */
+typedef struct {
+    uint64_t *counts;                  /**< Per-line totals from the last poll */
+    size_t lines;
+    int primed;                        /**< First poll only records totals */
+} qrng_interrupt_state;
+
+/**
+ * @brief Built-in sources
+ *
+ * RDSEED and RDRAND return -1 when cpuid does not report them. The jitter
+ * source pops a finished seed from the qrng_seed_queue given as arg, which
+ * a qrng_jitter collector keeps filled; with a NULL arg it collects one on
+ * the calling thread. The interrupt source yields one byte per
+ * /proc/interrupts counter that changed since its last poll and takes a
+ * qrng_interrupt_state as arg.
+ */
+int qrng_source_getrandom(void *arg, uint8_t *buf, size_t *len);
+int qrng_source_rdseed(void *arg, uint8_t *buf, size_t *len);
+int qrng_source_rdrand(void *arg, uint8_t *buf, size_t *len);
+int qrng_source_jitter(void *arg, uint8_t *buf, size_t *len);
+int qrng_source_interrupts(void *arg, uint8_t *buf, size_t *len);
+
+/**
+ * @brief Whether the CPU has RDSEED or RDRAND
+ */
+int qrng_cpu_has_rdseed(void);
+int qrng_cpu_has_rdrand(void);
+
+#endif /* QUANTUM_SOURCES_H */
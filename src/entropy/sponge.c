@@ -0,0 +1,131 @@
+#include "sponge.h"
+#include <string.h>
+
+static const uint64_t keccak_rc[24] = {
+    0x0000000000000001ULL, 0x0000000000008082ULL, 0x800000000000808AULL,
+    0x8000000080008000ULL, 0x000000000000808BULL, 0x0000000080000001ULL,
+    0x8000000080008081ULL, 0x8000000000008009ULL, 0x000000000000008AULL,
+    0x0000000000000088ULL, 0x0000000080008009ULL, 0x000000008000000AULL,
+    0x000000008000808BULL, 0x800000000000008BULL, 0x8000000000008089ULL,
+    0x8000000000008003ULL, 0x8000000000008002ULL, 0x8000000000000080ULL,
+    0x000000000000800AULL, 0x800000008000000AULL, 0x8000000080008081ULL,
+    0x8000000000008080ULL, 0x0000000080000001ULL, 0x8000000080008008ULL
+};
+
+static const unsigned keccak_rho[24] = {
+    1, 3, 6, 10, 15, 21, 28, 36, 45, 55, 2, 14,
+    27, 41, 56, 8, 25, 43, 62, 18, 39, 61, 20, 44
+};
+
+static const unsigned keccak_pi[24] = {
+    10, 7, 11, 17, 18, 3, 5, 16, 8, 21, 24, 4,
+    15, 23, 19, 13, 12, 2, 20, 14, 22, 9, 6, 1
+};
+
+static inline uint64_t rotl64(uint64_t x, unsigned n) {
+    return (x << n) | (x >> (64 - n));
+}
+
+static void keccak_f1600(uint64_t a[25]) {
+    for (int round = 0; round < 24; round++) {
+        // Theta
+        uint64_t c[5], d;
+        for (int x = 0; x < 5; x++) {
+            c[x] = a[x] ^ a[x + 5] ^ a[x + 10] ^ a[x + 15] ^ a[x + 20];
+        }
+        for (int x = 0; x < 5; x++) {
+            d = c[(x + 4) % 5] ^ rotl64(c[(x + 1) % 5], 1);
+            for (int y = 0; y < 25; y += 5) a[y + x] ^= d;
+        }
+
+        // Rho and pi
+        uint64_t t = a[1];
+        for (int i = 0; i < 24; i++) {
+            unsigned j = keccak_pi[i];
+            uint64_t next = a[j];
+            a[j] = rotl64(t, keccak_rho[i]);
+            t = next;
+        }
+
+        // Chi
+        for (int y = 0; y < 25; y += 5) {
+            for (int x = 0; x < 5; x++) c[x] = a[y + x];
+            for (int x = 0; x < 5; x++) {
+                a[y + x] = c[x] ^ (~c[(x + 1) % 5] & c[(x + 2) % 5]);
+            }
+        }
+
+        // Iota
+        a[0] ^= keccak_rc[round];
+    }
+}
+
+// Lanes are little-endian, so byte i of the rate is byte i % 8 of lane i / 8
+static inline void xor_byte(qrng_sponge *s, size_t i, uint8_t b) {
+    s->state[i / 8] ^= (uint64_t)b << (8 * (i % 8));
+}
+
+static inline uint8_t get_byte(const qrng_sponge *s, size_t i) {
+    return (uint8_t)(s->state[i / 8] >> (8 * (i % 8)));
+}
+
+void qrng_sponge_init(qrng_sponge *s) {
+    memset(s, 0, sizeof(*s));
+}
+
+void qrng_sponge_absorb(qrng_sponge *s, const void *data, size_t len) {
+    const uint8_t *p = data;
+
+    if (s->squeezing) {
+        keccak_f1600(s->state);
+        s->pos = 0;
+        s->squeezing = 0;
+    }
+
+    while (len > 0) {
+        if (s->pos == 0 && len >= QRNG_SPONGE_RATE) {
+            // Whole blocks a lane at a time
+            for (size_t i = 0; i < QRNG_SPONGE_RATE / 8; i++) {
+                uint64_t w;
+                memcpy(&w, p + i * 8, sizeof(w));
+                s->state[i] ^= w;
+            }
+            keccak_f1600(s->state);
+            p += QRNG_SPONGE_RATE;
+            len -= QRNG_SPONGE_RATE;
+            continue;
+        }
+
+        xor_byte(s, s->pos++, *p++);
+        len--;
+        if (s->pos == QRNG_SPONGE_RATE) {
+            keccak_f1600(s->state);
+            s->pos = 0;
+        }
+    }
+}
+
+void qrng_sponge_squeeze(qrng_sponge *s, uint8_t *out, size_t len) {
+    if (!s->squeezing) {
+        // SHA3 domain padding
+        xor_byte(s, s->pos, 0x06);
+        xor_byte(s, QRNG_SPONGE_RATE - 1, 0x80);
+        keccak_f1600(s->state);
+        s->pos = 0;
+        s->squeezing = 1;
+    }
+
+    while (len > 0) {
+        if (s->pos == QRNG_SPONGE_RATE) {
+            keccak_f1600(s->state);
+            s->pos = 0;
+        }
+        *out++ = get_byte(s, s->pos++);
+        len--;
+    }
+}
+
+void qrng_sponge_clear(qrng_sponge *s) {
+    volatile uint8_t *p = (volatile uint8_t *)s;
+    for (size_t i = 0; i < sizeof(*s); i++) p[i] = 0;
+}
@@ -0,0 +1,66 @@
+#ifndef QUANTUM_SPONGE_H
+#define QUANTUM_SPONGE_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+/**
+ * @file sponge.h
+ * @brief Keccak sponge for conditioning raw entropy
+ *
+ * Keccak-f[1600] with the SHA3-256 rate and padding. A fresh sponge that
+ * absorbs a message and squeezes 32 bytes produces SHA3-256 of it. After a
+ * squeeze the sponge can absorb again, so one sponge can condition an
+ * unbounded stream of samples into a series of seeds.
+ */
+
+#define QRNG_SPONGE_RATE 136     /**< Bytes absorbed per permutation */
+#define QRNG_SEED_BYTES 32       /**< Conditioned seed size */
+
+/**
+ * @brief Sponge state
+ */
+typedef struct {
+    uint64_t state[25];
+    size_t pos;                  /**< Byte offset into the rate */
+    int squeezing;               /**< Padding applied, output being read */
+} qrng_sponge;
+
+/**
+ * @brief Reset a sponge to the empty state
+ *
+ * @param s Sponge
+ */
+void qrng_sponge_init(qrng_sponge *s);
+
+/**
+ * @brief Absorb input
+ *
+ * Absorbing after a squeeze permutes first, so earlier output cannot be
+ * recomputed from the later state.
+ *
+ * @param s Sponge
+ * @param data Input bytes
+ * @param len Input length
+ */
+void qrng_sponge_absorb(qrng_sponge *s, const void *data, size_t len);
+
+/**
+ * @brief Squeeze output
+ *
+ * The first squeeze after absorbing pads the input.
+ *
+ * @param s Sponge
+ * @param out Output buffer
+ * @param len Output length
+ */
+void qrng_sponge_squeeze(qrng_sponge *s, uint8_t *out, size_t len);
+
+/**
+ * @brief Wipe a sponge
+ *
+ * @param s Sponge
+ */
+void qrng_sponge_clear(qrng_sponge *s);
+
+#endif /* QUANTUM_SPONGE_H */
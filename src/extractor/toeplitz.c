@@ -0,0 +1,223 @@
+#include "toeplitz.h"
+#include "simd.h"
+#include <stdlib.h>
+#include <string.h>
+
+#if defined(__PCLMUL__) || defined(__VPCLMULQDQ__)
+#include <immintrin.h>
+#endif
+
+// Output bit i of an (m x n) Toeplitz product is coefficient n-1+i of the
+// carry-less product seed(z) * in(z). With n a multiple of 64 that spans
+// product words in_words-1 .. in_words+out_words-1, which only receive
+// contributions from word pairs (a, b) with a + b in [in_words-2, last].
+// Storing the seed reversed turns each such diagonal into two ascending
+// streams, one over the input and one over the seed.
+
+size_t qrng_toeplitz_seed_bytes(size_t in_bits, size_t out_bits) {
+    return (in_bits + out_bits) / 8;
+}
+
+qrng_toeplitz *qrng_toeplitz_create(const uint8_t *seed, size_t in_bits, size_t out_bits) {
+    if (!seed || in_bits == 0 || out_bits == 0) return NULL;
+    if (in_bits % 64 || out_bits % 64 || out_bits > in_bits) return NULL;
+    if (in_bits > QRNG_TOEPLITZ_MAX_BITS) return NULL;
+
+    qrng_toeplitz *t = calloc(1, sizeof(qrng_toeplitz));
+    if (!t) return NULL;
+
+    t->in_words = in_bits / 64;
+    t->out_words = out_bits / 64;
+
+    // One zero word past the end stands in for seed words below index 0
+    size_t seed_words = t->in_words + t->out_words;
+    t->seed_rev = calloc(seed_words + 1, sizeof(uint64_t));
+    if (!t->seed_rev) {
+        free(t);
+        return NULL;
+    }
+
+    for (size_t i = 0; i < seed_words; i++) {
+        uint64_t w;
+        memcpy(&w, seed + i * 8, sizeof(w));
+        t->seed_rev[seed_words - 1 - i] = w;
+    }
+    // Only in_bits + out_bits - 1 seed bits define the matrix
+    t->seed_rev[0] &= ~(1ULL << 63);
+
+    return t;
+}
+
+void qrng_toeplitz_destroy(qrng_toeplitz *t) {
+    if (t) {
+        if (t->seed_rev) {
+            memset(t->seed_rev, 0, (t->in_words + t->out_words + 1) * sizeof(uint64_t));
+            free(t->seed_rev);
+        }
+        free(t);
+    }
+}
+
+// 64x64 -> 128-bit carry-less multiply
+static inline void clmul64(uint64_t a, uint64_t b, uint64_t *lo, uint64_t *hi) {
+#if defined(__PCLMUL__)
+    __m128i p = _mm_clmulepi64_si128(_mm_cvtsi64_si128((long long)a),
+                                     _mm_cvtsi64_si128((long long)b), 0x00);
+    *lo = (uint64_t)_mm_cvtsi128_si64(p);
+    *hi = (uint64_t)_mm_extract_epi64(p, 1);
+#else
+    // Four bits of b per step against a table of a times every nibble
+    uint64_t tl[16], th[16];
+    tl[0] = 0;
+    th[0] = 0;
+    for (int k = 1; k < 16; k++) {
+        int bit = 63 - __builtin_clzll((unsigned long long)k);
+        int rest = k & ~(1 << bit);
+        tl[k] = tl[rest] ^ (a << bit);
+        th[k] = th[rest] ^ (bit ? a >> (64 - bit) : 0);
+    }
+
+    uint64_t l = 0, h = 0;
+    for (int i = 60; i >= 0; i -= 4) {
+        h = (h << 4) | (l >> 60);
+        l <<= 4;
+        unsigned nib = (unsigned)(b >> i) & 15;
+        l ^= tl[nib];
+        h ^= th[nib];
+    }
+    *lo = l;
+    *hi = h;
+#endif
+}
+
+static inline uint64_t load64(const uint8_t *p) {
+    uint64_t w;
+    memcpy(&w, p, sizeof(w));
+    return w;
+}
+
+#define QRNG_TOEPLITZ_GROUP 4
+
+// Diagonal d is the XOR of clmul(seed[d - b], in[b]) over every input word
+// b, a 128-bit value. Adjacent diagonals are computed together so each
+// input load feeds QRNG_TOEPLITZ_GROUP multiplies.
+static inline void diagonals(const qrng_toeplitz *t, const uint8_t *in, size_t d,
+                             size_t count, uint64_t *lo, uint64_t *hi) {
+    const uint64_t *s = t->seed_rev + (t->in_words + t->out_words - 1 - d);
+    size_t b = 0;
+
+    for (size_t g = 0; g < count; g++) {
+        lo[g] = 0;
+        hi[g] = 0;
+    }
+
+#if defined(__VPCLMULQDQ__) && defined(QRNG_SIMD_AVX512)
+    if (count == QRNG_TOEPLITZ_GROUP) {
+        __m512i acc[QRNG_TOEPLITZ_GROUP];
+        for (size_t g = 0; g < QRNG_TOEPLITZ_GROUP; g++) acc[g] = _mm512_setzero_si512();
+
+        for (; b + 8 <= t->in_words; b += 8) {
+            __m512i x = _mm512_loadu_si512(in + b * 8);
+            for (size_t g = 0; g < QRNG_TOEPLITZ_GROUP; g++) {
+                // Diagonal d + g reads the reversed seed g words earlier
+                __m512i y = _mm512_loadu_si512(s - g + b);
+                acc[g] = _mm512_ternarylogic_epi64(acc[g],
+                    _mm512_clmulepi64_epi128(x, y, 0x00),
+                    _mm512_clmulepi64_epi128(x, y, 0x11), 0x96);
+            }
+        }
+
+        for (size_t g = 0; g < QRNG_TOEPLITZ_GROUP; g++) {
+            __m256i r4 = _mm256_xor_si256(_mm512_castsi512_si256(acc[g]),
+                                          _mm512_extracti64x4_epi64(acc[g], 1));
+            __m128i r = _mm_xor_si128(_mm256_castsi256_si128(r4),
+                                      _mm256_extracti128_si256(r4, 1));
+            lo[g] = (uint64_t)_mm_cvtsi128_si64(r);
+            hi[g] = (uint64_t)_mm_extract_epi64(r, 1);
+        }
+    } else {
+        for (size_t g = 0; g < count; g++) {
+            __m512i acc = _mm512_setzero_si512();
+            for (b = 0; b + 8 <= t->in_words; b += 8) {
+                __m512i x = _mm512_loadu_si512(in + b * 8);
+                __m512i y = _mm512_loadu_si512(s - g + b);
+                acc = _mm512_ternarylogic_epi64(acc,
+                    _mm512_clmulepi64_epi128(x, y, 0x00),
+                    _mm512_clmulepi64_epi128(x, y, 0x11), 0x96);
+            }
+            __m256i r4 = _mm256_xor_si256(_mm512_castsi512_si256(acc),
+                                          _mm512_extracti64x4_epi64(acc, 1));
+            __m128i r = _mm_xor_si128(_mm256_castsi256_si128(r4),
+                                      _mm256_extracti128_si256(r4, 1));
+            lo[g] = (uint64_t)_mm_cvtsi128_si64(r);
+            hi[g] = (uint64_t)_mm_extract_epi64(r, 1);
+        }
+    }
+#elif defined(__PCLMUL__)
+    for (size_t g = 0; g < count; g++) {
+        __m128i acc = _mm_setzero_si128();
+        for (b = 0; b + 2 <= t->in_words; b += 2) {
+            __m128i x = _mm_loadu_si128((const __m128i *)(in + b * 8));
+            __m128i y = _mm_loadu_si128((const __m128i *)(s - g + b));
+            acc = _mm_xor_si128(acc, _mm_clmulepi64_si128(x, y, 0x00));
+            acc = _mm_xor_si128(acc, _mm_clmulepi64_si128(x, y, 0x11));
+        }
+        lo[g] = (uint64_t)_mm_cvtsi128_si64(acc);
+        hi[g] = (uint64_t)_mm_extract_epi64(acc, 1);
+    }
+#endif
+
+    for (size_t g = 0; g < count; g++) {
+        for (size_t j = b; j < t->in_words; j++) {
+            uint64_t pl, ph;
+            clmul64(s[j - g], load64(in + j * 8), &pl, &ph);
+            lo[g] ^= pl;
+            hi[g] ^= ph;
+        }
+    }
+}
+
+static void extract_block(const qrng_toeplitz *t, const uint8_t *in, uint8_t *out) {
+    uint64_t lo[QRNG_TOEPLITZ_GROUP], hi[QRNG_TOEPLITZ_GROUP];
+    uint64_t carry = 0, prev = 0;
+
+    // Product word w is lo(diagonal w) ^ hi(diagonal w - 1); output bit 0 is
+    // bit 63 of word in_words - 1, so diagonals in_words - 2 onwards matter.
+    // Diagonal -1 would only contribute its zero high half.
+    size_t first = t->in_words - 1;
+    size_t d = first > 0 ? first - 1 : first;
+    size_t last = first + t->out_words;
+
+    while (d <= last) {
+        size_t count = last - d + 1;
+        if (count > QRNG_TOEPLITZ_GROUP) count = QRNG_TOEPLITZ_GROUP;
+        diagonals(t, in, d, count, lo, hi);
+
+        for (size_t g = 0; g < count; g++, d++) {
+            if (d < first) {
+                carry = hi[g];
+                continue;
+            }
+            uint64_t word = lo[g] ^ carry;
+            carry = hi[g];
+
+            if (d > first) {
+                uint64_t y = (prev >> 63) | (word << 1);
+                memcpy(out + (d - first - 1) * 8, &y, sizeof(y));
+            }
+            prev = word;
+        }
+    }
+}
+
+void qrng_toeplitz_extract(const qrng_toeplitz *t, const uint8_t *in,
+                           uint8_t *out, size_t blocks) {
+    if (!t || !in || !out) return;
+
+    size_t in_bytes = t->in_words * 8;
+    size_t out_bytes = t->out_words * 8;
+
+    for (size_t i = 0; i < blocks; i++) {
+        extract_block(t, in + i * in_bytes, out + i * out_bytes);
+    }
+}
@@ -0,0 +1,72 @@
+#ifndef QUANTUM_TOEPLITZ_H
+#define QUANTUM_TOEPLITZ_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+/**
+ * @file toeplitz.h
+ * @brief Toeplitz-hash randomness extractor
+ *
+ * Compresses in_bits of raw samples into out_bits of nearly full-entropy
+ * output by multiplying with a random binary Toeplitz matrix. The
+ * matrix-vector product over GF(2) is a slice of the carry-less product of
+ * the seed and input polynomials, so it is computed with PCLMULQDQ, or
+ * VPCLMULQDQ four lanes at a time, with a portable shift-and-xor fallback.
+ */
+
+#define QRNG_TOEPLITZ_MAX_BITS 65536   /**< Largest supported input block */
+
+/**
+ * @brief Extractor with a fixed matrix
+ */
+typedef struct qrng_toeplitz {
+    size_t in_words;           /**< Input block size in 64-bit words */
+    size_t out_words;          /**< Output block size in 64-bit words */
+    uint64_t *seed_rev;        /**< Seed words in reverse order, zero padded */
+} qrng_toeplitz;
+
+/**
+ * @brief Seed size needed for a given shape
+ *
+ * @param in_bits Input block size
+ * @param out_bits Output block size
+ * @return Seed length in bytes
+ */
+size_t qrng_toeplitz_seed_bytes(size_t in_bits, size_t out_bits);
+
+/**
+ * @brief Create an extractor
+ *
+ * Both sizes must be non-zero multiples of 64 with out_bits <= in_bits.
+ * The seed must be independent of the data that will be extracted.
+ *
+ * @param seed Matrix seed of qrng_toeplitz_seed_bytes() bytes
+ * @param in_bits Input block size
+ * @param out_bits Output block size
+ * @return New extractor, or NULL on invalid shape or allocation failure
+ */
+qrng_toeplitz *qrng_toeplitz_create(const uint8_t *seed, size_t in_bits, size_t out_bits);
+
+/**
+ * @brief Free an extractor
+ *
+ * @param t Extractor to free
+ */
+void qrng_toeplitz_destroy(qrng_toeplitz *t);
+
+/**
+ * @brief Extract consecutive blocks
+ *
+ * Reads blocks * in_bits / 8 bytes and writes blocks * out_bits / 8 bytes.
+ * The extractor is read-only here, so several threads may share one.
+ *
+ * @param t Extractor
+ * @param in Raw input
+ * @param out Extracted output
+ * @param blocks Number of blocks
+ */
+void qrng_toeplitz_extract(const qrng_toeplitz *t, const uint8_t *in,
+                           uint8_t *out, size_t blocks);
+
+#endif /* QUANTUM_TOEPLITZ_H */
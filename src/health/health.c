@@ -0,0 +1,295 @@
+#include "health.h"
+#include "constants.h"
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Counters are written by the owning thread and read from anywhere
+#define STAT_ADD(h, field, n) \
+    __atomic_store_n(&(h)->field, (h)->field + (n), __ATOMIC_RELAXED)
+
+static void store_double(uint64_t *slot, double value) {
+    uint64_t bits;
+    memcpy(&bits, &value, sizeof(bits));
+    __atomic_store_n(slot, bits, __ATOMIC_RELEASE);
+}
+
+static double load_double(const uint64_t *slot) {
+    uint64_t bits = __atomic_load_n(slot, __ATOMIC_ACQUIRE);
+    double value;
+    memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+// Smallest c with P(X <= c) >= 1 - alpha for X ~ Binomial(n, p)
+static uint32_t critbinom(uint32_t n, double p, double alpha) {
+    double pmf = pow(1.0 - p, n);
+    double cdf = pmf;
+    uint32_t c = 0;
+
+    while (cdf < 1.0 - alpha && c < n) {
+        pmf *= (double)(n - c) / (double)(c + 1) * p / (1.0 - p);
+        cdf += pmf;
+        c++;
+    }
+    return c;
+}
+
+qrng_health *qrng_health_create(void) {
+    qrng_health *h = calloc(1, sizeof(qrng_health));
+    if (!h) return NULL;
+
+    // QRNG_MIN_ENTROPY is the claimed min-entropy of a 64-bit sample.
+    // Cutoffs follow SP 800-90B 4.4.1 and 4.4.2.
+    double alpha = ldexp(1.0, -QRNG_HEALTH_ALPHA_LOG2);
+    h->rct_cutoff = 1 + (uint32_t)ceil(QRNG_HEALTH_ALPHA_LOG2 / QRNG_MIN_ENTROPY);
+    h->apt_cutoff = 1 + critbinom(QRNG_APT_WINDOW,
+        exp2(-QRNG_MIN_ENTROPY / 8.0), alpha);
+
+    // The chi-square trips on a streak of windows, so each window's cutoff
+    // is the streak-th root of alpha
+    h->chi_cutoff = exp2(-(double)QRNG_HEALTH_ALPHA_LOG2 / QRNG_CHI_FAIL_STREAK);
+
+    return h;
+}
+
+void qrng_health_destroy(qrng_health *h) {
+    if (h) {
+        memset(h, 0, sizeof(*h));
+        free(h);
+    }
+}
+
+// Fold the interleaved sub-histograms into the first one
+static void merge_counts(qrng_health *h) {
+    for (int w = 1; w < QRNG_HISTOGRAM_WAYS; w++) {
+        for (int i = 0; i < 256; i++) {
+            h->counts[0][i] += h->counts[w][i];
+        }
+        memset(h->counts[w], 0, sizeof(h->counts[w]));
+    }
+}
+
+// Most-common-value estimate over the counted window (SP 800-90B 6.3.1)
+static double mcv_min_entropy(const uint32_t *counts, size_t n) {
+    uint32_t max = 0;
+    for (int i = 0; i < 256; i++) {
+        if (counts[i] > max) max = counts[i];
+    }
+
+    double p = (double)max / n;
+    double pu = p + 2.576 * sqrt(p * (1.0 - p) / (double)(n - 1));
+    if (pu > 1.0) pu = 1.0;
+
+    return -log2(pu) / 8.0;
+}
+
+// Upper-tail p-value of the window's chi-square statistic against a uniform
+// byte distribution. QRNG_CHI_THRESHOLD is the statistic's expectation, its
+// 255 degrees of freedom; the tail uses the Wilson-Hilferty approximation.
+static double chi_square_pvalue(const uint32_t *counts, size_t n, double *stat) {
+    double expected = (double)n / 256.0;
+    double chi = 0.0;
+    for (int i = 0; i < 256; i++) {
+        double d = counts[i] - expected;
+        chi += d * d;
+    }
+    chi /= expected;
+    *stat = chi;
+
+    double k = QRNG_CHI_THRESHOLD;
+    double z = (cbrt(chi / k) - (1.0 - 2.0 / (9.0 * k))) / sqrt(2.0 / (9.0 * k));
+    return 0.5 * erfc(z / M_SQRT2);
+}
+
+void qrng_health_publish(qrng_health *h) {
+    if (!h || h->window_fill < 2) return;
+
+    merge_counts(h);
+    store_double(&h->estimate_bits, mcv_min_entropy(h->counts[0], h->window_fill));
+}
+
+// Close a full window: publish the estimate and run the chi-square test
+static int finish_window(qrng_health *h) {
+    int failed = 0;
+
+    qrng_health_publish(h);
+
+    double stat;
+    double pvalue = chi_square_pvalue(h->counts[0], h->window_fill, &stat);
+    store_double(&h->chi_square_bits, stat);
+    store_double(&h->chi_pvalue_bits, pvalue);
+    STAT_ADD(h, windows, 1);
+
+    // Windows below QRNG_PVALUE_THRESH are only counted for monitoring
+    if (pvalue < QRNG_PVALUE_THRESH) STAT_ADD(h, chi_failures, 1);
+    if (pvalue < h->chi_cutoff) {
+        if (++h->chi_streak >= QRNG_CHI_FAIL_STREAK) {
+            h->chi_streak = 0;
+            failed |= QRNG_HEALTH_CHI_FAILED;
+        }
+    } else {
+        h->chi_streak = 0;
+    }
+
+    memset(h->counts[0], 0, sizeof(h->counts[0]));
+    h->window_fill = 0;
+    return failed;
+}
+
+// Repetition Count Test over 64-bit samples
+static int repetition_count(qrng_health *h, const uint8_t *data, size_t len) {
+    int failed = 0;
+
+    for (size_t i = 0; i + sizeof(uint64_t) <= len; i += sizeof(uint64_t)) {
+        uint64_t w;
+        memcpy(&w, data + i, sizeof(w));
+        if (w == h->rct_last && h->rct_run > 0) {
+            if (++h->rct_run >= h->rct_cutoff) {
+                failed = QRNG_HEALTH_RCT_FAILED;
+                h->rct_run = 1;
+            }
+        } else {
+            h->rct_last = w;
+            h->rct_run = 1;
+        }
+    }
+    return failed;
+}
+
+// Adaptive Proportion Test over byte samples. The inner count is a plain
+// compare-and-add over the span, which the compiler vectorises.
+static int adaptive_proportion(qrng_health *h, const uint8_t *data, size_t len) {
+    int failed = 0;
+
+    while (len > 0) {
+        if (h->apt_fill == 0) {
+            h->apt_ref = data[0];
+            h->apt_count = 0;
+        }
+
+        size_t span = QRNG_APT_WINDOW - h->apt_fill;
+        if (span > len) span = len;
+
+        uint32_t hits = 0;
+        for (size_t i = 0; i < span; i++) {
+            hits += data[i] == h->apt_ref;
+        }
+        h->apt_count += hits;
+        h->apt_fill += span;
+        data += span;
+        len -= span;
+
+        if (h->apt_fill == QRNG_APT_WINDOW) {
+            if (h->apt_count >= h->apt_cutoff) failed = QRNG_HEALTH_APT_FAILED;
+            h->apt_fill = 0;
+        }
+    }
+    return failed;
+}
+
+// Count bytes into interleaved sub-histograms so neighbouring equal bytes do
+// not serialise on the same counter
+static void histogram(qrng_health *h, const uint8_t *data, size_t len) {
+    size_t i = 0;
+    for (; i + QRNG_HISTOGRAM_WAYS <= len; i += QRNG_HISTOGRAM_WAYS) {
+        for (int w = 0; w < QRNG_HISTOGRAM_WAYS; w++) {
+            h->counts[w][data[i + w]]++;
+        }
+    }
+    for (; i < len; i++) {
+        h->counts[0][data[i]]++;
+    }
+}
+
+int qrng_health_update(qrng_health *h, const uint8_t *data, size_t len) {
+    if (!h) return 0;
+
+    int failed = repetition_count(h, data, len) | adaptive_proportion(h, data, len);
+
+    while (len > 0) {
+        size_t span = QRNG_ESTIMATOR_WINDOW - h->window_fill;
+        if (span > len) span = len;
+
+        histogram(h, data, span);
+        h->window_fill += span;
+        data += span;
+        len -= span;
+
+        if (h->window_fill == QRNG_ESTIMATOR_WINDOW) {
+            failed |= finish_window(h);
+        }
+    }
+
+    if (failed & QRNG_HEALTH_RCT_FAILED) STAT_ADD(h, rct_failures, 1);
+    if (failed & QRNG_HEALTH_APT_FAILED) STAT_ADD(h, apt_failures, 1);
+    if (failed) STAT_ADD(h, failures, 1);
+
+    return failed;
+}
+
+int qrng_health_merge(qrng_health *dst, qrng_health *src) {
+    if (!dst || !src) return 0;
+
+    int failed = 0;
+
+    // Windows the substream closed were already tested; take their results
+    STAT_ADD(dst, windows, src->windows);
+    STAT_ADD(dst, rct_failures, src->rct_failures);
+    STAT_ADD(dst, apt_failures, src->apt_failures);
+    STAT_ADD(dst, chi_failures, src->chi_failures);
+    STAT_ADD(dst, failures, src->failures);
+    if (src->windows > 0) {
+        store_double(&dst->estimate_bits, load_double(&src->estimate_bits));
+        store_double(&dst->chi_square_bits, load_double(&src->chi_square_bits));
+        store_double(&dst->chi_pvalue_bits, load_double(&src->chi_pvalue_bits));
+    }
+
+    // Its partial window joins ours, so short substreams are still counted
+    merge_counts(src);
+    for (int i = 0; i < 256; i++) {
+        dst->counts[0][i] += src->counts[0][i];
+    }
+    dst->window_fill += src->window_fill;
+    if (dst->window_fill >= QRNG_ESTIMATOR_WINDOW) {
+        failed = finish_window(dst);
+        if (failed) STAT_ADD(dst, failures, 1);
+    }
+
+    memset(src->counts[0], 0, sizeof(src->counts[0]));
+    src->window_fill = 0;
+    __atomic_store_n(&src->windows, 0, __ATOMIC_RELAXED);
+    __atomic_store_n(&src->rct_failures, 0, __ATOMIC_RELAXED);
+    __atomic_store_n(&src->apt_failures, 0, __ATOMIC_RELAXED);
+    __atomic_store_n(&src->chi_failures, 0, __ATOMIC_RELAXED);
+    __atomic_store_n(&src->failures, 0, __ATOMIC_RELAXED);
+    return failed;
+}
+
+uint64_t qrng_health_estimate_bits(const uint8_t *data, size_t len) {
+    if (!data || len < 2) return 0;
+
+    uint32_t counts[256] = {0};
+    for (size_t i = 0; i < len; i++) {
+        counts[data[i]]++;
+    }
+    return (uint64_t)(mcv_min_entropy(counts, len) * 8.0 * (double)len);
+}
+
+double qrng_health_min_entropy(const qrng_health *h) {
+    if (!h) return 0.0;
+    return load_double(&h->estimate_bits);
+}
+
+void qrng_health_get_stats(const qrng_health *h, qrng_health_stats *out) {
+    memset(out, 0, sizeof(*out));
+    if (!h) return;
+
+    out->windows = __atomic_load_n(&h->windows, __ATOMIC_RELAXED);
+    out->rct_failures = __atomic_load_n(&h->rct_failures, __ATOMIC_RELAXED);
+    out->apt_failures = __atomic_load_n(&h->apt_failures, __ATOMIC_RELAXED);
+    out->chi_failures = __atomic_load_n(&h->chi_failures, __ATOMIC_RELAXED);
+    out->failures = __atomic_load_n(&h->failures, __ATOMIC_RELAXED);
+    out->last_chi_square = load_double(&h->chi_square_bits);
+    out->last_chi_pvalue = load_double(&h->chi_pvalue_bits);
+}
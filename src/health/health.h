@@ -0,0 +1,143 @@
+#ifndef QUANTUM_HEALTH_H
+#define QUANTUM_HEALTH_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include "quantum_rng.h"
+
+/**
+ * @file health.h
+ * @brief Running quality estimators and continuous health tests
+ *
+ * The refill path feeds every freshly generated buffer through
+ * qrng_health_update(), which runs the SP 800-90B continuous tests
+ * (Repetition Count and Adaptive Proportion) and a rolling chi-square over
+ * the byte histogram. Estimates and counters are published atomically, so
+ * readers on any thread get an O(1), lock-free snapshot.
+ */
+
+#define QRNG_ESTIMATOR_WINDOW 16384    /**< Output bytes per published estimate */
+#define QRNG_APT_WINDOW 512            /**< Adaptive Proportion Test window (bytes) */
+#define QRNG_HEALTH_ALPHA_LOG2 40      /**< False positive rate 2^-40 of every test */
+#define QRNG_CHI_FAIL_STREAK 3         /**< Consecutive chi-square windows below the cutoff that trip */
+#define QRNG_HISTOGRAM_WAYS 4          /**< Interleaved sub-histograms */
+
+/**
+ * @brief Health test failure flags returned by qrng_health_update()
+ */
+#define QRNG_HEALTH_RCT_FAILED 0x01
+#define QRNG_HEALTH_APT_FAILED 0x02
+#define QRNG_HEALTH_CHI_FAILED 0x04
+
+/**
+ * @brief Per-context estimator and test state
+ */
+typedef struct qrng_health {
+    uint32_t counts[QRNG_HISTOGRAM_WAYS][256]; /**< Byte histograms of the current window */
+    size_t window_fill;        /**< Bytes counted in the current window */
+    uint64_t estimate_bits;    /**< Published estimate, bit pattern of a double */
+
+    uint64_t rct_last;         /**< Previous 64-bit sample */
+    uint32_t rct_run;          /**< Length of the current run of rct_last */
+    uint32_t rct_cutoff;
+    uint8_t apt_ref;           /**< First byte of the current APT window */
+    uint32_t apt_count;        /**< Occurrences of apt_ref so far */
+    size_t apt_fill;           /**< Bytes seen in the current APT window */
+    uint32_t apt_cutoff;
+    uint32_t chi_streak;       /**< Consecutive chi-square windows below chi_cutoff */
+    double chi_cutoff;         /**< Window p-value that counts towards a trip */
+
+    // Published counters, written by the owner and read atomically
+    uint64_t windows;
+    uint64_t rct_failures;
+    uint64_t apt_failures;
+    uint64_t chi_failures;
+    uint64_t failures;
+    uint64_t chi_square_bits;
+    uint64_t chi_pvalue_bits;
+} qrng_health;
+
+/**
+ * @brief Allocate an estimator with test cutoffs derived from QRNG_MIN_ENTROPY
+ *
+ * @return New estimator, or NULL on allocation failure
+ */
+qrng_health *qrng_health_create(void);
+
+/**
+ * @brief Free an estimator
+ *
+ * @param h Estimator to free
+ */
+void qrng_health_destroy(qrng_health *h);
+
+/**
+ * @brief Account for and test newly generated output
+ *
+ * Called only by the thread that owns the generating context.
+ *
+ * @param h Estimator
+ * @param data Output bytes
+ * @param len Number of bytes
+ * @return 0 if all tests passed, otherwise QRNG_HEALTH_*_FAILED flags
+ */
+int qrng_health_update(qrng_health *h, const uint8_t *data, size_t len);
+
+/**
+ * @brief Fold a substream's estimator into the owning context's
+ *
+ * Parallel generation tests each substream with its own estimator; this
+ * adds its counters and partial window to dst, closing a window there if
+ * it fills. src's counters and partial window are consumed, so a
+ * long-lived estimator can be merged again later; its continuous test
+ * state carries on.
+ *
+ * @param dst Estimator of the owning context
+ * @param src Substream estimator
+ * @return 0, or QRNG_HEALTH_CHI_FAILED if a window closed by the merge failed
+ */
+int qrng_health_merge(qrng_health *dst, qrng_health *src);
+
+/**
+ * @brief Publish an estimate from the current partial window
+ *
+ * Used after warm-up so an estimate is available before the first full
+ * window completes.
+ *
+ * @param h Estimator
+ */
+void qrng_health_publish(qrng_health *h);
+
+/**
+ * @brief Latest most-common-value min-entropy estimate
+ *
+ * SP 800-90B section 6.3.1 estimate over the last window of output bytes,
+ * using the upper 99% confidence bound on the most common value.
+ *
+ * @param h Estimator
+ * @return Min-entropy per output bit (between 0 and 1)
+ */
+double qrng_health_min_entropy(const qrng_health *h);
+
+/**
+ * @brief Most-common-value min-entropy of a standalone buffer
+ *
+ * Same estimate as the running one, taken over data alone. Used to credit
+ * caller-supplied seeds by what they measurably contain rather than by
+ * their length; short or repetitive seeds credit little or nothing.
+ *
+ * @param data Bytes to assess
+ * @param len Number of bytes
+ * @return Estimated bits of min-entropy in data, 0 if len < 2
+ */
+uint64_t qrng_health_estimate_bits(const uint8_t *data, size_t len);
+
+/**
+ * @brief Snapshot the health test counters
+ *
+ * @param h Estimator
+ * @param out Receives the counters
+ */
+void qrng_health_get_stats(const qrng_health *h, qrng_health_stats *out);
+
+#endif /* QUANTUM_HEALTH_H */
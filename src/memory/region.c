@@ -0,0 +1,111 @@
+#ifndef _GNU_SOURCE
+#define _GNU_SOURCE   // MAP_HUGETLB, MADV_HUGEPAGE
+#endif
+#include "region.h"
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+
+static int hugepages_disabled(void) {
+    static int cached = -1;
+    int v = __atomic_load_n(&cached, __ATOMIC_RELAXED);
+    if (v < 0) {
+        const char *env = getenv("QRNG_HUGEPAGES");
+        v = env && strcmp(env, "0") == 0;
+        __atomic_store_n(&cached, v, __ATOMIC_RELAXED);
+    }
+    return v;
+}
+
+static size_t round_up(size_t n, size_t to) {
+    return (n + to - 1) & ~(to - 1);
+}
+
+// Anonymous mapping of len bytes aligned to QRNG_HUGEPAGE_SIZE: map one
+// extra hugepage and trim both ends
+static void *map_aligned(size_t len) {
+    size_t over = len + QRNG_HUGEPAGE_SIZE;
+    uint8_t *p = mmap(NULL, over, PROT_READ | PROT_WRITE,
+                      MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (p == MAP_FAILED) return NULL;
+
+    uint8_t *base = (uint8_t *)round_up((uintptr_t)p, QRNG_HUGEPAGE_SIZE);
+    size_t head = (size_t)(base - p);
+    if (head) munmap(p, head);
+    if (over - head > len) munmap(base + len, over - head - len);
+    return base;
+}
+
+int qrng_region_alloc(qrng_region *r, size_t size, int flags) {
+    if (!r) return -1;
+    memset(r, 0, sizeof(*r));
+    if (size == 0) return -1;
+
+    if (size < QRNG_REGION_THRESHOLD && !(flags & QRNG_REGION_MAPPED)) {
+        r->base = aligned_alloc(QRNG_REGION_ALIGN, round_up(size, QRNG_REGION_ALIGN));
+        if (!r->base) return -1;
+        memset(r->base, 0, size);
+        r->size = size;
+        r->kind = QRNG_PAGES_HEAP;
+        return 0;
+    }
+    // A small mapping is only wanted for placement; base pages will do
+    if (size < QRNG_REGION_THRESHOLD) flags |= QRNG_REGION_NO_HUGEPAGES;
+
+    size_t len = round_up(size, QRNG_HUGEPAGE_SIZE);
+    int huge = !(flags & QRNG_REGION_NO_HUGEPAGES) && !hugepages_disabled();
+    void *p = NULL;
+    qrng_page_kind kind = QRNG_PAGES_SMALL;
+
+#ifdef MAP_HUGETLB
+    // Fails immediately when the reserved pool cannot cover the mapping
+    if (huge) {
+        p = mmap(NULL, len, PROT_READ | PROT_WRITE,
+                 MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+        if (p == MAP_FAILED) {
+            p = NULL;
+        } else {
+            kind = QRNG_PAGES_HUGETLB;
+        }
+    }
+#endif
+
+    if (!p) {
+        p = map_aligned(len);
+        if (!p) return -1;
+#ifdef MADV_HUGEPAGE
+        // Rejected when THP is disabled, leaving base pages
+        if (huge && madvise(p, len, MADV_HUGEPAGE) == 0) {
+            kind = QRNG_PAGES_TRANSPARENT;
+        }
+#endif
+    }
+
+    r->base = p;
+    r->size = size;
+    r->mapped = len;
+    r->kind = kind;
+    return 0;
+}
+
+void qrng_region_free(qrng_region *r) {
+    if (!r || !r->base) return;
+
+    if (r->kind == QRNG_PAGES_HEAP) {
+        free(r->base);
+    } else {
+        munmap(r->base, r->mapped);
+    }
+    memset(r, 0, sizeof(*r));
+}
+
+const char *qrng_page_kind_name(qrng_page_kind kind) {
+    switch (kind) {
+    case QRNG_PAGES_HEAP: return "heap";
+    case QRNG_PAGES_SMALL: return "small";
+    case QRNG_PAGES_TRANSPARENT: return "transparent";
+    case QRNG_PAGES_HUGETLB: return "hugetlb";
+    }
+    return "unknown";
+}
@@ -0,0 +1,80 @@
+#ifndef QUANTUM_REGION_H
+#define QUANTUM_REGION_H
+
+#include <stddef.h>
+
+/**
+ * @file region.h
+ * @brief Large zeroed allocations backed by hugepages where possible
+ *
+ * Regions at or above QRNG_REGION_THRESHOLD are mapped directly, trying
+ * reserved hugetlbfs pages first, then transparent hugepages, then base
+ * pages. Smaller regions come from the heap unless QRNG_REGION_MAPPED asks
+ * for a mapping of base pages. Mapped pages are not touched here, so the
+ * first thread to write a page decides its NUMA node.
+ */
+
+#define QRNG_HUGEPAGE_SIZE ((size_t)2 << 20)        /**< x86-64 PMD page */
+#define QRNG_REGION_THRESHOLD QRNG_HUGEPAGE_SIZE    /**< Smaller regions use the heap */
+#define QRNG_REGION_ALIGN 64                        /**< Minimum base alignment */
+
+/**
+ * @brief Where a region's memory came from
+ */
+typedef enum {
+    QRNG_PAGES_HEAP = 0,               /**< Heap block below the threshold */
+    QRNG_PAGES_SMALL,                  /**< Mapping on base pages */
+    QRNG_PAGES_TRANSPARENT,            /**< Mapping advised for transparent hugepages */
+    QRNG_PAGES_HUGETLB                 /**< Reserved hugetlbfs pages */
+} qrng_page_kind;
+
+/**
+ * @brief Flags for qrng_region_alloc()
+ */
+enum {
+    QRNG_REGION_NO_HUGEPAGES = 1 << 0, /**< Map base pages only */
+    QRNG_REGION_MAPPED = 1 << 1        /**< Map even below the threshold, for placement */
+};
+
+/**
+ * @brief Allocated region
+ */
+typedef struct qrng_region {
+    void *base;                        /**< Start, QRNG_REGION_ALIGN aligned */
+    size_t size;                       /**< Requested size */
+    size_t mapped;                     /**< Bytes mapped, 0 for heap blocks */
+    qrng_page_kind kind;
+} qrng_region;
+
+/**
+ * @brief Allocate a zeroed region
+ *
+ * Mapped regions are QRNG_HUGEPAGE_SIZE aligned whichever pages back them.
+ * The process-wide default can be forced to base pages by setting the
+ * environment variable QRNG_HUGEPAGES=0.
+ *
+ * @param r[out] Region descriptor
+ * @param size Bytes to allocate
+ * @param flags QRNG_REGION_* flags
+ * @return 0 on success, -1 on failure
+ */
+int qrng_region_alloc(qrng_region *r, size_t size, int flags);
+
+/**
+ * @brief Release a region
+ *
+ * Safe on a zeroed descriptor or one already freed.
+ *
+ * @param r Region
+ */
+void qrng_region_free(qrng_region *r);
+
+/**
+ * @brief Name of a page kind, for metrics
+ *
+ * @param kind Page kind
+ * @return Static string such as "hugetlb"
+ */
+const char *qrng_page_kind_name(qrng_page_kind kind);
+
+#endif /* QUANTUM_REGION_H */
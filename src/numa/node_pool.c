@@ -0,0 +1,240 @@
+#include "node_pool.h"
+#include "topology.h"
+#include "region.h"
+#include <pthread.h>
+#include <stdlib.h>
+#include <string.h>
+
+// One node's ring. The refill thread alone writes [tail, head + capacity)
+// and advances tail; consumers copy [head, tail) and advance head. Both
+// cursors only grow and are updated under lock.
+typedef struct {
+    int node;
+    qrng_ctx *ctx;                     // Used only by the refill thread
+    qrng_region mem;
+    uint8_t *buf;
+    size_t capacity;
+
+    pthread_mutex_t lock;
+    pthread_cond_t refill;             // Refill thread sleeps here
+    pthread_cond_t ready;              // Consumers wait here for bytes
+    uint64_t head;
+    uint64_t tail;
+    int stop;
+    int filling;                       // Between the low watermark and full
+    qrng_error error;                  // Last generation failure
+    pthread_t thread;
+    int running;
+
+    uint64_t refills;
+    uint64_t served;
+    uint64_t waits;
+    int bound;
+    int pinned;
+} __attribute__((aligned(64))) node_pool;
+
+struct qrng_node_pools {
+    size_t count;
+    node_pool *pools[QRNG_NUMA_MAX_NODES];
+    uint8_t route[QRNG_NUMA_MAX_NODES];    // Node id to pool index
+};
+
+static void *refill_thread(void *arg) {
+    node_pool *np = arg;
+    int pinned = qrng_numa_run_on_node(np->node) == 0;
+
+    pthread_mutex_lock(&np->lock);
+    np->pinned = pinned;
+    while (!np->stop) {
+        // Top up to full, then sleep until consumers drain below half
+        uint64_t fill = np->tail - np->head;
+        if (fill >= np->capacity) {
+            np->filling = 0;
+        } else if (fill <= np->capacity / 2) {
+            np->filling = 1;
+        }
+        if (!np->filling) {
+            pthread_cond_wait(&np->refill, &np->lock);
+            continue;
+        }
+
+        size_t off = np->tail % np->capacity;
+        size_t n = np->capacity - fill;
+        if (n > QRNG_NODE_POOL_CHUNK) n = QRNG_NODE_POOL_CHUNK;
+        if (n > np->capacity - off) n = np->capacity - off;
+
+        pthread_mutex_unlock(&np->lock);
+        qrng_error err = qrng_bytes(np->ctx, np->buf + off, n);
+        pthread_mutex_lock(&np->lock);
+
+        if (err != QRNG_SUCCESS) {
+            np->error = err;
+            pthread_cond_broadcast(&np->ready);
+            pthread_cond_wait(&np->refill, &np->lock);
+            continue;
+        }
+        np->error = QRNG_SUCCESS;
+        np->tail += n;
+        np->refills++;
+        pthread_cond_broadcast(&np->ready);
+    }
+    pthread_mutex_unlock(&np->lock);
+    return NULL;
+}
+
+static void pool_free(node_pool *np) {
+    if (!np) return;
+
+    if (np->running) {
+        pthread_mutex_lock(&np->lock);
+        np->stop = 1;
+        pthread_cond_signal(&np->refill);
+        pthread_mutex_unlock(&np->lock);
+        pthread_join(np->thread, NULL);
+    }
+    pthread_cond_destroy(&np->ready);
+    pthread_cond_destroy(&np->refill);
+    pthread_mutex_destroy(&np->lock);
+    qrng_region_free(&np->mem);
+    qrng_free(np->ctx);
+    free(np);
+}
+
+static node_pool *pool_create(qrng_ctx *root, uint64_t index, int node, size_t capacity) {
+    node_pool *np = aligned_alloc(64, sizeof(node_pool));
+    if (!np) return NULL;
+    memset(np, 0, sizeof(*np));
+    np->node = node;
+    np->capacity = capacity;
+    np->filling = 1;
+    pthread_mutex_init(&np->lock, NULL);
+    pthread_cond_init(&np->refill, NULL);
+    pthread_cond_init(&np->ready, NULL);
+
+    // The split keeps root's seed queue, reseed schedule and conditioning;
+    // the entropy policy is carried over by hand
+    if (qrng_split(root, index, &np->ctx) != QRNG_SUCCESS) {
+        pool_free(np);
+        return NULL;
+    }
+    qrng_set_entropy_policy(np->ctx, root->entropy_policy);
+
+    // Placement must be set before the refill thread first touches a page,
+    // so even small pools are mapped rather than taken from the heap
+    if (qrng_region_alloc(&np->mem, capacity, QRNG_REGION_MAPPED) != 0) {
+        pool_free(np);
+        return NULL;
+    }
+    np->buf = np->mem.base;
+    if (np->mem.mapped) {
+        np->bound = qrng_numa_bind(np->mem.base, np->mem.mapped, node) == 0;
+    }
+
+    if (pthread_create(&np->thread, NULL, refill_thread, np) != 0) {
+        pool_free(np);
+        return NULL;
+    }
+    np->running = 1;
+    return np;
+}
+
+qrng_node_pools *qrng_node_pools_create(qrng_ctx *root, size_t bytes_per_node) {
+    if (!root) return NULL;
+
+    size_t capacity = bytes_per_node < QRNG_NODE_POOL_MIN_BYTES ? QRNG_NODE_POOL_MIN_BYTES : bytes_per_node;
+    capacity = (capacity + QRNG_NODE_POOL_CHUNK - 1) / QRNG_NODE_POOL_CHUNK * QRNG_NODE_POOL_CHUNK;
+
+    qrng_node_pools *p = calloc(1, sizeof(qrng_node_pools));
+    if (!p) return NULL;
+
+    // A fresh base keeps pools created from the same root apart
+    uint64_t base;
+    if (qrng_uint64_checked(root, &base) != QRNG_SUCCESS) {
+        free(p);
+        return NULL;
+    }
+
+    int nodes[QRNG_NUMA_MAX_NODES];
+    size_t n = qrng_numa_nodes(nodes, QRNG_NUMA_MAX_NODES);
+    for (size_t i = 0; i < n; i++) {
+        p->pools[i] = pool_create(root, base + i, nodes[i], capacity);
+        if (!p->pools[i]) {
+            qrng_node_pools_destroy(p);
+            return NULL;
+        }
+        p->route[nodes[i]] = (uint8_t)i;
+        p->count++;
+    }
+    return p;
+}
+
+void qrng_node_pools_destroy(qrng_node_pools *p) {
+    if (!p) return;
+    for (size_t i = 0; i < p->count; i++) {
+        pool_free(p->pools[i]);
+    }
+    free(p);
+}
+
+qrng_error qrng_node_pools_bytes(qrng_node_pools *p, uint8_t *out, size_t len) {
+    if (!p) return QRNG_ERROR_NULL_CONTEXT;
+    if (!out) return QRNG_ERROR_NULL_BUFFER;
+
+    // Nodes without a pool of their own fall back to the first one
+    node_pool *np = p->pools[p->route[qrng_numa_current_node()]];
+
+    pthread_mutex_lock(&np->lock);
+    while (len > 0) {
+        while (np->tail == np->head) {
+            if (np->error != QRNG_SUCCESS) {
+                qrng_error err = np->error;
+                np->error = QRNG_SUCCESS;
+                pthread_cond_signal(&np->refill);
+                pthread_mutex_unlock(&np->lock);
+                return err;
+            }
+            np->waits++;
+            pthread_cond_signal(&np->refill);
+            pthread_cond_wait(&np->ready, &np->lock);
+        }
+
+        size_t off = np->head % np->capacity;
+        size_t n = np->tail - np->head;
+        if (n > len) n = len;
+        if (n > np->capacity - off) n = np->capacity - off;
+
+        memcpy(out, np->buf + off, n);
+        np->head += n;
+        np->served += n;
+        out += n;
+        len -= n;
+
+        if (np->tail - np->head <= np->capacity / 2) {
+            pthread_cond_signal(&np->refill);
+        }
+    }
+    pthread_mutex_unlock(&np->lock);
+    return QRNG_SUCCESS;
+}
+
+size_t qrng_node_pools_get_stats(qrng_node_pools *p, qrng_node_pool_stats *stats, size_t max) {
+    if (!p || !stats) return 0;
+
+    size_t n = p->count < max ? p->count : max;
+    for (size_t i = 0; i < n; i++) {
+        node_pool *np = p->pools[i];
+        pthread_mutex_lock(&np->lock);
+        stats[i] = (qrng_node_pool_stats){
+            .node = np->node,
+            .capacity = np->capacity,
+            .fill = (size_t)(np->tail - np->head),
+            .refills = np->refills,
+            .served = np->served,
+            .waits = np->waits,
+            .bound = np->bound,
+            .pinned = np->pinned,
+        };
+        pthread_mutex_unlock(&np->lock);
+    }
+    return n;
+}
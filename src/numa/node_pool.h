@@ -0,0 +1,84 @@
+#ifndef QUANTUM_NODE_POOL_H
+#define QUANTUM_NODE_POOL_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include "quantum_rng.h"
+#include "topology.h"
+
+/**
+ * @file node_pool.h
+ * @brief Per-NUMA-node pools of pre-generated bytes
+ *
+ * One pool per online node, each with its own context split from a root
+ * context and a refill thread restricted to the node's CPUs. Pool memory is
+ * preferred onto the node with mbind() and first touched by that thread, so
+ * generation and storage stay node-local. Consumers are routed to the pool
+ * of the node they are running on; any thread may consume.
+ */
+
+#define QRNG_NODE_POOL_CHUNK (64 << 10)        /**< Refill granularity */
+#define QRNG_NODE_POOL_MIN_BYTES (256 << 10)   /**< Smallest pool per node */
+
+typedef struct qrng_node_pools qrng_node_pools;
+
+/**
+ * @brief Counters for one node's pool
+ */
+typedef struct {
+    int node;                          /**< NUMA node id */
+    size_t capacity;                   /**< Pool size in bytes */
+    size_t fill;                       /**< Bytes ready to serve */
+    uint64_t refills;                  /**< Chunks generated */
+    uint64_t served;                   /**< Bytes handed to consumers */
+    uint64_t waits;                    /**< Times a consumer found the pool empty */
+    int bound;                         /**< Memory placed with mbind() */
+    int pinned;                        /**< Refill thread restricted to the node */
+} qrng_node_pool_stats;
+
+/**
+ * @brief Create and start one pool per online node
+ *
+ * Each node's context is split from root with qrng_split(), so it shares
+ * root's seed queue and copies its reseed schedule, conditioning ratio and
+ * entropy policy. root is only used during this call.
+ *
+ * @param root Context the node contexts are split from
+ * @param bytes_per_node Pool size, raised to at least QRNG_NODE_POOL_MIN_BYTES
+ *                       and rounded up to a whole chunk
+ * @return New pools, or NULL on failure
+ */
+qrng_node_pools *qrng_node_pools_create(qrng_ctx *root, size_t bytes_per_node);
+
+/**
+ * @brief Stop the refill threads and free the pools
+ *
+ * No consumer may be inside qrng_node_pools_bytes().
+ *
+ * @param p Pools
+ */
+void qrng_node_pools_destroy(qrng_node_pools *p);
+
+/**
+ * @brief Fill a buffer from the calling thread's node pool
+ *
+ * Waits for the refill thread when the pool runs dry.
+ *
+ * @param p Pools
+ * @param out Output buffer
+ * @param len Number of bytes
+ * @return QRNG_SUCCESS on success, error code on failure
+ */
+qrng_error qrng_node_pools_bytes(qrng_node_pools *p, uint8_t *out, size_t len);
+
+/**
+ * @brief Snapshot every node's counters
+ *
+ * @param p Pools
+ * @param stats[out] Receives up to max entries
+ * @param max Capacity of stats
+ * @return Number of entries written
+ */
+size_t qrng_node_pools_get_stats(qrng_node_pools *p, qrng_node_pool_stats *stats, size_t max);
+
+#endif /* QUANTUM_NODE_POOL_H */
@@ -0,0 +1,109 @@
+#ifndef _GNU_SOURCE
+#define _GNU_SOURCE   // sched_setaffinity, CPU_SET
+#endif
+#include "topology.h"
+#include <sched.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/syscall.h>
+
+#ifndef MPOL_PREFERRED
+#define MPOL_PREFERRED 1
+#endif
+
+#define NODE_SYSFS "/sys/devices/system/node"
+
+// Parse a sysfs list such as "0-3,8,10-11", calling fn for each member
+static int parse_list(const char *path, void (*fn)(void *, int), void *arg) {
+    FILE *f = fopen(path, "r");
+    if (!f) return -1;
+
+    char buf[4096];
+    size_t n = fread(buf, 1, sizeof(buf) - 1, f);
+    fclose(f);
+    buf[n] = '\0';
+
+    int found = 0;
+    char *p = buf;
+    while (*p && *p != '\n') {
+        char *end;
+        long lo = strtol(p, &end, 10);
+        if (end == p) break;
+        long hi = lo;
+        if (*end == '-') {
+            p = end + 1;
+            hi = strtol(p, &end, 10);
+        }
+        for (long v = lo; v <= hi; v++) {
+            fn(arg, (int)v);
+            found = 1;
+        }
+        p = *end == ',' ? end + 1 : end;
+    }
+    return found ? 0 : -1;
+}
+
+typedef struct {
+    int *nodes;
+    size_t max;
+    size_t count;
+} node_list;
+
+static void add_node(void *arg, int node) {
+    node_list *l = arg;
+    if (l->count < l->max && node >= 0 && node < QRNG_NUMA_MAX_NODES) {
+        l->nodes[l->count++] = node;
+    }
+}
+
+size_t qrng_numa_nodes(int *nodes, size_t max) {
+    if (!nodes || max == 0) return 0;
+
+    node_list l = { nodes, max, 0 };
+    if (parse_list(NODE_SYSFS "/online", add_node, &l) != 0 || l.count == 0) {
+        nodes[0] = 0;
+        return 1;
+    }
+    return l.count;
+}
+
+int qrng_numa_current_node(void) {
+#ifdef SYS_getcpu
+    unsigned cpu, node;
+    if (syscall(SYS_getcpu, &cpu, &node, NULL) == 0 && node < QRNG_NUMA_MAX_NODES) {
+        return (int)node;
+    }
+#endif
+    return 0;
+}
+
+static void add_cpu(void *arg, int cpu) {
+    if (cpu >= 0 && cpu < CPU_SETSIZE) CPU_SET(cpu, (cpu_set_t *)arg);
+}
+
+int qrng_numa_run_on_node(int node) {
+    if (node < 0 || node >= QRNG_NUMA_MAX_NODES) return -1;
+
+    char path[96];
+    snprintf(path, sizeof(path), NODE_SYSFS "/node%d/cpulist", node);
+
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    if (parse_list(path, add_cpu, &set) != 0) return -1;
+    return sched_setaffinity(0, sizeof(set), &set) == 0 ? 0 : -1;
+}
+
+int qrng_numa_bind(void *addr, size_t len, int node) {
+#ifdef SYS_mbind
+    if (!addr || len == 0 || node < 0 || node >= QRNG_NUMA_MAX_NODES) return -1;
+
+    unsigned long mask = 1UL << node;
+    return syscall(SYS_mbind, addr, len, MPOL_PREFERRED, &mask,
+                   (unsigned long)QRNG_NUMA_MAX_NODES + 1, 0) == 0 ? 0 : -1;
+#else
+    (void)addr; (void)len; (void)node;
+    return -1;
+#endif
+}
@@ -0,0 +1,52 @@
+#ifndef QUANTUM_TOPOLOGY_H
+#define QUANTUM_TOPOLOGY_H
+
+#include <stddef.h>
+
+/**
+ * @file topology.h
+ * @brief NUMA node discovery, placement and routing
+ *
+ * Reads the node layout from sysfs and talks to the kernel directly through
+ * mbind(2) and getcpu(2), so no libnuma is needed. Machines without NUMA
+ * information are reported as a single node 0 and every call degrades to a
+ * no-op.
+ */
+
+#define QRNG_NUMA_MAX_NODES 64         /**< Highest node id handled, exclusive */
+
+/**
+ * @brief Online NUMA nodes
+ *
+ * @param nodes[out] Receives up to max node ids in ascending order
+ * @param max Capacity of nodes
+ * @return Number of ids written, at least 1
+ */
+size_t qrng_numa_nodes(int *nodes, size_t max);
+
+/**
+ * @brief Node the calling thread is running on
+ *
+ * @return Node id, or 0 when unknown
+ */
+int qrng_numa_current_node(void);
+
+/**
+ * @brief Restrict the calling thread to a node's CPUs
+ *
+ * @param node Node id
+ * @return 0 on success, -1 if the node's CPU list is unavailable
+ */
+int qrng_numa_run_on_node(int node);
+
+/**
+ * @brief Prefer a node for pages of a range not yet touched
+ *
+ * @param addr Page-aligned start
+ * @param len Length in bytes
+ * @param node Node id
+ * @return 0 on success, -1 if the kernel refused or lacks NUMA support
+ */
+int qrng_numa_bind(void *addr, size_t len, int node);
+
+#endif /* QUANTUM_TOPOLOGY_H */
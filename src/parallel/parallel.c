@@ -0,0 +1,569 @@
+#define _GNU_SOURCE
+#include "parallel.h"
+#include "futex.h"
+#include <pthread.h>
+#include <sched.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#define QRNG_DEQUE_SIZE 1024        // Tasks per worker deque, a power of two
+
+// A unit of work. Tasks are embedded in larger structs and recovered from
+// the pointer, so run receives the task itself.
+typedef struct qrng_task {
+    void (*run)(struct qrng_task *task);
+    struct qrng_task *next;     // Mailbox and injection queue link
+} qrng_task;
+
+// Chase-Lev deque. The owner pushes and pops at bottom; thieves take from
+// top. Operations on top and bottom are sequentially consistent where the
+// algorithm needs a full fence, which keeps it checkable by TSan.
+typedef struct {
+    int64_t top __attribute__((aligned(64)));        // atomic
+    int64_t bottom __attribute__((aligned(64)));     // atomic
+    qrng_task *buf[QRNG_DEQUE_SIZE] __attribute__((aligned(64)));   // atomic slots
+} task_deque;
+
+typedef struct {
+    task_deque deque;
+    qrng_task *mailbox __attribute__((aligned(64))); // atomic, tasks only this worker runs
+    qrng_task *inbox;           // Mailbox tasks taken by the owner, in order
+    size_t index;
+    uint32_t victim;            // Steal rotation seed
+    uint64_t tasks;             // atomic
+    uint64_t steals;            // atomic
+    uint64_t sleeps;            // atomic
+} __attribute__((aligned(64))) pool_worker;
+
+static struct {
+    pthread_once_t once;
+    pool_worker *workers;
+    size_t nworkers;            // atomic, lowered if a thread fails to start
+    size_t threads;             // Loop parallelism, at most nworkers + 1
+    size_t cpu_limit;
+
+    pthread_mutex_t inject_lock;
+    qrng_task *inject_head;
+    qrng_task *inject_tail;
+    size_t inject_len;          // atomic, read without the lock
+    uint64_t injected;          // atomic
+
+    // Idle workers sleep on epoch; anyone adding work bumps it
+    uint32_t epoch __attribute__((aligned(64)));     // atomic, futex word
+    uint32_t sleepers;          // atomic
+} pool = {
+    .once = PTHREAD_ONCE_INIT,
+    .inject_lock = PTHREAD_MUTEX_INITIALIZER,
+};
+
+static __thread pool_worker *self;  // Worker running on this thread, if any
+
+static int deque_push(task_deque *d, qrng_task *t) {
+    int64_t b = __atomic_load_n(&d->bottom, __ATOMIC_RELAXED);
+    int64_t top = __atomic_load_n(&d->top, __ATOMIC_ACQUIRE);
+    if (b - top >= QRNG_DEQUE_SIZE) return -1;
+
+    __atomic_store_n(&d->buf[b & (QRNG_DEQUE_SIZE - 1)], t, __ATOMIC_RELAXED);
+    __atomic_store_n(&d->bottom, b + 1, __ATOMIC_SEQ_CST);
+    return 0;
+}
+
+static qrng_task *deque_pop(task_deque *d) {
+    int64_t b = __atomic_load_n(&d->bottom, __ATOMIC_RELAXED) - 1;
+    __atomic_store_n(&d->bottom, b, __ATOMIC_SEQ_CST);
+    int64_t t = __atomic_load_n(&d->top, __ATOMIC_SEQ_CST);
+
+    if (t > b) {
+        __atomic_store_n(&d->bottom, b + 1, __ATOMIC_RELAXED);
+        return NULL;
+    }
+    qrng_task *task = __atomic_load_n(&d->buf[b & (QRNG_DEQUE_SIZE - 1)], __ATOMIC_RELAXED);
+    if (t == b) {
+        // Last task: race thieves for it
+        if (!__atomic_compare_exchange_n(&d->top, &t, t + 1, 0,
+                                         __ATOMIC_SEQ_CST, __ATOMIC_RELAXED)) {
+            task = NULL;
+        }
+        __atomic_store_n(&d->bottom, b + 1, __ATOMIC_RELAXED);
+    }
+    return task;
+}
+
+static qrng_task *deque_steal(task_deque *d) {
+    int64_t t = __atomic_load_n(&d->top, __ATOMIC_SEQ_CST);
+    int64_t b = __atomic_load_n(&d->bottom, __ATOMIC_SEQ_CST);
+    if (t >= b) return NULL;
+
+    qrng_task *task = __atomic_load_n(&d->buf[t & (QRNG_DEQUE_SIZE - 1)], __ATOMIC_RELAXED);
+    if (!__atomic_compare_exchange_n(&d->top, &t, t + 1, 0,
+                                     __ATOMIC_SEQ_CST, __ATOMIC_RELAXED)) {
+        return NULL;
+    }
+    return task;
+}
+
+static int deque_empty(task_deque *d) {
+    return __atomic_load_n(&d->top, __ATOMIC_SEQ_CST) >=
+           __atomic_load_n(&d->bottom, __ATOMIC_SEQ_CST);
+}
+
+// Wake idle workers if any are asleep. The read of sleepers is a
+// read-modify-write so it is ordered after the caller published its task,
+// pairing with the increment in worker_idle().
+static void notify(void) {
+    if (__atomic_fetch_add(&pool.sleepers, 0, __ATOMIC_SEQ_CST)) {
+        __atomic_fetch_add(&pool.epoch, 1, __ATOMIC_SEQ_CST);
+        qrng_futex_wake(&pool.epoch, 0);
+    }
+}
+
+static void inject(qrng_task *t) {
+    t->next = NULL;
+    pthread_mutex_lock(&pool.inject_lock);
+    if (pool.inject_tail) {
+        pool.inject_tail->next = t;
+    } else {
+        pool.inject_head = t;
+    }
+    pool.inject_tail = t;
+    __atomic_fetch_add(&pool.inject_len, 1, __ATOMIC_SEQ_CST);
+    pthread_mutex_unlock(&pool.inject_lock);
+    __atomic_fetch_add(&pool.injected, 1, __ATOMIC_RELAXED);
+}
+
+static qrng_task *inject_pop(void) {
+    if (!__atomic_load_n(&pool.inject_len, __ATOMIC_SEQ_CST)) return NULL;
+
+    pthread_mutex_lock(&pool.inject_lock);
+    qrng_task *t = pool.inject_head;
+    if (t) {
+        pool.inject_head = t->next;
+        if (!pool.inject_head) pool.inject_tail = NULL;
+        __atomic_fetch_sub(&pool.inject_len, 1, __ATOMIC_RELAXED);
+    }
+    pthread_mutex_unlock(&pool.inject_lock);
+    return t;
+}
+
+// Queue a task on the calling worker's deque, or hand it in from outside
+static void spawn(qrng_task *t) {
+    if (!self || deque_push(&self->deque, t) != 0) inject(t);
+}
+
+// Post a task that only worker w may run
+static void post(pool_worker *w, qrng_task *t) {
+    qrng_task *head = __atomic_load_n(&w->mailbox, __ATOMIC_RELAXED);
+    do {
+        t->next = head;
+    } while (!__atomic_compare_exchange_n(&w->mailbox, &head, t, 1,
+                                          __ATOMIC_SEQ_CST, __ATOMIC_RELAXED));
+}
+
+static qrng_task *find_task(pool_worker *w) {
+    // Posted tasks first: they cannot go anywhere else
+    if (!w->inbox && __atomic_load_n(&w->mailbox, __ATOMIC_RELAXED)) {
+        qrng_task *list = __atomic_exchange_n(&w->mailbox, NULL, __ATOMIC_ACQUIRE);
+        while (list) {
+            qrng_task *next = list->next;
+            list->next = w->inbox;
+            w->inbox = list;
+            list = next;
+        }
+    }
+    if (w->inbox) {
+        qrng_task *t = w->inbox;
+        w->inbox = t->next;
+        return t;
+    }
+
+    qrng_task *t = deque_pop(&w->deque);
+    if (t) return t;
+
+    // Steal, starting from a rotating victim so thieves spread out
+    size_t n = __atomic_load_n(&pool.nworkers, __ATOMIC_RELAXED);
+    w->victim = w->victim * 1103515245u + 12345u;
+    for (size_t k = 0; k < n; k++) {
+        pool_worker *v = &pool.workers[(w->victim + k) % n];
+        if (v == w) continue;
+        t = deque_steal(&v->deque);
+        if (t) {
+            __atomic_fetch_add(&w->steals, 1, __ATOMIC_RELAXED);
+            return t;
+        }
+    }
+    return inject_pop();
+}
+
+static int has_work(pool_worker *w) {
+    if (w->inbox || __atomic_load_n(&w->mailbox, __ATOMIC_SEQ_CST)) return 1;
+    if (__atomic_load_n(&pool.inject_len, __ATOMIC_SEQ_CST)) return 1;
+    size_t n = __atomic_load_n(&pool.nworkers, __ATOMIC_RELAXED);
+    for (size_t i = 0; i < n; i++) {
+        if (!deque_empty(&pool.workers[i].deque)) return 1;
+    }
+    return 0;
+}
+
+static void run_task(pool_worker *w, qrng_task *t) {
+    t->run(t);
+    __atomic_fetch_add(&w->tasks, 1, __ATOMIC_RELAXED);
+}
+
+static void worker_idle(pool_worker *w) {
+    __atomic_fetch_add(&pool.sleepers, 1, __ATOMIC_SEQ_CST);
+    uint32_t seen = __atomic_load_n(&pool.epoch, __ATOMIC_SEQ_CST);
+    if (!has_work(w)) {
+        __atomic_fetch_add(&w->sleeps, 1, __ATOMIC_RELAXED);
+        qrng_futex_wait(&pool.epoch, seen, 0);
+    }
+    __atomic_fetch_sub(&pool.sleepers, 1, __ATOMIC_RELAXED);
+}
+
+static void *worker_main(void *arg) {
+    pool_worker *w = arg;
+    self = w;
+
+    for (;;) {
+        qrng_task *t = find_task(w);
+        if (t) {
+            run_task(w, t);
+        } else {
+            worker_idle(w);
+        }
+    }
+    return NULL;
+}
+
+// Read a cgroup file of the calling process; v2 files sit in the unified
+// hierarchy, v1 ones under the named controller
+static FILE *open_cgroup_file(const char *controller, const char *file) {
+    char line[512], path[1024];
+    FILE *f = fopen("/proc/self/cgroup", "r");
+    if (f) {
+        while (fgets(line, sizeof(line), f)) {
+            char *rel = strchr(line, ':');
+            if (!rel) continue;
+            char *ctl = rel + 1;
+            rel = strchr(ctl, ':');
+            if (!rel) continue;
+            *rel++ = '\0';
+            rel[strcspn(rel, "\n")] = '\0';
+
+            int match = controller ? strstr(ctl, controller) != NULL : ctl[0] == '\0';
+            if (!match) continue;
+            snprintf(path, sizeof(path), "/sys/fs/cgroup%s%s%s/%s",
+                     controller ? "/" : "", controller ? controller : "", rel, file);
+            FILE *cf = fopen(path, "r");
+            if (cf) {
+                fclose(f);
+                return cf;
+            }
+        }
+        fclose(f);
+    }
+
+    // Namespaced containers see their own cgroup at the root
+    snprintf(path, sizeof(path), "/sys/fs/cgroup%s%s/%s",
+             controller ? "/" : "", controller ? controller : "", file);
+    return fopen(path, "r");
+}
+
+// CPUs allowed by the CFS quota, rounded up; 0 when unlimited
+static size_t cgroup_cpu_limit(void) {
+    long long quota = -1, period = 0;
+    char max[32];
+
+    FILE *f = open_cgroup_file(NULL, "cpu.max");
+    if (f) {
+        if (fscanf(f, "%31s %lld", max, &period) == 2 && strcmp(max, "max") != 0) {
+            quota = atoll(max);
+        }
+        fclose(f);
+    } else {
+        f = open_cgroup_file("cpu", "cpu.cfs_quota_us");
+        if (f) {
+            if (fscanf(f, "%lld", &quota) != 1) quota = -1;
+            fclose(f);
+        }
+        f = open_cgroup_file("cpu", "cpu.cfs_period_us");
+        if (f) {
+            if (fscanf(f, "%lld", &period) != 1) period = 0;
+            fclose(f);
+        }
+    }
+
+    if (quota <= 0 || period <= 0) return 0;
+    return (size_t)((quota + period - 1) / period);
+}
+
+static size_t pool_size(void) {
+    const char *env = getenv("QRNG_THREADS");
+    if (env && atoi(env) > 0) {
+        size_t n = (size_t)atoi(env);
+        return n > QRNG_POOL_MAX_WORKERS + 1 ? QRNG_POOL_MAX_WORKERS + 1 : n;
+    }
+
+    cpu_set_t set;
+    size_t cpus = 0;
+    if (sched_getaffinity(0, sizeof(set), &set) == 0) cpus = (size_t)CPU_COUNT(&set);
+    if (cpus == 0) {
+        long online = sysconf(_SC_NPROCESSORS_ONLN);
+        cpus = online > 0 ? (size_t)online : 1;
+    }
+    if (pool.cpu_limit && pool.cpu_limit < cpus) cpus = pool.cpu_limit;
+    return cpus > QRNG_POOL_MAX_WORKERS + 1 ? QRNG_POOL_MAX_WORKERS + 1 : cpus;
+}
+
+static void pool_start(void) {
+    pool.cpu_limit = cgroup_cpu_limit();
+    pool.threads = pool_size();
+
+    // One worker even on a single CPU, so submitted tasks leave the caller
+    size_t want = pool.threads > 1 ? pool.threads - 1 : 1;
+    pool.workers = aligned_alloc(64, want * sizeof(pool_worker));
+    if (!pool.workers) {
+        pool.threads = 1;
+        return;
+    }
+    memset(pool.workers, 0, want * sizeof(pool_worker));
+    for (size_t i = 0; i < want; i++) {
+        pool.workers[i].index = i;
+        pool.workers[i].victim = (uint32_t)i;
+    }
+
+    pthread_attr_t attr;
+    pthread_attr_init(&attr);
+    pthread_attr_setdetachstate(&attr, PTHREAD_CREATE_DETACHED);
+
+    // Workers steal from pool.workers[0, nworkers), so the count is
+    // published before any of them starts and only ever shrinks
+    pool.nworkers = want;
+    size_t started = 0;
+    for (; started < want; started++) {
+        pthread_t tid;
+        if (pthread_create(&tid, &attr, worker_main, &pool.workers[started]) != 0) break;
+    }
+    pthread_attr_destroy(&attr);
+
+    if (started < want) {
+        __atomic_store_n(&pool.nworkers, started, __ATOMIC_RELAXED);
+        if (pool.threads > started + 1) pool.threads = started + 1;
+    }
+}
+
+size_t qrng_parallel_threads(void) {
+    pthread_once(&pool.once, pool_start);
+    return pool.threads;
+}
+
+// One parallel loop in flight. Heap allocated and reference counted, since
+// helper tasks may still sit in a deque after every chunk is done.
+typedef struct loop_job loop_job;
+
+typedef struct {
+    qrng_task task;             // First, so the task pointer is the helper
+    loop_job *job;
+    size_t participant;
+} loop_helper;
+
+struct loop_job {
+    qrng_range_fn fn;
+    void *arg;
+    size_t n;
+    size_t grain;
+    size_t chunks;
+    int fixed;                  // One slice per participant instead of claiming
+    size_t next;                // Next chunk to claim (atomic)
+    size_t remaining;           // Chunks not yet completed (atomic)
+    uint32_t finished;          // Set with the last chunk (atomic, futex word)
+    uint32_t refs;              // Submitter plus unfinished helpers (atomic)
+    size_t nhelpers;
+    loop_helper helpers[];
+};
+
+static void job_release(loop_job *job) {
+    if (__atomic_fetch_sub(&job->refs, 1, __ATOMIC_ACQ_REL) == 1) free(job);
+}
+
+static void job_complete(loop_job *job, size_t chunks) {
+    if (__atomic_fetch_sub(&job->remaining, chunks, __ATOMIC_ACQ_REL) == chunks) {
+        __atomic_store_n(&job->finished, 1, __ATOMIC_RELEASE);
+        qrng_futex_wake(&job->finished, 0);
+    }
+}
+
+// Claim and run chunks until none are left. In a fixed job participant p
+// (the submitter is 0, worker i is i + 1) runs only slice p.
+static void run_chunks(loop_job *job, size_t participant) {
+    if (job->fixed) {
+        size_t begin = job->n * participant / job->chunks;
+        size_t end = job->n * (participant + 1) / job->chunks;
+        if (begin < end) job->fn(job->arg, begin, end);
+        job_complete(job, 1);
+        return;
+    }
+
+    for (;;) {
+        size_t c = __atomic_fetch_add(&job->next, 1, __ATOMIC_RELAXED);
+        if (c >= job->chunks) break;
+
+        size_t begin = c * job->grain;
+        size_t end = begin + job->grain;
+        if (end > job->n) end = job->n;
+        job->fn(job->arg, begin, end);
+
+        job_complete(job, 1);
+    }
+}
+
+static void run_helper(qrng_task *task) {
+    loop_helper *h = (loop_helper *)task;
+    run_chunks(h->job, h->participant);
+    job_release(h->job);
+}
+
+// Hand out the helpers, take part as participant 0 and wait for the last
+// chunk. A worker keeps running other tasks while it waits.
+static void submit(loop_job *job) {
+    for (size_t i = 0; i < job->nhelpers; i++) {
+        loop_helper *h = &job->helpers[i];
+        h->task.run = run_helper;
+        h->job = job;
+        h->participant = i + 1;
+        if (job->fixed) {
+            post(&pool.workers[i], &h->task);
+        } else {
+            spawn(&h->task);
+        }
+    }
+    notify();
+
+    run_chunks(job, 0);
+
+    while (!__atomic_load_n(&job->finished, __ATOMIC_ACQUIRE)) {
+        if (self) {
+            qrng_task *t = find_task(self);
+            if (t) {
+                run_task(self, t);
+                continue;
+            }
+        }
+        qrng_futex_wait(&job->finished, 0, 0);
+    }
+    job_release(job);
+}
+
+static loop_job *job_create(size_t nhelpers) {
+    loop_job *job = malloc(sizeof(loop_job) + nhelpers * sizeof(loop_helper));
+    if (!job) return NULL;
+    memset(job, 0, sizeof(*job));
+    job->nhelpers = nhelpers;
+    job->refs = (uint32_t)nhelpers + 1;
+    return job;
+}
+
+void qrng_parallel_for(size_t n, size_t grain, size_t max_threads,
+                       qrng_range_fn fn, void *arg) {
+    if (n == 0 || !fn) return;
+
+    size_t threads = qrng_parallel_threads();
+    if (max_threads == 0 || max_threads > threads) max_threads = threads;
+    if (grain == 0) grain = (n + max_threads - 1) / max_threads;
+
+    // Single-threaded loops, and allocation failure, run inline
+    size_t chunks = (n + grain - 1) / grain;
+    size_t helpers = max_threads - 1;
+    if (helpers > chunks - 1) helpers = chunks - 1;
+    loop_job *job = helpers ? job_create(helpers) : NULL;
+    if (!job) {
+        fn(arg, 0, n);
+        return;
+    }
+
+    job->fn = fn;
+    job->arg = arg;
+    job->n = n;
+    job->grain = grain;
+    job->chunks = chunks;
+    job->remaining = chunks;
+    submit(job);
+}
+
+void qrng_parallel_for_static(size_t n, size_t max_threads,
+                              qrng_range_fn fn, void *arg) {
+    if (n == 0 || !fn) return;
+
+    size_t threads = qrng_parallel_threads();
+    if (max_threads == 0 || max_threads > threads) max_threads = threads;
+    if (max_threads > n) max_threads = n;
+
+    // A worker waiting on a slice posted to a busy worker could stall it,
+    // so nested static loops run inline
+    loop_job *job = self || max_threads == 1 ? NULL : job_create(max_threads - 1);
+    if (!job) {
+        fn(arg, 0, n);
+        return;
+    }
+
+    // Every participant up to max_threads must run its slice, so the
+    // submitter waits for all of them
+    job->fn = fn;
+    job->arg = arg;
+    job->n = n;
+    job->chunks = max_threads;
+    job->remaining = max_threads;
+    job->fixed = 1;
+    submit(job);
+}
+
+typedef struct {
+    qrng_task task;
+    void (*fn)(void *arg);
+    void *arg;
+} pool_call;
+
+static void run_call(qrng_task *task) {
+    pool_call *call = (pool_call *)task;
+    call->fn(call->arg);
+    free(call);
+}
+
+int qrng_pool_submit(void (*fn)(void *arg), void *arg) {
+    if (!fn) return -1;
+
+    // No worker could be started
+    qrng_parallel_threads();
+    if (pool.nworkers == 0) {
+        fn(arg);
+        return 0;
+    }
+
+    pool_call *call = malloc(sizeof(*call));
+    if (!call) return -1;
+    call->task.run = run_call;
+    call->fn = fn;
+    call->arg = arg;
+    spawn(&call->task);
+    notify();
+    return 0;
+}
+
+void qrng_pool_get_stats(qrng_pool_stats *stats) {
+    if (!stats) return;
+    qrng_parallel_threads();
+
+    memset(stats, 0, sizeof(*stats));
+    stats->workers = pool.nworkers;
+    stats->threads = pool.threads;
+    stats->cpu_limit = pool.cpu_limit;
+    stats->injected = __atomic_load_n(&pool.injected, __ATOMIC_RELAXED);
+    for (size_t i = 0; i < pool.nworkers; i++) {
+        pool_worker *w = &pool.workers[i];
+        stats->tasks += __atomic_load_n(&w->tasks, __ATOMIC_RELAXED);
+        stats->steals += __atomic_load_n(&w->steals, __ATOMIC_RELAXED);
+        stats->sleeps += __atomic_load_n(&w->sleeps, __ATOMIC_RELAXED);
+    }
+}
@@ -0,0 +1,118 @@
+#ifndef QUANTUM_PARALLEL_H
+#define QUANTUM_PARALLEL_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * @file parallel.h
+ * @brief Shared work-stealing thread pool for bulk operations
+ *
+ * Large buffer operations split their index space into chunks and run them
+ * on a process-wide pool of worker threads. The calling thread takes part in
+ * the work, so a pool of N workers gives N+1 way parallelism.
+ *
+ * Every worker owns a Chase-Lev deque: it pushes and pops tasks at the
+ * bottom, and idle workers steal from the top of others' deques. Threads
+ * outside the pool hand tasks in through a shared injection queue. Loops
+ * started on a worker therefore spread over the pool instead of running
+ * serially, and independent tasks from qrng_pool_submit() balance across
+ * cores. Idle workers sleep on a futex.
+ *
+ * Loops use one thread per CPU the process may use: the affinity mask,
+ * capped by the cgroup CPU quota (v2 cpu.max or v1 cfs_quota_us). The pool
+ * holds that many workers minus the calling thread, but at least one, so
+ * submitted tasks always leave the caller. QRNG_THREADS in the environment
+ * overrides the CPU count.
+ */
+
+#define QRNG_POOL_MAX_WORKERS 255   /**< Most worker threads */
+
+/**
+ * @brief Pool counters
+ */
+typedef struct {
+    size_t workers;            /**< Worker threads */
+    size_t threads;            /**< Threads a parallel loop may use */
+    size_t cpu_limit;          /**< CPUs allowed by the cgroup quota, 0 if unlimited */
+    uint64_t tasks;            /**< Tasks run by workers */
+    uint64_t steals;           /**< Tasks taken from another worker's deque */
+    uint64_t injected;         /**< Tasks handed in from outside the pool */
+    uint64_t sleeps;           /**< Times a worker went idle */
+} qrng_pool_stats;
+
+/**
+ * @brief Range body executed by the pool
+ *
+ * @param arg Caller-supplied argument
+ * @param begin First index of the chunk (inclusive)
+ * @param end Last index of the chunk (exclusive)
+ */
+typedef void (*qrng_range_fn)(void *arg, size_t begin, size_t end);
+
+/**
+ * @brief Number of threads that can take part in a parallel loop
+ *
+ * Starts the pool on first use.
+ *
+ * @return Usable CPUs, at most the pool workers plus the calling thread
+ */
+size_t qrng_parallel_threads(void);
+
+/**
+ * @brief Run fn over [0,n) in chunks of at most grain indices
+ *
+ * Blocks until every chunk has completed. Up to max_threads - 1 helper
+ * tasks join the caller in claiming chunks; called on a pool worker, the
+ * helpers go to its own deque for others to steal, and the worker runs
+ * other tasks while it waits.
+ *
+ * @param n Size of the index space
+ * @param grain Maximum chunk size (0 picks one chunk per thread)
+ * @param max_threads Upper bound on participating threads (0 for all)
+ * @param fn Range body
+ * @param arg Argument passed to fn
+ */
+void qrng_parallel_for(size_t n, size_t grain, size_t max_threads,
+                       qrng_range_fn fn, void *arg);
+
+/**
+ * @brief Run fn over [0,n) split into one fixed slice per thread
+ *
+ * Participant p of T always receives [p*n/T, (p+1)*n/T), with the calling
+ * thread as participant 0. Repeating a loop with the same n and thread
+ * count therefore hands every slice to the same thread, so memory first
+ * touched by a thread in one loop stays local to it in the next. Slices
+ * are posted to their workers directly and are never stolen. Calls made
+ * from inside a pool worker run serially on that worker.
+ *
+ * @param n Size of the index space
+ * @param max_threads Upper bound on participating threads (0 for all)
+ * @param fn Range body
+ * @param arg Argument passed to fn
+ */
+void qrng_parallel_for_static(size_t n, size_t max_threads,
+                              qrng_range_fn fn, void *arg);
+
+/**
+ * @brief Run fn(arg) on a pool worker
+ *
+ * Returns once the task is queued. From a worker the task goes to its own
+ * deque; from any other thread, to the injection queue.
+ *
+ * @param fn Task body
+ * @param arg Argument passed to fn
+ * @return 0 on success, -1 if the task could not be allocated
+ */
+int qrng_pool_submit(void (*fn)(void *arg), void *arg);
+
+/**
+ * @brief Snapshot the pool counters
+ *
+ * Starts the pool on first use.
+ *
+ * @param stats[out] Receives the counters
+ */
+void qrng_pool_get_stats(qrng_pool_stats *stats);
+
+#endif /* QUANTUM_PARALLEL_H */
@@ -0,0 +1,436 @@
+#include "producer.h"
+#include "region.h"
+#include "futex.h"
+#include "parallel.h"
+#include <math.h>
+#include <pthread.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#define QRNG_PRODUCER_CHUNK (64 << 10)  // Generated between stop checks
+#define QRNG_PRODUCER_SLICE (256 << 10) // Per refill thread, one parallel slice
+#define QRNG_PRODUCER_EWMA_MS 1000      // Time constant of the demand average
+#define QRNG_PRODUCER_TICK_MS 250       // Control period while both halves are full
+#define QRNG_PRODUCER_HEADROOM 1.25     // Fill capacity kept above demand
+
+// Half states, also the futex words the producer sleeps on
+enum {
+    HALF_EMPTY = 0,                     // Producer owns it
+    HALF_FULL = 1,                      // Ready for the consumer
+    HALF_STOP = 2,                      // Shutting down
+    HALF_HELD = 3                       // Being read by the consumer
+};
+
+struct qrng_producer {
+    qrng_ctx *ctx;                      // Used only by the producer thread
+    qrng_region mem[2];
+    uint8_t *half[2];                   // Published with the FULL state
+    size_t half_bytes[2];               // atomic, published with the FULL state
+    pthread_t thread;
+
+    uint32_t state[2] __attribute__((aligned(64)));     // atomic
+    uint64_t refills;                   // atomic
+    uint64_t refill_ns;                 // atomic
+    uint32_t failures;                  // atomic
+
+    // Demand controller, run by the producer thread. Without a budget the
+    // pool keeps its initial size and one refill thread.
+    struct {
+        int adaptive;
+        size_t max_half;                // Memory budget, per half
+        size_t max_threads;             // CPU budget
+        uint32_t target_ms;
+        uint64_t last_ns;
+        uint64_t last_requested;
+        double demand;                  // Bytes/s requested, EWMA
+        double fill;                    // Bytes/s filled per thread, EWMA
+        size_t want_half;               // Half size decided at the last step
+        size_t threads;                 // Refill threads decided at the last step
+
+        // Published for get_stats
+        uint64_t demand_bps;            // atomic
+        uint64_t fill_bps;              // atomic
+        uint64_t target;                // atomic, both halves
+        uint64_t active_threads;        // atomic
+        uint64_t grows;                 // atomic
+        uint64_t shrinks;               // atomic
+        uint64_t thread_raises;         // atomic
+        uint64_t thread_cuts;           // atomic
+        uint64_t clipped;               // atomic
+        uint64_t reclaims;              // atomic
+    } ctl;
+
+    // Consumer side, written only by the consumer
+    struct {
+        int front;                      // Half read next
+        int holding;                    // front is HELD and being read
+        size_t pos;                     // Read offset within front
+        uint64_t requested;             // atomic, bytes asked for
+        uint64_t served;                // atomic
+        uint64_t swaps;                 // atomic
+        uint64_t underflows;            // atomic
+        uint64_t level;                 // atomic, bytes ready after the last read
+        uint64_t low_water;             // atomic, reset by get_stats
+        uint64_t high_water;            // atomic, reset by get_stats
+    } c __attribute__((aligned(64)));
+};
+
+static uint64_t now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+static size_t half_for_pool(size_t pool_bytes) {
+    if (pool_bytes < QRNG_PRODUCER_MIN_BYTES) pool_bytes = QRNG_PRODUCER_MIN_BYTES;
+    if (pool_bytes > QRNG_PRODUCER_MAX_BYTES) pool_bytes = QRNG_PRODUCER_MAX_BYTES;
+    return (pool_bytes / 2 + 63) & ~(size_t)63;
+}
+
+// One control step: fold the demand since the previous step into its
+// average, then size each half to hold target_ms of it and pick enough
+// refill threads to keep up, both clipped to the budget
+static void control(qrng_producer *p) {
+    uint64_t now = now_ns();
+    uint64_t requested = __atomic_load_n(&p->c.requested, __ATOMIC_RELAXED);
+    double dt = (double)(now - p->ctl.last_ns) / 1e9;
+    if (dt <= 0.0) return;
+
+    double rate = (double)(requested - p->ctl.last_requested) / dt;
+    double alpha = 1.0 - exp(-dt * 1000.0 / QRNG_PRODUCER_EWMA_MS);
+    p->ctl.demand += alpha * (rate - p->ctl.demand);
+    p->ctl.last_ns = now;
+    p->ctl.last_requested = requested;
+
+    int clipped = 0;
+    double want = p->ctl.demand * p->ctl.target_ms / 1000.0;
+    size_t half = QRNG_PRODUCER_MIN_BYTES / 2;
+    if (want > (double)p->ctl.max_half) {
+        half = p->ctl.max_half;
+        clipped = 1;
+    } else if (want > (double)half) {
+        half = ((size_t)want + QRNG_PRODUCER_CHUNK - 1) & ~(size_t)(QRNG_PRODUCER_CHUNK - 1);
+        if (half > p->ctl.max_half) half = p->ctl.max_half;
+    }
+
+    size_t threads = 1;
+    if (p->ctl.fill > 0.0) {
+        double need = ceil(p->ctl.demand * QRNG_PRODUCER_HEADROOM / p->ctl.fill);
+        if (need > (double)p->ctl.max_threads) {
+            threads = p->ctl.max_threads;
+            clipped = 1;
+        } else if (need > 1.0) {
+            threads = (size_t)need;
+        }
+    }
+
+    if (threads > p->ctl.threads) __atomic_fetch_add(&p->ctl.thread_raises, 1, __ATOMIC_RELAXED);
+    if (threads < p->ctl.threads) __atomic_fetch_add(&p->ctl.thread_cuts, 1, __ATOMIC_RELAXED);
+    if (clipped) __atomic_fetch_add(&p->ctl.clipped, 1, __ATOMIC_RELAXED);
+    p->ctl.want_half = half;
+    p->ctl.threads = threads;
+
+    __atomic_store_n(&p->ctl.demand_bps, (uint64_t)p->ctl.demand, __ATOMIC_RELAXED);
+    __atomic_store_n(&p->ctl.target, (uint64_t)(2 * half), __ATOMIC_RELAXED);
+    __atomic_store_n(&p->ctl.active_threads, (uint64_t)threads, __ATOMIC_RELAXED);
+}
+
+// Reallocate an empty half to the decided size. Shrinking waits until the
+// target falls to half the current size, so a steady demand near a chunk
+// boundary does not reallocate on every refill.
+static void resize_half(qrng_producer *p, int h) {
+    size_t cur = p->half_bytes[h];
+    size_t want = p->ctl.want_half;
+    if (want == cur || (want < cur && want * 2 > cur)) return;
+
+    qrng_region fresh;
+    if (qrng_region_alloc(&fresh, want, 0) != 0) return;
+    memset(p->half[h], 0, cur);
+    qrng_region_free(&p->mem[h]);
+
+    p->mem[h] = fresh;
+    p->half[h] = fresh.base;
+    __atomic_store_n(&p->half_bytes[h], want, __ATOMIC_RELAXED);
+    __atomic_fetch_add(want > cur ? &p->ctl.grows : &p->ctl.shrinks, 1, __ATOMIC_RELAXED);
+}
+
+// Fill one half, giving up early if shutdown starts
+static int fill_half(qrng_producer *p, int h, size_t threads) {
+    uint8_t *dst = p->half[h];
+    size_t len = p->half_bytes[h];
+    size_t chunk = threads > 1 ? threads * QRNG_PRODUCER_SLICE : QRNG_PRODUCER_CHUNK;
+
+    for (size_t off = 0; off < len; off += chunk) {
+        if (__atomic_load_n(&p->state[h], __ATOMIC_RELAXED) == HALF_STOP) return -1;
+
+        size_t n = len - off;
+        if (n > chunk) n = chunk;
+        qrng_error err = threads > 1
+            ? qrng_bytes_parallel(p->ctx, dst + off, n, threads)
+            : qrng_bytes(p->ctx, dst + off, n);
+        if (err != QRNG_SUCCESS) {
+            __atomic_fetch_add(&p->failures, 1, __ATOMIC_RELAXED);
+            return 1;
+        }
+    }
+    return 0;
+}
+
+// Demand has fallen well below the pool while it sat full: drop a full
+// half the consumer has not taken, preferring the one due for refill, so
+// it is refilled at the smaller size. Returns the half to fill, or -1.
+static int reclaim_half(qrng_producer *p, int h) {
+    for (int k = 0; k < 2; k++, h ^= 1) {
+        if (p->ctl.want_half * 2 > p->half_bytes[h]) continue;
+
+        uint32_t expected = HALF_FULL;
+        if (__atomic_compare_exchange_n(&p->state[h], &expected, HALF_EMPTY, 0,
+                                        __ATOMIC_ACQUIRE, __ATOMIC_RELAXED)) {
+            __atomic_fetch_add(&p->ctl.reclaims, 1, __ATOMIC_RELAXED);
+            return h;
+        }
+    }
+    return -1;
+}
+
+static void *producer_thread(void *arg) {
+    qrng_producer *p = arg;
+    int h = 0;
+
+    for (;;) {
+        uint32_t s = __atomic_load_n(&p->state[h], __ATOMIC_ACQUIRE);
+        if (s == HALF_STOP) break;
+        if (s != HALF_EMPTY) {
+            if (!p->ctl.adaptive) {
+                qrng_futex_wait(&p->state[h], s, 0);
+                continue;
+            }
+            // Keep the averages moving while idle so the pool can shrink
+            if (qrng_futex_wait_ms(&p->state[h], s, 0, QRNG_PRODUCER_TICK_MS) == 0) continue;
+            control(p);
+            int r = reclaim_half(p, h);
+            if (r < 0) continue;
+            h = r;
+        }
+
+        size_t threads = 1;
+        if (p->ctl.adaptive) {
+            control(p);
+            resize_half(p, h);
+            threads = p->ctl.threads;
+        }
+
+        uint64_t t0 = now_ns();
+        int r = fill_half(p, h, threads);
+        if (r < 0) break;
+        if (r > 0) {
+            // Generation refused, e.g. by a failing health test; back off
+            struct timespec pause = { 0, 10 * 1000 * 1000 };
+            nanosleep(&pause, NULL);
+            continue;
+        }
+        uint64_t elapsed = now_ns() - t0;
+
+        // Loses to a concurrent shutdown, which has already marked STOP
+        uint32_t expected = HALF_EMPTY;
+        if (!__atomic_compare_exchange_n(&p->state[h], &expected, HALF_FULL, 0,
+                                         __ATOMIC_RELEASE, __ATOMIC_RELAXED)) {
+            break;
+        }
+        __atomic_fetch_add(&p->refills, 1, __ATOMIC_RELAXED);
+        __atomic_fetch_add(&p->refill_ns, elapsed, __ATOMIC_RELAXED);
+
+        if (p->ctl.adaptive && elapsed > 0) {
+            double per_thread = (double)p->half_bytes[h] * 1e9 / (double)elapsed / (double)threads;
+            p->ctl.fill = p->ctl.fill > 0.0 ? p->ctl.fill + 0.25 * (per_thread - p->ctl.fill)
+                                            : per_thread;
+            __atomic_store_n(&p->ctl.fill_bps, (uint64_t)p->ctl.fill, __ATOMIC_RELAXED);
+        }
+        h ^= 1;
+    }
+    return NULL;
+}
+
+qrng_producer *qrng_producer_create(qrng_ctx *seed_from, size_t pool_bytes,
+                                    const qrng_refill_budget *budget) {
+    if (!seed_from) return NULL;
+
+    qrng_producer *p = aligned_alloc(64, sizeof(qrng_producer));
+    if (!p) return NULL;
+    memset(p, 0, sizeof(*p));
+
+    size_t half = half_for_pool(pool_bytes);
+    if (budget) {
+        size_t cpus = qrng_parallel_threads();
+        p->ctl.adaptive = 1;
+        p->ctl.max_half = half_for_pool(budget->max_bytes);
+        p->ctl.max_threads = budget->max_threads && budget->max_threads < cpus
+            ? budget->max_threads : cpus;
+        p->ctl.target_ms = budget->target_ms ? budget->target_ms : QRNG_REFILL_TARGET_MS;
+        p->ctl.last_ns = now_ns();
+        p->ctl.threads = 1;
+        if (half > p->ctl.max_half) half = p->ctl.max_half;
+        p->ctl.want_half = half;
+        p->ctl.target = 2 * half;
+        p->ctl.active_threads = 1;
+    }
+
+    uint8_t seed[32];
+    qrng_error err = qrng_bytes(seed_from, seed, sizeof(seed));
+    if (err == QRNG_SUCCESS) err = qrng_init_fast(&p->ctx, seed, sizeof(seed));
+    memset(seed, 0, sizeof(seed));
+    if (err != QRNG_SUCCESS || qrng_region_alloc(&p->mem[0], half, 0) != 0) {
+        qrng_free(p->ctx);
+        free(p);
+        return NULL;
+    }
+    if (qrng_region_alloc(&p->mem[1], half, 0) != 0) {
+        qrng_region_free(&p->mem[0]);
+        qrng_free(p->ctx);
+        free(p);
+        return NULL;
+    }
+    for (int h = 0; h < 2; h++) {
+        p->half[h] = p->mem[h].base;
+        p->half_bytes[h] = half;
+    }
+
+    // Same entropy feed and schedule as the context it serves
+    qrng_attach_seed_queue(p->ctx, seed_from->seed_queue);
+    qrng_set_reseed_schedule(p->ctx, seed_from->reseed_every_bytes, seed_from->reseed_every_ms);
+    if (seed_from->conditioning_ratio > 1) {
+        qrng_set_conditioning(p->ctx, seed_from->conditioning_ratio);
+    }
+
+    p->c.low_water = UINT64_MAX;
+    if (pthread_create(&p->thread, NULL, producer_thread, p) != 0) {
+        qrng_region_free(&p->mem[0]);
+        qrng_region_free(&p->mem[1]);
+        qrng_free(p->ctx);
+        free(p);
+        return NULL;
+    }
+    return p;
+}
+
+void qrng_producer_destroy(qrng_producer *p) {
+    if (!p) return;
+
+    for (int h = 0; h < 2; h++) {
+        __atomic_store_n(&p->state[h], HALF_STOP, __ATOMIC_RELEASE);
+        qrng_futex_wake(&p->state[h], 0);
+    }
+    pthread_join(p->thread, NULL);
+
+    qrng_region_free(&p->mem[0]);
+    qrng_region_free(&p->mem[1]);
+    qrng_free(p->ctx);
+    free(p);
+}
+
+static void update_watermarks(qrng_producer *p) {
+    int f = p->c.front;
+    uint64_t level;
+    if (p->c.holding) {
+        level = p->half_bytes[f] - p->c.pos;
+    } else {
+        level = __atomic_load_n(&p->state[f], __ATOMIC_RELAXED) == HALF_FULL
+            ? __atomic_load_n(&p->half_bytes[f], __ATOMIC_RELAXED) : 0;
+    }
+    if (__atomic_load_n(&p->state[f ^ 1], __ATOMIC_RELAXED) == HALF_FULL) {
+        level += __atomic_load_n(&p->half_bytes[f ^ 1], __ATOMIC_RELAXED);
+    }
+
+    __atomic_store_n(&p->c.level, level, __ATOMIC_RELAXED);
+    if (level < __atomic_load_n(&p->c.low_water, __ATOMIC_RELAXED)) {
+        __atomic_store_n(&p->c.low_water, level, __ATOMIC_RELAXED);
+    }
+    if (level > __atomic_load_n(&p->c.high_water, __ATOMIC_RELAXED)) {
+        __atomic_store_n(&p->c.high_water, level, __ATOMIC_RELAXED);
+    }
+}
+
+size_t qrng_producer_read(qrng_producer *p, uint8_t *out, size_t len) {
+    if (!p || !out) return 0;
+
+    __atomic_fetch_add(&p->c.requested, len, __ATOMIC_RELAXED);
+
+    size_t copied = 0;
+    while (copied < len) {
+        if (!p->c.holding) {
+            // Taking the half is a swap, so the producer cannot reclaim it
+            // while it is being read
+            uint32_t expected = HALF_FULL;
+            if (!__atomic_compare_exchange_n(&p->state[p->c.front], &expected, HALF_HELD, 0,
+                                             __ATOMIC_ACQUIRE, __ATOMIC_RELAXED)) {
+                __atomic_fetch_add(&p->c.underflows, 1, __ATOMIC_RELAXED);
+                break;
+            }
+            p->c.holding = 1;
+            p->c.pos = 0;
+        }
+
+        int f = p->c.front;
+        size_t n = p->half_bytes[f] - p->c.pos;
+        if (n > len - copied) n = len - copied;
+        // Served bytes are wiped as they leave, so the cost follows the
+        // request rather than landing on whichever read drains the half
+        memcpy(out + copied, p->half[f] + p->c.pos, n);
+        memset(p->half[f] + p->c.pos, 0, n);
+        p->c.pos += n;
+        copied += n;
+
+        // Drained: hand the half back for refill and move to the other one
+        if (p->c.pos == p->half_bytes[f]) {
+            __atomic_store_n(&p->state[f], HALF_EMPTY, __ATOMIC_RELEASE);
+            qrng_futex_wake(&p->state[f], 0);
+            p->c.holding = 0;
+            p->c.front = f ^ 1;
+            __atomic_fetch_add(&p->c.swaps, 1, __ATOMIC_RELAXED);
+        }
+    }
+
+    __atomic_fetch_add(&p->c.served, copied, __ATOMIC_RELAXED);
+    update_watermarks(p);
+    return copied;
+}
+
+void qrng_producer_get_stats(qrng_producer *p, qrng_refill_stats *stats) {
+    if (!p || !stats) return;
+
+    uint64_t low = __atomic_exchange_n(&p->c.low_water, UINT64_MAX, __ATOMIC_RELAXED);
+    uint64_t high = __atomic_exchange_n(&p->c.high_water, 0, __ATOMIC_RELAXED);
+    uint64_t level = __atomic_load_n(&p->c.level, __ATOMIC_RELAXED);
+    uint64_t refills = __atomic_load_n(&p->refills, __ATOMIC_RELAXED);
+
+    stats->capacity = __atomic_load_n(&p->half_bytes[0], __ATOMIC_RELAXED) +
+                      __atomic_load_n(&p->half_bytes[1], __ATOMIC_RELAXED);
+    stats->level = level;
+    stats->low_water = low == UINT64_MAX ? level : low;
+    stats->high_water = high > level ? high : level;
+    stats->served = __atomic_load_n(&p->c.served, __ATOMIC_RELAXED);
+    stats->swaps = __atomic_load_n(&p->c.swaps, __ATOMIC_RELAXED);
+    stats->underflows = __atomic_load_n(&p->c.underflows, __ATOMIC_RELAXED);
+    stats->refills = refills;
+    stats->failures = __atomic_load_n(&p->failures, __ATOMIC_RELAXED);
+    stats->mean_refill_us = refills
+        ? (double)__atomic_load_n(&p->refill_ns, __ATOMIC_RELAXED) / refills / 1000.0
+        : 0.0;
+
+    stats->adaptive = p->ctl.adaptive;
+    stats->demand_bps = __atomic_load_n(&p->ctl.demand_bps, __ATOMIC_RELAXED);
+    stats->fill_bps = __atomic_load_n(&p->ctl.fill_bps, __ATOMIC_RELAXED);
+    stats->target = p->ctl.adaptive ? __atomic_load_n(&p->ctl.target, __ATOMIC_RELAXED)
+                                    : stats->capacity;
+    stats->threads = p->ctl.adaptive
+        ? (uint32_t)__atomic_load_n(&p->ctl.active_threads, __ATOMIC_RELAXED) : 1;
+    stats->max_capacity = p->ctl.adaptive ? 2 * p->ctl.max_half : stats->capacity;
+    stats->max_threads = p->ctl.adaptive ? (uint32_t)p->ctl.max_threads : 1;
+    stats->grows = __atomic_load_n(&p->ctl.grows, __ATOMIC_RELAXED);
+    stats->shrinks = __atomic_load_n(&p->ctl.shrinks, __ATOMIC_RELAXED);
+    stats->thread_raises = __atomic_load_n(&p->ctl.thread_raises, __ATOMIC_RELAXED);
+    stats->thread_cuts = __atomic_load_n(&p->ctl.thread_cuts, __ATOMIC_RELAXED);
+    stats->clipped = __atomic_load_n(&p->ctl.clipped, __ATOMIC_RELAXED);
+    stats->reclaims = __atomic_load_n(&p->ctl.reclaims, __ATOMIC_RELAXED);
+}
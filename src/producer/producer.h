@@ -0,0 +1,84 @@
+#ifndef QUANTUM_PRODUCER_H
+#define QUANTUM_PRODUCER_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include "quantum_rng.h"
+
+/**
+ * @file producer.h
+ * @brief Background refill thread with a double-buffered output pool
+ *
+ * A producer thread owns a private context and fills two halves of a pool
+ * in turn. The single consumer reads one half while the other is refilled;
+ * handing a half back and taking the next are atomic stores and loads on
+ * the halves' state words, so the consumer never takes a lock or waits.
+ * When both halves are drained it returns short and the caller generates
+ * the rest itself. The producer sleeps on a futex while both halves are
+ * full.
+ *
+ * Given a budget, a controller in the producer thread tracks the rate the
+ * consumer asks for bytes as an exponentially weighted moving average. At
+ * every refill it sizes the half to hold the budget's target_ms of that
+ * demand and fills it on as many threads of the shared task pool as keep
+ * up with it, both capped by the budget. While both halves stay full it
+ * wakes periodically, so an idle pool decays and a full half the consumer
+ * has not taken is dropped and refilled smaller.
+ */
+
+#define QRNG_PRODUCER_MIN_BYTES (64 << 10)     /**< Smallest pool, both halves */
+#define QRNG_PRODUCER_MAX_BYTES (64 << 20)     /**< Largest pool, both halves */
+
+typedef struct qrng_producer qrng_producer;
+
+/**
+ * @brief Start a producer seeded from a context
+ *
+ * The producer's context is seeded with bytes drawn from seed_from and
+ * inherits its seed queue, reseed schedule and conditioning ratio.
+ * seed_from is only used during this call.
+ *
+ * @param seed_from Context to seed from
+ * @param pool_bytes Pool size, clamped to [QRNG_PRODUCER_MIN_BYTES,
+ *                   QRNG_PRODUCER_MAX_BYTES] and split into two halves;
+ *                   the starting size when a budget is given
+ * @param budget Limits for demand-adaptive sizing, or NULL for a fixed pool
+ *               with one refill thread
+ * @return New producer, or NULL on failure
+ */
+qrng_producer *qrng_producer_create(qrng_ctx *seed_from, size_t pool_bytes,
+                                    const qrng_refill_budget *budget);
+
+/**
+ * @brief Stop the producer thread and free the pool
+ *
+ * The consumer must not be inside qrng_producer_read().
+ *
+ * @param p Producer
+ */
+void qrng_producer_destroy(qrng_producer *p);
+
+/**
+ * @brief Copy pre-generated bytes
+ *
+ * Single consumer only. Never blocks.
+ *
+ * @param p Producer
+ * @param out Output buffer
+ * @param len Bytes wanted
+ * @return Bytes copied; less than len when the pool ran dry
+ */
+size_t qrng_producer_read(qrng_producer *p, uint8_t *out, size_t len);
+
+/**
+ * @brief Snapshot counters and fill watermarks
+ *
+ * The watermarks cover the interval since the previous snapshot and are
+ * reset by this call.
+ *
+ * @param p Producer
+ * @param stats[out] Receives the counters
+ */
+void qrng_producer_get_stats(qrng_producer *p, qrng_refill_stats *stats);
+
+#endif /* QUANTUM_PRODUCER_H */
@@ -1,11 +1,25 @@
 #include "quantum_rng.h"
+#include "simd.h"
+#include "parallel.h"
+#include "health.h"
+#include "toeplitz.h"
+#include "seed_queue.h"
+#include "statevector.h"
+#include "producer.h"
+#include "block_ring.h"
+#include "shm_ring.h"
 #include <stdlib.h>
+#include <stdint.h>
 #include <string.h>
 #include <math.h>
 #include <stdio.h>
 #include <time.h>
 #include <unistd.h>
 #include <sys/time.h>
+#include <sys/random.h>
+#include <errno.h>
+#include <pthread.h>
+#include <sched.h>
 
 // Enhanced physical constants for quantum operations
 #define QRNG_FINE_STRUCTURE 0x7297352743776A1BULL
@@ -22,6 +36,13 @@
 #define QRNG_PAULI_Y 0xD3E99E3B6C1A4F78ULL
 #define QRNG_PAULI_Z 0x8F142FC07892A5B6ULL
 
+// Background reseed slot states
+enum {
+    RESEED_IDLE = 0,        // No background reseed in flight
+    RESEED_FETCHING = 1,    // Thread is reading OS entropy into reseed_seed
+    RESEED_READY = 2        // reseed_seed waits to be absorbed on refill
+};
+
 // Forward declarations of static functions
 static inline double quantum_noise(double x);
 static inline uint64_t splitmix64(uint64_t x);
@@ -30,8 +51,15 @@ static uint64_t get_system_entropy(void);
 static uint64_t get_runtime_entropy(qrng_ctx *ctx);
 static inline uint64_t hadamard_gate(uint64_t x);
 static inline uint64_t phase_gate(uint64_t x, uint64_t angle);
+static void update_entropy_pool(qrng_ctx *ctx, double collapsed);
 static uint64_t measure_state(qrng_ctx *ctx, double quantum_state, uint64_t last);
-static void quantum_step(qrng_ctx *ctx);
+static qrng_error quantum_step(qrng_ctx *ctx);
+static void apply_background_reseed(qrng_ctx *ctx);
+static void absorb_queued_seed(qrng_ctx *ctx);
+static void apply_scheduled_reseed(qrng_ctx *ctx);
+static void maybe_schedule_reseed(qrng_ctx *ctx, size_t bytes);
+static void warm_up(qrng_ctx *ctx);
+static int read_os_entropy(uint8_t *buf, size_t len);
 
 // Enhanced quantum noise function with multiple transformations
 static inline double quantum_noise(double x) {
@@ -151,14 +179,8 @@ static inline uint64_t phase_gate(uint64_t x, uint64_t angle) {
     return x ^ mixed;
 }
 
-// Enhanced measurement function with improved entropy collection
-static uint64_t measure_state(qrng_ctx *ctx, double quantum_state, uint64_t last) {
-    // Update runtime entropy
-    ctx->runtime_entropy = get_runtime_entropy(ctx);
-    
-    volatile double collapsed = quantum_noise(quantum_state + 
-        (double)ctx->runtime_entropy / UINT64_MAX);
-    
+// Fold a collapsed measurement into the entropy pool and its mixer
+static void update_entropy_pool(qrng_ctx *ctx, double collapsed) {
     // Update entropy pool with runtime entropy
     ctx->entropy_pool[ctx->pool_index] = quantum_noise(
         ctx->entropy_pool[ctx->pool_index] + collapsed +
@@ -170,6 +192,17 @@ static uint64_t measure_state(qrng_ctx *ctx, double quantum_state, uint64_t last
     ctx->pool_mixer = hadamard_mix(ctx->pool_mixer ^ 
         (uint64_t)(ctx->entropy_pool[ctx->pool_index] * UINT64_MAX) ^
         ctx->runtime_entropy);
+}
+
+// Enhanced measurement function with improved entropy collection
+static uint64_t measure_state(qrng_ctx *ctx, double quantum_state, uint64_t last) {
+    // Update runtime entropy
+    ctx->runtime_entropy = get_runtime_entropy(ctx);
+    
+    volatile double collapsed = quantum_noise(quantum_state + 
+        (double)ctx->runtime_entropy / UINT64_MAX);
+    
+    update_entropy_pool(ctx, collapsed);
     
     uint64_t result = (uint64_t)(collapsed * UINT64_MAX);
     result = hadamard_mix(result ^ (last * QRNG_ELECTRON_G) ^ ctx->runtime_entropy);
@@ -184,9 +217,22 @@ static uint64_t measure_state(qrng_ctx *ctx, double quantum_state, uint64_t last
     return result;
 }
 
-// Core state management and output generation
-static void quantum_step(qrng_ctx *ctx) {
-    if (!ctx) return;
+// Fold in whatever is due before generating bytes of output: deferred
+// warm-up, finished reseeds, one collector seed, and the reseed schedule
+static void prepare_refill(qrng_ctx *ctx, size_t bytes) {
+    if (ctx->warmup_pending) warm_up(ctx);
+    apply_background_reseed(ctx);
+    apply_scheduled_reseed(ctx);
+    absorb_queued_seed(ctx);
+    maybe_schedule_reseed(ctx, bytes);
+}
+
+// Core state management and output generation. Fails when the refilled
+// buffer does not pass the continuous health tests.
+static qrng_error quantum_step(qrng_ctx *ctx) {
+    if (!ctx) return QRNG_ERROR_NULL_CONTEXT;
+    
+    prepare_refill(ctx, QRNG_BUFFER_SIZE);
     
     ctx->counter++;
     uint64_t mixer = splitmix64(ctx->counter * QRNG_GOLDEN_RATIO);
@@ -232,9 +278,14 @@ static void quantum_step(qrng_ctx *ctx) {
         }
     }
     
-    // Fill output buffer with improved mixing
+    // Fill output buffer with improved mixing. A conditioner measures
+    // ratio raw words per output word and compresses them into the buffer.
+    uint64_t raw[QRNG_BUFFER_SIZE / sizeof(uint64_t) * QRNG_MAX_CONDITIONING_RATIO];
+    uint64_t *dst = ctx->conditioner ? raw : ctx->buffer.words;
+    size_t words = QRNG_BUFFER_SIZE / sizeof(uint64_t) *
+        (ctx->conditioner ? ctx->conditioning_ratio : 1);
     uint64_t prev = mixer;
-    for (size_t i = 0; i < QRNG_BUFFER_SIZE / sizeof(uint64_t); i++) {
+    for (size_t i = 0; i < words; i++) {
         uint64_t current = measure_state(ctx, 
             ctx->quantum_state[i % QRNG_NUM_QUBITS],
             ctx->entangle[i % QRNG_NUM_QUBITS]);
@@ -247,10 +298,21 @@ static void quantum_step(qrng_ctx *ctx) {
         current ^= QRNG_PAULI_Y * (current >> 31);
         current *= QRNG_SCHRODINGER;
         
-        ctx->buffer.words[i] = current;
+        dst[i] = current;
         prev = current;
     }
+    if (ctx->conditioner) {
+        qrng_toeplitz_extract(ctx->conditioner, (const uint8_t *)raw,
+            ctx->buffer.bytes, 1);
+        memset(raw, 0, words * sizeof(uint64_t));
+    }
     ctx->buffer_pos = 0;
+
+    if (qrng_health_update(ctx->health, ctx->buffer.bytes, QRNG_BUFFER_SIZE) != 0) {
+        ctx->buffer_pos = QRNG_BUFFER_SIZE;
+        return QRNG_ERROR_INSUFFICIENT_ENTROPY;
+    }
+    return QRNG_SUCCESS;
 }
 
 // Public API implementations
@@ -261,6 +323,13 @@ qrng_error qrng_init(qrng_ctx **ctx, const uint8_t *seed, size_t seed_len) {
     *ctx = calloc(1, sizeof(qrng_ctx));
     if (!*ctx) return QRNG_ERROR_NULL_CONTEXT;
     
+    (*ctx)->health = qrng_health_create();
+    if (!(*ctx)->health) {
+        free(*ctx);
+        *ctx = NULL;
+        return QRNG_ERROR_NULL_CONTEXT;
+    }
+    
     // Initialize context with system-specific entropy
     gettimeofday(&(*ctx)->init_time, NULL);
     (*ctx)->pid = getpid();
@@ -312,54 +381,539 @@ qrng_error qrng_init(qrng_ctx **ctx, const uint8_t *seed, size_t seed_len) {
         quantum_step(*ctx);
     }
     
+    // Seed the estimate from the warm-up output
+    qrng_health_publish((*ctx)->health);
+    
+    // Clock, PID and stack address are not credited; only the caller's seed,
+    // by its estimated min-entropy
+    (*ctx)->credited_bits = qrng_health_estimate_bits(seed, seed_len);
+    (*ctx)->conditioning_ratio = 1;
+    
+    return QRNG_SUCCESS;
+}
+
+#define QRNG_FAST_SEED_BYTES 32
+
+// Deferred warm-up of a context created by qrng_init_fast
+static void warm_up(qrng_ctx *ctx) {
+    ctx->warmup_pending = 0;
+    for (int i = 0; i < QRNG_MIXING_ROUNDS * 2; i++) {
+        quantum_step(ctx);
+    }
+    qrng_health_publish(ctx->health);
+}
+
+qrng_error qrng_init_fast(qrng_ctx **ctx, const uint8_t *seed, size_t seed_len) {
+    if (!ctx) return QRNG_ERROR_NULL_CONTEXT;
+    if (!seed && seed_len > 0) return QRNG_ERROR_NULL_BUFFER;
+
+    uint8_t os_seed[QRNG_FAST_SEED_BYTES];
+    if (read_os_entropy(os_seed, sizeof(os_seed)) != 0) {
+        return QRNG_ERROR_INSUFFICIENT_ENTROPY;
+    }
+
+    qrng_ctx *c = calloc(1, sizeof(qrng_ctx));
+    if (!c) return QRNG_ERROR_NULL_CONTEXT;
+
+    c->health = qrng_health_create();
+    if (!c->health) {
+        free(c);
+        *ctx = NULL;
+        return QRNG_ERROR_NULL_CONTEXT;
+    }
+
+    gettimeofday(&c->init_time, NULL);
+    c->pid = getpid();
+    c->system_entropy = get_system_entropy();
+
+    // Registers come straight from the sponge; the circuit runs on first use
+    uint64_t words[QRNG_NUM_QUBITS * 4 + 16 + 2];
+    qrng_sponge sponge;
+    qrng_sponge_init(&sponge);
+    qrng_sponge_absorb(&sponge, os_seed, sizeof(os_seed));
+    qrng_sponge_absorb(&sponge, &c->system_entropy, sizeof(c->system_entropy));
+    if (seed_len > 0) qrng_sponge_absorb(&sponge, seed, seed_len);
+    qrng_sponge_squeeze(&sponge, (uint8_t *)words, sizeof(words));
+    qrng_sponge_clear(&sponge);
+
+    const uint64_t *w = words;
+    for (int i = 0; i < QRNG_NUM_QUBITS; i++) {
+        c->phase[i] = *w++;
+        c->entangle[i] = *w++;
+        c->last_measurement[i] = *w++;
+        c->quantum_state[i] = (double)(*w++ >> 11) * 0x1.0p-53;
+    }
+    for (int i = 0; i < 16; i++) {
+        c->entropy_pool[i] = (double)(*w++ >> 11) * 0x1.0p-53;
+    }
+    c->unique_id = *w++;
+    c->pool_mixer = QRNG_HEISENBERG ^ *w++;
+    c->runtime_entropy = get_runtime_entropy(c);
+    c->buffer_pos = QRNG_BUFFER_SIZE;
+
+    memset(words, 0, sizeof(words));
+    memset(os_seed, 0, sizeof(os_seed));
+
+    c->warmup_pending = 1;
+    c->credited_bits = QRNG_FAST_SEED_BYTES * 8 + qrng_health_estimate_bits(seed, seed_len);
+    c->conditioning_ratio = 1;
+
+    *ctx = c;
     return QRNG_SUCCESS;
 }
 
 void qrng_free(qrng_ctx *ctx) {
     if (ctx) {
+        // A background reseed may still be writing into the context
+        while (__atomic_load_n(&ctx->reseed_state, __ATOMIC_ACQUIRE) == RESEED_FETCHING) {
+            sched_yield();
+        }
+        while (__atomic_load_n(&ctx->schedule_busy, __ATOMIC_ACQUIRE) &&
+               !__atomic_load_n(&ctx->pending_state, __ATOMIC_ACQUIRE)) {
+            sched_yield();
+        }
+        qrng_producer_destroy(ctx->producer);
+        free(ctx->ring_block);
+        free(ctx->pending_state);
+        qrng_health_destroy(ctx->health);
+        qrng_toeplitz_destroy(ctx->conditioner);
+        qrng_state_destroy(ctx->sim);
         memset(ctx, 0, sizeof(*ctx));
         free(ctx);
     }
 }
 
-qrng_error qrng_reseed(qrng_ctx *ctx, const uint8_t *seed, size_t seed_len) {
-    if (!ctx) return QRNG_ERROR_NULL_CONTEXT;
-    if (!seed && seed_len > 0) return QRNG_ERROR_NULL_BUFFER;
-    if (seed_len == 0) return QRNG_ERROR_INVALID_LENGTH;
-    
+// Fold a seed of any length into the qubit registers. The sponge digest
+// gives every qubit two words that depend on the whole seed.
+static void reseed_state(qrng_ctx *ctx, const uint8_t *seed, size_t seed_len) {
+    uint64_t words[QRNG_NUM_QUBITS * 2];
+    qrng_sponge sponge;
+    qrng_sponge_init(&sponge);
+    qrng_sponge_absorb(&sponge, seed, seed_len);
+    qrng_sponge_squeeze(&sponge, (uint8_t *)words, sizeof(words));
+    qrng_sponge_clear(&sponge);
+
     // Update runtime entropy
     ctx->runtime_entropy = get_runtime_entropy(ctx);
     
     uint64_t mixer = QRNG_GOLDEN_RATIO ^ ctx->runtime_entropy;
-    for (size_t i = 0; i < seed_len && i < QRNG_NUM_QUBITS; i++) {
-        mixer = splitmix64(mixer ^ seed[i] ^ ctx->runtime_entropy);
-        ctx->phase[i] = hadamard_gate(ctx->phase[i] ^ seed[i] ^ mixer ^ 
+    for (size_t i = 0; i < QRNG_NUM_QUBITS; i++) {
+        uint64_t a = words[i];
+        uint64_t b = words[QRNG_NUM_QUBITS + i];
+        mixer = splitmix64(mixer ^ a ^ ctx->runtime_entropy);
+        ctx->phase[i] = hadamard_gate(ctx->phase[i] ^ a ^ mixer ^ 
             ctx->runtime_entropy);
         ctx->quantum_state[i] = quantum_noise(
             (double)ctx->phase[i] / UINT64_MAX +
             (double)ctx->runtime_entropy / UINT64_MAX
         );
         ctx->last_measurement[i] = measure_state(ctx, ctx->quantum_state[i],
-            seed[seed_len - 1 - i] ^ mixer);
+            b ^ mixer);
         ctx->entangle[i] = phase_gate(ctx->last_measurement[i], 
-            seed[i] ^ mixer ^ ctx->runtime_entropy);
+            a ^ b ^ mixer ^ ctx->runtime_entropy);
     }
+    memset(words, 0, sizeof(words));
     
     for (int i = 0; i < QRNG_MIXING_ROUNDS * 2; i++) {
         quantum_step(ctx);
     }
+}
+
+qrng_error qrng_reseed(qrng_ctx *ctx, const uint8_t *seed, size_t seed_len) {
+    if (!ctx) return QRNG_ERROR_NULL_CONTEXT;
+    if (!seed && seed_len > 0) return QRNG_ERROR_NULL_BUFFER;
+    if (seed_len == 0) return QRNG_ERROR_INVALID_LENGTH;
+    
+    reseed_state(ctx, seed, seed_len);
+    qrng_credit_entropy(ctx, qrng_health_estimate_bits(seed, seed_len));
     
     return QRNG_SUCCESS;
 }
 
+// Entropy accounting. Counters are updated with atomics so credits can
+// arrive from other threads while the owner draws.
+
+// Read len bytes from the kernel CSPRNG, blocking until it is initialised
+static int read_os_entropy(uint8_t *buf, size_t len) {
+    while (len > 0) {
+        ssize_t n = getrandom(buf, len, 0);
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            return -1;
+        }
+        buf += n;
+        len -= (size_t)n;
+    }
+    return 0;
+}
+
+// Cheap seed absorption for reseeds that must not stall the caller: fold
+// every seed word into the qubit registers and force a fresh buffer
+static void absorb_seed(qrng_ctx *ctx, const uint8_t *seed, size_t len) {
+    uint64_t mixer = hadamard_mix(ctx->pool_mixer ^ len ^ QRNG_SCHRODINGER);
+
+    for (size_t off = 0; off < len; off += sizeof(uint64_t)) {
+        uint64_t w = 0;
+        size_t n = len - off < sizeof(w) ? len - off : sizeof(w);
+        memcpy(&w, seed + off, n);
+
+        size_t i = (off / sizeof(uint64_t)) % QRNG_NUM_QUBITS;
+        mixer = hadamard_mix(mixer ^ w);
+        ctx->phase[i] = hadamard_mix(ctx->phase[i] ^ mixer);
+        ctx->entangle[i] = splitmix64(ctx->entangle[i] ^ mixer ^ QRNG_PAULI_Y);
+    }
+
+    ctx->pool_mixer = hadamard_mix(ctx->pool_mixer ^ mixer);
+    ctx->buffer_pos = QRNG_BUFFER_SIZE;
+}
+
+static int64_t available_bits(const qrng_ctx *ctx) {
+    uint64_t credited = __atomic_load_n(&ctx->credited_bits, __ATOMIC_ACQUIRE);
+    uint64_t drawn = __atomic_load_n(&ctx->drawn_bits, __ATOMIC_ACQUIRE);
+    return (int64_t)(credited - drawn);
+}
+
+static void *background_reseed(void *arg) {
+    qrng_ctx *ctx = arg;
+    uint32_t next = read_os_entropy(ctx->reseed_seed, QRNG_RESEED_BYTES) == 0
+        ? RESEED_READY : RESEED_IDLE;
+
+    // Last touch of ctx; qrng_free waits for this store
+    __atomic_store_n(&ctx->reseed_state, next, __ATOMIC_RELEASE);
+    return NULL;
+}
+
+static void request_background_reseed(qrng_ctx *ctx) {
+    uint32_t idle = RESEED_IDLE;
+    if (!__atomic_compare_exchange_n(&ctx->reseed_state, &idle, RESEED_FETCHING,
+            0, __ATOMIC_ACQ_REL, __ATOMIC_RELAXED)) {
+        return;
+    }
+
+    pthread_t tid;
+    pthread_attr_t attr;
+    pthread_attr_init(&attr);
+    pthread_attr_setdetachstate(&attr, PTHREAD_CREATE_DETACHED);
+    if (pthread_create(&tid, &attr, background_reseed, ctx) != 0) {
+        __atomic_store_n(&ctx->reseed_state, RESEED_IDLE, __ATOMIC_RELEASE);
+    }
+    pthread_attr_destroy(&attr);
+}
+
+// Absorb a completed background reseed; runs on the owner at refill
+static void apply_background_reseed(qrng_ctx *ctx) {
+    if (__atomic_load_n(&ctx->reseed_state, __ATOMIC_ACQUIRE) != RESEED_READY) return;
+
+    absorb_seed(ctx, ctx->reseed_seed, QRNG_RESEED_BYTES);
+    memset(ctx->reseed_seed, 0, QRNG_RESEED_BYTES);
+    qrng_credit_entropy(ctx, QRNG_RESEED_BYTES * 8);
+    __atomic_fetch_add(&ctx->reseed_count, 1, __ATOMIC_RELAXED);
+    __atomic_store_n(&ctx->reseed_state, RESEED_IDLE, __ATOMIC_RELEASE);
+}
+
+// Fold in one collector seed if one is waiting; never blocks
+static void absorb_queued_seed(qrng_ctx *ctx) {
+    if (!ctx->seed_queue) return;
+
+    uint8_t seed[QRNG_SEED_BYTES];
+    uint32_t bits;
+    if (qrng_seed_queue_pop(ctx->seed_queue, seed, &bits) == 0) {
+        absorb_seed(ctx, seed, sizeof(seed));
+        qrng_credit_entropy(ctx, bits);
+        memset(seed, 0, sizeof(seed));
+    }
+}
+
+// Scheduled reseeds. The helper thread mixes a fresh seed into a private
+// copy of the context and hands back only the qubit registers and pools,
+// which the owner swaps in at a refill boundary.
+struct qrng_core_state {
+    uint64_t phase[QRNG_NUM_QUBITS];
+    uint64_t entangle[QRNG_NUM_QUBITS];
+    double quantum_state[QRNG_NUM_QUBITS];
+    uint64_t last_measurement[QRNG_NUM_QUBITS];
+    double entropy_pool[16];
+    uint64_t pool_mixer;
+    uint8_t pool_index;
+};
+
+typedef struct {
+    qrng_ctx *owner;
+    qrng_ctx work;
+} reseed_job;
+
+static uint64_t monotonic_ms(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC_COARSE, &ts);
+    return (uint64_t)ts.tv_sec * 1000 + (uint64_t)ts.tv_nsec / 1000000;
+}
+
+static void *scheduled_reseed(void *arg) {
+    reseed_job *job = arg;
+    qrng_ctx *owner = job->owner;
+    uint8_t seed[QRNG_RESEED_BYTES];
+    struct qrng_core_state *next = NULL;
+
+    if (read_os_entropy(seed, sizeof(seed)) == 0) {
+        next = malloc(sizeof(*next));
+    }
+    if (next) {
+        qrng_ctx *w = &job->work;
+        reseed_state(w, seed, sizeof(seed));
+
+        memcpy(next->phase, w->phase, sizeof(next->phase));
+        memcpy(next->entangle, w->entangle, sizeof(next->entangle));
+        memcpy(next->quantum_state, w->quantum_state, sizeof(next->quantum_state));
+        memcpy(next->last_measurement, w->last_measurement, sizeof(next->last_measurement));
+        memcpy(next->entropy_pool, w->entropy_pool, sizeof(next->entropy_pool));
+        next->pool_mixer = w->pool_mixer;
+        next->pool_index = w->pool_index;
+    }
+
+    memset(seed, 0, sizeof(seed));
+    memset(job, 0, sizeof(*job));
+    free(job);
+
+    // Last touch of owner; qrng_free waits for one of these stores
+    if (next) {
+        __atomic_store_n(&owner->pending_state, next, __ATOMIC_RELEASE);
+    } else {
+        __atomic_store_n(&owner->schedule_busy, 0, __ATOMIC_RELEASE);
+    }
+    return NULL;
+}
+
+// Count bytes about to be generated and start a helper if the schedule is
+// due; runs on the owner at refill
+static void maybe_schedule_reseed(qrng_ctx *ctx, size_t bytes) {
+    if (!ctx->reseed_every_bytes && !ctx->reseed_every_ms) return;
+
+    ctx->reseed_since_bytes += bytes;
+    int due = ctx->reseed_every_bytes && ctx->reseed_since_bytes >= ctx->reseed_every_bytes;
+    if (!due && ctx->reseed_every_ms) {
+        due = monotonic_ms() - ctx->reseed_last_ms >= ctx->reseed_every_ms;
+    }
+    if (!due || __atomic_load_n(&ctx->schedule_busy, __ATOMIC_ACQUIRE)) return;
+
+    reseed_job *job = malloc(sizeof(*job));
+    if (!job) return;
+    job->owner = ctx;
+    memcpy(&job->work, ctx, sizeof(*ctx));
+
+    // The copy is mixed alone; nothing it points to may be touched
+    qrng_ctx *w = &job->work;
+    w->health = NULL;
+    w->conditioner = NULL;
+    w->seed_queue = NULL;
+    w->sim = NULL;
+    w->producer = NULL;
+    w->block_ring = NULL;
+    w->shm_ring = NULL;
+    w->ring_block = NULL;
+    w->entropy_policy = QRNG_ENTROPY_POLICY_NONE;
+    w->reseed_state = RESEED_IDLE;
+    w->reseed_every_bytes = 0;
+    w->reseed_every_ms = 0;
+    w->pending_state = NULL;
+
+    __atomic_store_n(&ctx->schedule_busy, 1, __ATOMIC_RELEASE);
+
+    pthread_t tid;
+    pthread_attr_t attr;
+    pthread_attr_init(&attr);
+    pthread_attr_setdetachstate(&attr, PTHREAD_CREATE_DETACHED);
+    if (pthread_create(&tid, &attr, scheduled_reseed, job) != 0) {
+        memset(job, 0, sizeof(*job));
+        free(job);
+        __atomic_store_n(&ctx->schedule_busy, 0, __ATOMIC_RELEASE);
+    }
+    pthread_attr_destroy(&attr);
+}
+
+// Swap in a precomputed state; runs on the owner at refill
+static void apply_scheduled_reseed(qrng_ctx *ctx) {
+    if (!__atomic_load_n(&ctx->pending_state, __ATOMIC_RELAXED)) return;
+
+    struct qrng_core_state *next = __atomic_exchange_n(&ctx->pending_state, NULL, __ATOMIC_ACQ_REL);
+    if (!next) return;
+
+    // The helper keyed next from a snapshot. Fold the live registers into
+    // it, so whatever the owner absorbed and generated since survives.
+    for (int i = 0; i < QRNG_NUM_QUBITS; i++) {
+        ctx->phase[i] = hadamard_mix(next->phase[i] ^ splitmix64(ctx->phase[i]));
+        ctx->entangle[i] = hadamard_mix(next->entangle[i] ^ splitmix64(ctx->entangle[i] + i));
+        ctx->last_measurement[i] = splitmix64(next->last_measurement[i] ^
+            hadamard_mix(ctx->last_measurement[i]));
+    }
+    memcpy(ctx->quantum_state, next->quantum_state, sizeof(ctx->quantum_state));
+    memcpy(ctx->entropy_pool, next->entropy_pool, sizeof(ctx->entropy_pool));
+    ctx->pool_index = next->pool_index;
+    ctx->pool_mixer = hadamard_mix(ctx->pool_mixer ^ next->pool_mixer);
+
+    memset(next, 0, sizeof(*next));
+    free(next);
+
+    qrng_credit_entropy(ctx, QRNG_RESEED_BYTES * 8);
+    __atomic_fetch_add(&ctx->scheduled_reseeds, 1, __ATOMIC_RELAXED);
+    ctx->reseed_since_bytes = 0;
+    ctx->reseed_last_ms = monotonic_ms();
+    __atomic_store_n(&ctx->schedule_busy, 0, __ATOMIC_RELEASE);
+}
+
+qrng_error qrng_set_reseed_schedule(qrng_ctx *ctx, uint64_t bytes, uint64_t interval_ms) {
+    if (!ctx) return QRNG_ERROR_NULL_CONTEXT;
+
+    ctx->reseed_every_bytes = bytes;
+    ctx->reseed_every_ms = interval_ms;
+    ctx->reseed_since_bytes = 0;
+    ctx->reseed_last_ms = monotonic_ms();
+    return QRNG_SUCCESS;
+}
+
+// Apply the policy before serving len output bytes that would overdraw the
+// budget. The bytes are charged by charge_entropy() once they are delivered.
+static qrng_error draw_entropy(qrng_ctx *ctx, size_t len) {
+    uint64_t bits = (uint64_t)len * 8;
+
+    if (ctx->entropy_policy != QRNG_ENTROPY_POLICY_NONE &&
+        available_bits(ctx) < (int64_t)bits) {
+        switch (ctx->entropy_policy) {
+            case QRNG_ENTROPY_POLICY_FAIL:
+                return QRNG_ERROR_INSUFFICIENT_ENTROPY;
+
+            case QRNG_ENTROPY_POLICY_BLOCK: {
+                // Pull exactly the deficit from the OS before serving
+                uint8_t seed[256];
+                int64_t missing = (int64_t)bits - available_bits(ctx);
+                while (missing > 0) {
+                    size_t n = (size_t)((missing + 7) / 8);
+                    if (n > sizeof(seed)) n = sizeof(seed);
+                    if (read_os_entropy(seed, n) != 0) {
+                        return QRNG_ERROR_INSUFFICIENT_ENTROPY;
+                    }
+                    absorb_seed(ctx, seed, n);
+                    qrng_credit_entropy(ctx, (uint64_t)n * 8);
+                    missing -= (int64_t)n * 8;
+                }
+                memset(seed, 0, sizeof(seed));
+                __atomic_fetch_add(&ctx->reseed_count, 1, __ATOMIC_RELAXED);
+                break;
+            }
+
+            case QRNG_ENTROPY_POLICY_RESEED:
+                request_background_reseed(ctx);
+                break;
+
+            default:
+                break;
+        }
+    }
+
+    return QRNG_SUCCESS;
+}
+
+// Charge len delivered output bytes against the budget
+static void charge_entropy(qrng_ctx *ctx, size_t len) {
+    __atomic_fetch_add(&ctx->drawn_bits, (uint64_t)len * 8, __ATOMIC_RELEASE);
+}
+
+qrng_error qrng_reserve_entropy(qrng_ctx *ctx, size_t len) {
+    if (!ctx) return QRNG_ERROR_NULL_CONTEXT;
+    return draw_entropy(ctx, len);
+}
+
+qrng_error qrng_charge_entropy(qrng_ctx *ctx, size_t len) {
+    if (!ctx) return QRNG_ERROR_NULL_CONTEXT;
+
+    charge_entropy(ctx, len);
+    return QRNG_SUCCESS;
+}
+
+qrng_error qrng_set_entropy_policy(qrng_ctx *ctx, qrng_entropy_policy policy) {
+    if (!ctx) return QRNG_ERROR_NULL_CONTEXT;
+    if (policy < QRNG_ENTROPY_POLICY_NONE || policy > QRNG_ENTROPY_POLICY_FAIL) {
+        return QRNG_ERROR_INVALID_RANGE;
+    }
+
+    ctx->entropy_policy = policy;
+    return QRNG_SUCCESS;
+}
+
+qrng_error qrng_credit_entropy(qrng_ctx *ctx, uint64_t bits) {
+    if (!ctx) return QRNG_ERROR_NULL_CONTEXT;
+
+    __atomic_fetch_add(&ctx->credited_bits, bits, __ATOMIC_RELEASE);
+    return QRNG_SUCCESS;
+}
+
+qrng_error qrng_get_entropy_budget(const qrng_ctx *ctx, qrng_entropy_budget *budget) {
+    if (!ctx) return QRNG_ERROR_NULL_CONTEXT;
+    if (!budget) return QRNG_ERROR_NULL_BUFFER;
+
+    budget->credited_bits = __atomic_load_n(&ctx->credited_bits, __ATOMIC_ACQUIRE);
+    budget->drawn_bits = __atomic_load_n(&ctx->drawn_bits, __ATOMIC_ACQUIRE);
+    budget->available_bits = (int64_t)(budget->credited_bits - budget->drawn_bits);
+    budget->reseeds = __atomic_load_n(&ctx->reseed_count, __ATOMIC_RELAXED);
+    budget->scheduled_reseeds = __atomic_load_n(&ctx->scheduled_reseeds, __ATOMIC_RELAXED);
+    budget->policy = ctx->entropy_policy;
+    return QRNG_SUCCESS;
+}
+
+// Take a block from the process-local ring, else the host-wide one
+static int pop_block(qrng_ctx *ctx, uint8_t *out) {
+    if (ctx->block_ring && qrng_block_ring_pop(ctx->block_ring, out) == 0) return 0;
+    if (ctx->shm_ring && qrng_shm_ring_pop(ctx->shm_ring, out) == 0) return 0;
+    return -1;
+}
+
+// Serve from the attached block rings until they run dry. Whole blocks are
+// popped straight into out; a tail takes a block into ring_block.
+static size_t ring_read(qrng_ctx *ctx, uint8_t *out, size_t len) {
+    size_t done = 0;
+    while (done < len) {
+        if (ctx->ring_pos == QRNG_RING_BLOCK) {
+            if (len - done >= QRNG_RING_BLOCK) {
+                if (pop_block(ctx, out + done) != 0) break;
+                done += QRNG_RING_BLOCK;
+                continue;
+            }
+            if (pop_block(ctx, ctx->ring_block) != 0) break;
+            ctx->ring_pos = 0;
+        }
+
+        size_t n = QRNG_RING_BLOCK - ctx->ring_pos;
+        if (n > len - done) n = len - done;
+        memcpy(out + done, ctx->ring_block + ctx->ring_pos, n);
+        ctx->ring_pos += n;
+        done += n;
+    }
+    return done;
+}
+
 qrng_error qrng_bytes(qrng_ctx *ctx, uint8_t *out, size_t len) {
     if (!ctx) return QRNG_ERROR_NULL_CONTEXT;
     if (!out) return QRNG_ERROR_NULL_BUFFER;
     if (len == 0) return QRNG_ERROR_INVALID_LENGTH;
     
+    qrng_error err = draw_entropy(ctx, len);
+    if (err != QRNG_SUCCESS) return err;
+    size_t total = len;
+
+    if (ctx->producer) {
+        size_t got = qrng_producer_read(ctx->producer, out, len);
+        out += got;
+        len -= got;
+    }
+    if (ctx->block_ring || ctx->shm_ring) {
+        size_t got = ring_read(ctx, out, len);
+        out += got;
+        len -= got;
+    }
+    
     while (len > 0) {
         if (ctx->buffer_pos >= QRNG_BUFFER_SIZE) {
-            quantum_step(ctx);
+            qrng_error err = quantum_step(ctx);
+            if (err != QRNG_SUCCESS) return err;
         }
         
         size_t copy_len = QRNG_BUFFER_SIZE - ctx->buffer_pos;
@@ -371,14 +925,196 @@ qrng_error qrng_bytes(qrng_ctx *ctx, uint8_t *out, size_t len) {
         len -= copy_len;
     }
     
+    charge_entropy(ctx, total);
     return QRNG_SUCCESS;
 }
 
-uint64_t qrng_uint64(qrng_ctx *ctx) {
-    if (!ctx) return 0;
+// Substreams for parallel generation. Slice boundaries are fixed, so the
+// derived streams do not depend on how many threads run them.
+#define QRNG_PARALLEL_SLICE (256 * 1024)
+#define QRNG_DOMAIN_BYTES 0x5154524E47425953ULL
+#define QRNG_DOMAIN_SPLIT 0x5154524E4753504CULL
+
+typedef struct {
+    const qrng_ctx *parent;
+    uint8_t *out;
+    size_t len;
+    qrng_health *health;   /**< Parent estimator, merged into under lock */
+    pthread_mutex_t lock;
+    int failed;
+} bytes_job;
+
+// Derive an independent child context for (domain, index) from parent.
+// The child starts with an empty buffer so it never replays parent output.
+static void derive_substream(const qrng_ctx *parent, qrng_ctx *child,
+                             uint64_t domain, uint64_t index) {
+    memcpy(child, parent, sizeof(*child));
+
+    uint64_t tag = hadamard_mix(domain ^ splitmix64(parent->counter + index * QRNG_GOLDEN_RATIO));
+    child->unique_id = hadamard_mix(parent->unique_id ^ tag);
+    child->counter = splitmix64(parent->counter ^ tag);
+    child->pool_mixer = hadamard_mix(parent->pool_mixer ^ tag ^ QRNG_PAULI_X);
+    for (int i = 0; i < QRNG_NUM_QUBITS; i++) {
+        child->phase[i] = hadamard_mix(parent->phase[i] ^ (tag + i));
+        child->entangle[i] = hadamard_mix(parent->entangle[i] ^ (tag * QRNG_PLANCK + i));
+        child->last_measurement[i] = splitmix64(parent->last_measurement[i] ^ tag);
+    }
+    child->buffer_pos = QRNG_BUFFER_SIZE;
+    child->warmup_pending = 0;
+
+    // Children run concurrently; the parent's instruments and entropy
+    // accounting stay with it
+    // The conditioner is read-only during extraction and stays shared
+    child->health = NULL;
+    child->seed_queue = NULL;
+    child->sim = NULL;
+    child->producer = NULL;
+    child->block_ring = NULL;
+    child->shm_ring = NULL;
+    child->ring_block = NULL;
+    child->reseed_every_bytes = 0;
+    child->reseed_every_ms = 0;
+    child->schedule_busy = 0;
+    child->pending_state = NULL;
+    child->entropy_policy = QRNG_ENTROPY_POLICY_NONE;
+    child->reseed_state = RESEED_IDLE;
+}
+
+// Each worker tests the substreams it generates with its own estimator and
+// folds the counters into the parent's once its range is done
+static void bytes_range(void *arg, size_t begin, size_t end) {
+    bytes_job *job = arg;
+    qrng_ctx child;
+    int failed = 0;
+
+    qrng_health *health = job->health ? qrng_health_create() : NULL;
+    if (job->health && !health) failed = 1;
+
+    for (size_t slice = begin; slice < end && !failed; slice++) {
+        size_t off = slice * QRNG_PARALLEL_SLICE;
+        size_t n = job->len - off;
+        if (n > QRNG_PARALLEL_SLICE) n = QRNG_PARALLEL_SLICE;
+
+        derive_substream(job->parent, &child, QRNG_DOMAIN_BYTES, slice);
+        child.health = health;
+        if (qrng_bytes(&child, job->out + off, n) != QRNG_SUCCESS) failed = 1;
+    }
+    memset(&child, 0, sizeof(child));
+
+    if (health) {
+        pthread_mutex_lock(&job->lock);
+        if (qrng_health_merge(job->health, health) != 0) failed = 1;
+        if (failed) job->failed = 1;
+        pthread_mutex_unlock(&job->lock);
+        qrng_health_destroy(health);
+    } else if (failed) {
+        __atomic_store_n(&job->failed, 1, __ATOMIC_RELAXED);
+    }
+}
+
+qrng_error qrng_split(const qrng_ctx *parent, uint64_t index, qrng_ctx **child) {
+    if (!parent || !child) return QRNG_ERROR_NULL_CONTEXT;
+
+    // Whole cache lines, so contexts of different threads never share one
+    size_t size = (sizeof(qrng_ctx) + 63) & ~(size_t)63;
+    qrng_ctx *c = aligned_alloc(64, size);
+    if (!c) return QRNG_ERROR_NULL_CONTEXT;
+
+    derive_substream(parent, c, QRNG_DOMAIN_SPLIT, index);
+    c->health = qrng_health_create();
+    if (!c->health) {
+        free(c);
+        return QRNG_ERROR_NULL_CONTEXT;
+    }
+
+    // Nothing of the parent's is owned by the child
+    c->conditioner = NULL;
+    c->conditioning_ratio = 1;
+    c->credited_bits = 0;
+    c->drawn_bits = 0;
+    c->reseed_count = 0;
+    c->scheduled_reseeds = 0;
+    memset(c->reseed_seed, 0, sizeof(c->reseed_seed));
+    gettimeofday(&c->init_time, NULL);
+
+    c->seed_queue = parent->seed_queue;
+    qrng_set_reseed_schedule(c, parent->reseed_every_bytes, parent->reseed_every_ms);
+    if (parent->conditioning_ratio > 1) {
+        qrng_error err = qrng_set_conditioning(c, parent->conditioning_ratio);
+        if (err != QRNG_SUCCESS) {
+            qrng_free(c);
+            return err;
+        }
+    }
+
+    *child = c;
+    return QRNG_SUCCESS;
+}
+
+qrng_error qrng_merge_health(qrng_ctx *ctx, qrng_ctx *split) {
+    if (!ctx || !split) return QRNG_ERROR_NULL_CONTEXT;
+
+    if (qrng_health_merge(ctx->health, split->health) != 0) {
+        return QRNG_ERROR_INSUFFICIENT_ENTROPY;
+    }
+    return QRNG_SUCCESS;
+}
+
+qrng_error qrng_bytes_parallel(qrng_ctx *ctx, uint8_t *out, size_t len, size_t nthreads) {
+    if (!ctx) return QRNG_ERROR_NULL_CONTEXT;
+    if (!out) return QRNG_ERROR_NULL_BUFFER;
+    if (len == 0) return QRNG_ERROR_INVALID_LENGTH;
+
+    if (len < QRNG_PARALLEL_MIN_LEN) {
+        return qrng_bytes(ctx, out, len);
+    }
+
+    qrng_error err = draw_entropy(ctx, len);
+    if (err != QRNG_SUCCESS) return err;
+    size_t total = len;
+
+    // Bytes the background producer already has ready go first; only the
+    // rest is generated here, in substreams whatever its size
+    if (ctx->producer) {
+        size_t got = qrng_producer_read(ctx->producer, out, len);
+        out += got;
+        len -= got;
+        if (len == 0) {
+            charge_entropy(ctx, total);
+            return QRNG_SUCCESS;
+        }
+    }
+
+    // The substreams are derived from the parent, so it takes the same
+    // seeds and schedule a refill would before they are keyed
+    prepare_refill(ctx, len);
+
+    ctx->runtime_entropy = get_runtime_entropy(ctx);
+
+    bytes_job job = { .parent = ctx, .out = out, .len = len, .health = ctx->health };
+    pthread_mutex_init(&job.lock, NULL);
+    size_t slices = (len + QRNG_PARALLEL_SLICE - 1) / QRNG_PARALLEL_SLICE;
+    qrng_parallel_for(slices, 1, nthreads, bytes_range, &job);
+    pthread_mutex_destroy(&job.lock);
+
+    // Step the parent past every substream it handed out; this depends only
+    // on the request, never on how the slices were scheduled
+    ctx->counter += slices;
+    ctx->pool_mixer = hadamard_mix(ctx->pool_mixer ^ QRNG_DOMAIN_BYTES ^ len);
+    ctx->buffer_pos = QRNG_BUFFER_SIZE;
+
+    if (job.failed) return QRNG_ERROR_INSUFFICIENT_ENTROPY;
+    charge_entropy(ctx, total);
+    return QRNG_SUCCESS;
+}
+
+qrng_error qrng_uint64_checked(qrng_ctx *ctx, uint64_t *out) {
+    if (!ctx) return QRNG_ERROR_NULL_CONTEXT;
+    if (!out) return QRNG_ERROR_NULL_BUFFER;
     
     uint64_t result;
-    qrng_bytes(ctx, (uint8_t*)&result, sizeof(result));
+    qrng_error err = qrng_bytes(ctx, (uint8_t*)&result, sizeof(result));
+    if (err != QRNG_SUCCESS) return err;
     
     // Enhanced output mixing with runtime entropy
     ctx->runtime_entropy = get_runtime_entropy(ctx);
@@ -389,72 +1125,426 @@ uint64_t qrng_uint64(qrng_ctx *ctx) {
     result *= QRNG_SCHRODINGER;
     result ^= QRNG_PAULI_Z * (result >> 29);
     
+    *out = result;
+    return QRNG_SUCCESS;
+}
+
+uint64_t qrng_uint64(qrng_ctx *ctx) {
+    uint64_t result = 0;
+    qrng_uint64_checked(ctx, &result);
     return result;
 }
 
+qrng_error qrng_double_checked(qrng_ctx *ctx, double *out) {
+    if (!out) return QRNG_ERROR_NULL_BUFFER;
+
+    uint64_t bits;
+    qrng_error err = qrng_uint64_checked(ctx, &bits);
+    if (err != QRNG_SUCCESS) return err;
+
+    *out = (double)(bits >> 11) * (1.0/9007199254740992.0);
+    return QRNG_SUCCESS;
+}
+
 double qrng_double(qrng_ctx *ctx) {
-    if (!ctx) return 0.0;
-    return (double)(qrng_uint64(ctx) >> 11) * (1.0/9007199254740992.0);
+    double result = 0.0;
+    qrng_double_checked(ctx, &result);
+    return result;
 }
 
-int32_t qrng_range32(qrng_ctx *ctx, int32_t min, int32_t max) {
-    if (!ctx || min > max) {
-        return max;
+// Convert raw 64-bit words in place to doubles. Closed form gives [0,1) with
+// 53 bits, matching qrng_double(); open form gives (0,1) as (k + 0.5) * 2^-52.
+static void bits_to_f64(uint8_t *buf, size_t n, int open) {
+    const int shift = open ? 12 : 11;
+    const double bias = open ? 0.5 : 0.0;
+    const double scale = open ? 0x1.0p-52 : 0x1.0p-53;
+    size_t i = 0;
+
+#if defined(QRNG_SIMD_AVX512)
+    const __m128i vshift = _mm_cvtsi32_si128(shift);
+    const __m512d vbias = _mm512_set1_pd(bias);
+    const __m512d vscale = _mm512_set1_pd(scale);
+    for (; i + 8 <= n; i += 8) {
+        __m512i x = _mm512_srl_epi64(_mm512_loadu_si512(buf + i * 8), vshift);
+        __m512d d = _mm512_add_pd(_mm512_cvtepu64_pd(x), vbias);
+        _mm512_storeu_pd(buf + i * 8, _mm512_mul_pd(d, vscale));
     }
-    
-    uint32_t range = (uint32_t)(max - min + 1);
-    if (range == 0) {
-        return max;
+#elif defined(QRNG_SIMD_AVX2)
+    // No unsigned 64-bit convert on AVX2: splice the low 52 bits under the
+    // exponent of 2^52, subtract it back out, then add bit 52 separately.
+    const __m128i vshift = _mm_cvtsi32_si128(shift);
+    const __m256i mant = _mm256_set1_epi64x(0x000FFFFFFFFFFFFFLL);
+    const __m256i two52 = _mm256_set1_epi64x(0x4330000000000000LL);
+    const __m256i one = _mm256_set1_epi64x(1);
+    const __m256d vtwo52 = _mm256_castsi256_pd(two52);
+    const __m256d vbias = _mm256_set1_pd(bias);
+    const __m256d vscale = _mm256_set1_pd(scale);
+    for (; i + 4 <= n; i += 4) {
+        __m256i x = _mm256_srl_epi64(
+            _mm256_loadu_si256((const __m256i *)(buf + i * 8)), vshift);
+        __m256d lo = _mm256_sub_pd(_mm256_castsi256_pd(
+            _mm256_or_si256(_mm256_and_si256(x, mant), two52)), vtwo52);
+        __m256i top = _mm256_cmpeq_epi64(_mm256_srli_epi64(x, 52), one);
+        __m256d hi = _mm256_castsi256_pd(_mm256_and_si256(top, two52));
+        __m256d d = _mm256_add_pd(_mm256_add_pd(lo, hi), vbias);
+        _mm256_storeu_pd((double *)(buf + i * 8), _mm256_mul_pd(d, vscale));
+    }
+#endif
+
+    for (; i < n; i++) {
+        uint64_t x;
+        memcpy(&x, buf + i * 8, sizeof(x));
+        double d = ((double)(x >> shift) + bias) * scale;
+        memcpy(buf + i * 8, &d, sizeof(d));
+    }
+}
+
+// Convert raw 32-bit words in place to floats in [0,1) with 24 bits.
+static void bits_to_f32(uint8_t *buf, size_t n) {
+    size_t i = 0;
+
+#if defined(QRNG_SIMD_AVX512)
+    const __m512 vscale = _mm512_set1_ps(0x1.0p-24f);
+    for (; i + 16 <= n; i += 16) {
+        __m512i x = _mm512_srli_epi32(_mm512_loadu_si512(buf + i * 4), 8);
+        _mm512_storeu_ps(buf + i * 4, _mm512_mul_ps(_mm512_cvtepi32_ps(x), vscale));
+    }
+#elif defined(QRNG_SIMD_AVX2)
+    const __m256 vscale = _mm256_set1_ps(0x1.0p-24f);
+    for (; i + 8 <= n; i += 8) {
+        __m256i x = _mm256_srli_epi32(
+            _mm256_loadu_si256((const __m256i *)(buf + i * 4)), 8);
+        _mm256_storeu_ps((float *)(buf + i * 4),
+            _mm256_mul_ps(_mm256_cvtepi32_ps(x), vscale));
+    }
+#endif
+
+    for (; i < n; i++) {
+        uint32_t x;
+        memcpy(&x, buf + i * 4, sizeof(x));
+        float f = (float)(x >> 8) * 0x1.0p-24f;
+        memcpy(buf + i * 4, &f, sizeof(f));
     }
+}
+
+// Generate n elements of elem_size raw bits straight into caller memory
+static qrng_error fill_raw(qrng_ctx *ctx, void *out, size_t n, size_t elem_size) {
+    if (!ctx) return QRNG_ERROR_NULL_CONTEXT;
+    if (!out) return QRNG_ERROR_NULL_BUFFER;
+    if (n == 0 || n > SIZE_MAX / elem_size) return QRNG_ERROR_INVALID_LENGTH;
+    return qrng_bytes(ctx, (uint8_t *)out, n * elem_size);
+}
+
+qrng_error qrng_fill_u32(qrng_ctx *ctx, uint32_t *out, size_t n) {
+    return fill_raw(ctx, out, n, sizeof(uint32_t));
+}
+
+qrng_error qrng_fill_u64(qrng_ctx *ctx, uint64_t *out, size_t n) {
+    return fill_raw(ctx, out, n, sizeof(uint64_t));
+}
+
+qrng_error qrng_fill_f32(qrng_ctx *ctx, float *out, size_t n) {
+    qrng_error err = fill_raw(ctx, out, n, sizeof(float));
+    if (err != QRNG_SUCCESS) return err;
+    bits_to_f32((uint8_t *)out, n);
+    return QRNG_SUCCESS;
+}
+
+qrng_error qrng_fill_f64(qrng_ctx *ctx, double *out, size_t n) {
+    qrng_error err = fill_raw(ctx, out, n, sizeof(double));
+    if (err != QRNG_SUCCESS) return err;
+    bits_to_f64((uint8_t *)out, n, 0);
+    return QRNG_SUCCESS;
+}
+
+qrng_error qrng_fill_f64_open(qrng_ctx *ctx, double *out, size_t n) {
+    qrng_error err = fill_raw(ctx, out, n, sizeof(double));
+    if (err != QRNG_SUCCESS) return err;
+    bits_to_f64((uint8_t *)out, n, 1);
+    return QRNG_SUCCESS;
+}
+
+qrng_error qrng_range32_checked(qrng_ctx *ctx, int32_t min, int32_t max, int32_t *out) {
+    if (!ctx) return QRNG_ERROR_NULL_CONTEXT;
+    if (!out) return QRNG_ERROR_NULL_BUFFER;
+    if (min > max) return QRNG_ERROR_INVALID_RANGE;
     
-    uint32_t threshold = (uint32_t)-range % range;
+    uint32_t range = (uint32_t)max - (uint32_t)min + 1;
+    uint32_t threshold = range ? (uint32_t)-range % range : 0;
     uint32_t r;
     
     do {
-        r = (uint32_t)qrng_uint64(ctx);
+        uint64_t bits;
+        qrng_error err = qrng_uint64_checked(ctx, &bits);
+        if (err != QRNG_SUCCESS) return err;
+        r = (uint32_t)bits;
     } while (r < threshold);
     
-    return min + (r % range);
+    // A zero range is the full 32-bit span; every draw is in it
+    *out = (int32_t)((uint32_t)min + (range ? r % range : r));
+    return QRNG_SUCCESS;
 }
 
-uint64_t qrng_range64(qrng_ctx *ctx, uint64_t min, uint64_t max) {
-    if (!ctx || min > max) {
-        return max;
-    }
+int32_t qrng_range32(qrng_ctx *ctx, int32_t min, int32_t max) {
+    int32_t result = max;
+    qrng_range32_checked(ctx, min, max, &result);
+    return result;
+}
+
+qrng_error qrng_range64_checked(qrng_ctx *ctx, uint64_t min, uint64_t max, uint64_t *out) {
+    if (!ctx) return QRNG_ERROR_NULL_CONTEXT;
+    if (!out) return QRNG_ERROR_NULL_BUFFER;
+    if (min > max) return QRNG_ERROR_INVALID_RANGE;
     
     if (min == max) {
-        return min;
+        *out = min;
+        return QRNG_SUCCESS;
     }
     
     uint64_t range = max - min + 1;
-    if (range == 0) {
-        return max;
-    }
-    
-    uint64_t threshold = -range % range;
+    uint64_t threshold = range ? -range % range : 0;
     uint64_t r;
     
     do {
-        r = qrng_uint64(ctx);
+        qrng_error err = qrng_uint64_checked(ctx, &r);
+        if (err != QRNG_SUCCESS) return err;
     } while (r < threshold);
     
-    return min + (r % range);
+    *out = min + (range ? r % range : r);
+    return QRNG_SUCCESS;
+}
+
+uint64_t qrng_range64(qrng_ctx *ctx, uint64_t min, uint64_t max) {
+    uint64_t result = max;
+    qrng_range64_checked(ctx, min, max, &result);
+    return result;
+}
+
+// Raw draws taken per batch by the bounded array generators
+#define QRNG_RANGE_BATCH 256
+
+// Lemire's multiply-shift reduction over a batch of raw 32-bit draws. A draw
+// x maps to (x * range) >> 32 and is rejected when the low half falls below
+// threshold = 2^32 mod range. Accepted values are compacted into out, which
+// must have room for n values; returns the number written.
+static size_t lemire32_batch(const uint32_t *raw, size_t n, uint32_t range,
+                             uint32_t threshold, uint32_t base, uint32_t *out) {
+    size_t i = 0, k = 0;
+
+#if defined(QRNG_SIMD_AVX512)
+    const __m512i vrange = _mm512_set1_epi64(range);
+    const __m512i vthresh = _mm512_set1_epi64(threshold);
+    const __m512i lomask = _mm512_set1_epi64(0xFFFFFFFFLL);
+    const __m256i vbase = _mm256_set1_epi32((int)base);
+    for (; i + 8 <= n; i += 8) {
+        __m512i x = _mm512_cvtepu32_epi64(_mm256_loadu_si256((const __m256i *)(raw + i)));
+        __m512i m = _mm512_mul_epu32(x, vrange);
+        __mmask8 keep = _mm512_cmpge_epu64_mask(_mm512_and_si512(m, lomask), vthresh);
+        __m512i hi = _mm512_maskz_compress_epi64(keep, _mm512_srli_epi64(m, 32));
+        __m256i v = _mm256_add_epi32(_mm512_cvtepi64_epi32(hi), vbase);
+        int accepted = __builtin_popcount(keep);
+        _mm256_mask_storeu_epi32(out + k, (__mmask8)((1u << accepted) - 1), v);
+        k += (size_t)accepted;
+    }
+#endif
+
+    for (; i < n; i++) {
+        uint64_t m = (uint64_t)raw[i] * range;
+        out[k] = base + (uint32_t)(m >> 32);
+        k += (uint32_t)m >= threshold;
+    }
+    return k;
+}
+
+// 64-bit variant; the 128-bit products have no vector form, so this stays
+// scalar but branch-free
+static size_t lemire64_batch(const uint64_t *raw, size_t n, uint64_t range,
+                             uint64_t threshold, uint64_t base, uint64_t *out) {
+    size_t k = 0;
+    for (size_t i = 0; i < n; i++) {
+        unsigned __int128 m = (unsigned __int128)raw[i] * range;
+        out[k] = base + (uint64_t)(m >> 64);
+        k += (uint64_t)m >= threshold;
+    }
+    return k;
+}
+
+qrng_error qrng_range32_array(qrng_ctx *ctx, int32_t min, int32_t max,
+                              int32_t *out, size_t n) {
+    if (!ctx) return QRNG_ERROR_NULL_CONTEXT;
+    if (!out) return QRNG_ERROR_NULL_BUFFER;
+    if (n == 0) return QRNG_ERROR_INVALID_LENGTH;
+    if (min > max) return QRNG_ERROR_INVALID_RANGE;
+
+    // A range of 0 means the full 2^32 span, where every draw is accepted
+    uint32_t range = (uint32_t)max - (uint32_t)min + 1;
+    uint32_t threshold = range ? (uint32_t)-range % range : 0;
+    uint32_t raw[QRNG_RANGE_BATCH];
+    size_t filled = 0;
+
+    while (filled < n) {
+        size_t batch = n - filled;
+        if (batch > QRNG_RANGE_BATCH) batch = QRNG_RANGE_BATCH;
+
+        qrng_error err = qrng_fill_u32(ctx, raw, batch);
+        if (err != QRNG_SUCCESS) return err;
+
+        if (range == 0) {
+            for (size_t i = 0; i < batch; i++) {
+                out[filled + i] = (int32_t)(raw[i] + (uint32_t)min);
+            }
+            filled += batch;
+        } else {
+            filled += lemire32_batch(raw, batch, range, threshold,
+                (uint32_t)min, (uint32_t *)out + filled);
+        }
+    }
+
+    return QRNG_SUCCESS;
+}
+
+qrng_error qrng_range64_array(qrng_ctx *ctx, uint64_t min, uint64_t max,
+                              uint64_t *out, size_t n) {
+    if (!ctx) return QRNG_ERROR_NULL_CONTEXT;
+    if (!out) return QRNG_ERROR_NULL_BUFFER;
+    if (n == 0) return QRNG_ERROR_INVALID_LENGTH;
+    if (min > max) return QRNG_ERROR_INVALID_RANGE;
+
+    uint64_t range = max - min + 1;
+    uint64_t threshold = range ? -range % range : 0;
+    uint64_t raw[QRNG_RANGE_BATCH];
+    size_t filled = 0;
+
+    while (filled < n) {
+        size_t batch = n - filled;
+        if (batch > QRNG_RANGE_BATCH) batch = QRNG_RANGE_BATCH;
+
+        qrng_error err = qrng_fill_u64(ctx, raw, batch);
+        if (err != QRNG_SUCCESS) return err;
+
+        if (range == 0) {
+            for (size_t i = 0; i < batch; i++) {
+                out[filled + i] = raw[i] + min;
+            }
+            filled += batch;
+        } else {
+            filled += lemire64_batch(raw, batch, range, threshold, min, out + filled);
+        }
+    }
+
+    return QRNG_SUCCESS;
+}
+
+qrng_error qrng_attach_seed_queue(qrng_ctx *ctx, struct qrng_seed_queue *queue) {
+    if (!ctx) return QRNG_ERROR_NULL_CONTEXT;
+    ctx->seed_queue = queue;
+    return QRNG_SUCCESS;
+}
+
+// Both ring kinds share the partly served block
+static qrng_error alloc_ring_block(qrng_ctx *ctx) {
+    if (!ctx->ring_block) {
+        ctx->ring_block = aligned_alloc(64, QRNG_RING_BLOCK);
+        if (!ctx->ring_block) return QRNG_ERROR_NULL_BUFFER;
+        ctx->ring_pos = QRNG_RING_BLOCK;
+    }
+    return QRNG_SUCCESS;
+}
+
+qrng_error qrng_attach_block_ring(qrng_ctx *ctx, struct qrng_block_ring *ring) {
+    if (!ctx) return QRNG_ERROR_NULL_CONTEXT;
+    if (ring && alloc_ring_block(ctx) != QRNG_SUCCESS) return QRNG_ERROR_NULL_BUFFER;
+
+    ctx->block_ring = ring;
+    return QRNG_SUCCESS;
+}
+
+qrng_error qrng_attach_shm_ring(qrng_ctx *ctx, struct qrng_shm_ring *ring) {
+    if (!ctx) return QRNG_ERROR_NULL_CONTEXT;
+    if (ring && alloc_ring_block(ctx) != QRNG_SUCCESS) return QRNG_ERROR_NULL_BUFFER;
+
+    ctx->shm_ring = ring;
+    return QRNG_SUCCESS;
+}
+
+qrng_error qrng_set_conditioning(qrng_ctx *ctx, unsigned ratio) {
+    if (!ctx) return QRNG_ERROR_NULL_CONTEXT;
+    if (ratio > QRNG_MAX_CONDITIONING_RATIO) return QRNG_ERROR_INVALID_RANGE;
+
+    qrng_toeplitz *conditioner = NULL;
+    if (ratio > 1) {
+        // The extractor seed must not depend on the samples it conditions
+        size_t out_bits = QRNG_BUFFER_SIZE * 8;
+        size_t in_bits = out_bits * ratio;
+        uint8_t seed[QRNG_BUFFER_SIZE * (QRNG_MAX_CONDITIONING_RATIO + 1)];
+        size_t seed_len = qrng_toeplitz_seed_bytes(in_bits, out_bits);
+        if (read_os_entropy(seed, seed_len) != 0) return QRNG_ERROR_INSUFFICIENT_ENTROPY;
+
+        conditioner = qrng_toeplitz_create(seed, in_bits, out_bits);
+        memset(seed, 0, sizeof(seed));
+        if (!conditioner) return QRNG_ERROR_NULL_CONTEXT;
+    }
+
+    qrng_toeplitz_destroy(ctx->conditioner);
+    ctx->conditioner = conditioner;
+    ctx->conditioning_ratio = conditioner ? ratio : 1;
+    ctx->buffer_pos = QRNG_BUFFER_SIZE;
+    return QRNG_SUCCESS;
+}
+
+qrng_error qrng_set_background_refill(qrng_ctx *ctx, size_t pool_bytes) {
+    if (!ctx) return QRNG_ERROR_NULL_CONTEXT;
+
+    qrng_producer_destroy(ctx->producer);
+    ctx->producer = NULL;
+    if (pool_bytes == 0) return QRNG_SUCCESS;
+
+    ctx->producer = qrng_producer_create(ctx, pool_bytes, NULL);
+    return ctx->producer ? QRNG_SUCCESS : QRNG_ERROR_NULL_BUFFER;
+}
+
+qrng_error qrng_set_adaptive_refill(qrng_ctx *ctx, const qrng_refill_budget *budget) {
+    if (!ctx) return QRNG_ERROR_NULL_CONTEXT;
+
+    qrng_producer_destroy(ctx->producer);
+    ctx->producer = NULL;
+    if (!budget) return QRNG_SUCCESS;
+
+    ctx->producer = qrng_producer_create(ctx, QRNG_PRODUCER_MIN_BYTES, budget);
+    return ctx->producer ? QRNG_SUCCESS : QRNG_ERROR_NULL_BUFFER;
+}
+
+qrng_error qrng_get_refill_stats(qrng_ctx *ctx, qrng_refill_stats *stats) {
+    if (!ctx || !ctx->producer) return QRNG_ERROR_NULL_CONTEXT;
+    if (!stats) return QRNG_ERROR_NULL_BUFFER;
+
+    qrng_producer_get_stats(ctx->producer, stats);
+    return QRNG_SUCCESS;
+}
+
+size_t qrng_read_refill(qrng_ctx *ctx, uint8_t *out, size_t len) {
+    if (!ctx || !out) return 0;
+
+    size_t got = 0;
+    if (ctx->producer) {
+        got = qrng_producer_read(ctx->producer, out, len);
+    }
+    if (got < len && (ctx->block_ring || ctx->shm_ring)) {
+        got += ring_read(ctx, out + got, len - got);
+    }
+    return got;
 }
 
-double qrng_get_entropy_estimate(qrng_ctx *ctx) {
+double qrng_get_entropy_estimate(const qrng_ctx *ctx) {
     if (!ctx) return 0.0;
-    
-    // Calculate entropy estimate from the entropy pool
-    double entropy = 0.0;
-    for (int i = 0; i < 16; i++) {
-        entropy += -log2(ctx->entropy_pool[i] + 1e-10);
+
+    double estimate = qrng_health_min_entropy(ctx->health);
+    if (ctx->entropy_policy != QRNG_ENTROPY_POLICY_NONE) {
+        uint64_t credited = __atomic_load_n(&ctx->credited_bits, __ATOMIC_ACQUIRE);
+        uint64_t drawn = __atomic_load_n(&ctx->drawn_bits, __ATOMIC_ACQUIRE);
+        if (drawn > credited) estimate *= (double)credited / (double)drawn;
     }
-    
-    // Include runtime entropy in the estimate
-    ctx->runtime_entropy = get_runtime_entropy(ctx);
-    entropy += -log2((double)(ctx->runtime_entropy & 0xFF) / 256.0 + 1e-10);
-    
-    return entropy / 17.0;  // Average over all sources
+    return estimate;
 }
 
 qrng_error qrng_entangle_states(qrng_ctx *ctx, uint8_t *state1, uint8_t *state2, size_t len) {
@@ -495,32 +1585,282 @@ qrng_error qrng_entangle_states(qrng_ctx *ctx, uint8_t *state1, uint8_t *state2,
     return QRNG_SUCCESS;
 }
 
+qrng_error qrng_sim_attach(qrng_ctx *ctx, unsigned qubits) {
+    if (!ctx) return QRNG_ERROR_NULL_CONTEXT;
+    if (qubits == 0 || qubits > QRNG_SIM_MAX_QUBITS) return QRNG_ERROR_INVALID_RANGE;
+
+    if (ctx->sim && ctx->sim->qubits == qubits) {
+        qrng_state_reset(ctx->sim);
+        return QRNG_SUCCESS;
+    }
+
+    qrng_state *sim = qrng_state_create(qubits);
+    if (!sim) return QRNG_ERROR_NULL_BUFFER;
+
+    qrng_state_destroy(ctx->sim);
+    ctx->sim = sim;
+    return QRNG_SUCCESS;
+}
+
+void qrng_sim_detach(qrng_ctx *ctx) {
+    if (ctx) {
+        qrng_state_destroy(ctx->sim);
+        ctx->sim = NULL;
+    }
+}
+
+struct qrng_state *qrng_sim_state(qrng_ctx *ctx) {
+    return ctx ? ctx->sim : NULL;
+}
+
+qrng_error qrng_sim_measure(qrng_ctx *ctx, unsigned qubit, int *outcome) {
+    if (!ctx || !ctx->sim) return QRNG_ERROR_NULL_CONTEXT;
+    if (!outcome) return QRNG_ERROR_NULL_BUFFER;
+    if (qubit >= ctx->sim->qubits) return QRNG_ERROR_INVALID_RANGE;
+
+    double u;
+    qrng_error err = qrng_double_checked(ctx, &u);
+    if (err != QRNG_SUCCESS) return err;
+
+    *outcome = qrng_state_measure(ctx->sim, qubit, u);
+    return QRNG_SUCCESS;
+}
+
+qrng_error qrng_sim_measure_all(qrng_ctx *ctx, uint64_t *outcome) {
+    if (!ctx || !ctx->sim) return QRNG_ERROR_NULL_CONTEXT;
+    if (!outcome) return QRNG_ERROR_NULL_BUFFER;
+
+    double u;
+    qrng_error err = qrng_double_checked(ctx, &u);
+    if (err != QRNG_SUCCESS) return err;
+
+    *outcome = qrng_state_measure_all(ctx->sim, u);
+    return QRNG_SUCCESS;
+}
+
+qrng_error qrng_sample_shots(qrng_ctx *ctx, size_t shots, uint64_t *out) {
+    if (!ctx || !ctx->sim) return QRNG_ERROR_NULL_CONTEXT;
+    if (!out) return QRNG_ERROR_NULL_BUFFER;
+    if (shots == 0) return QRNG_SUCCESS;
+
+    double *uniforms = malloc(shots * sizeof(double));
+    if (!uniforms) return QRNG_ERROR_NULL_BUFFER;
+
+    qrng_error err = qrng_fill_f64(ctx, uniforms, shots);
+    if (err == QRNG_SUCCESS) {
+        err = qrng_state_sample(ctx->sim, uniforms, shots, out);
+    }
+    free(uniforms);
+    return err;
+}
+
+qrng_error qrng_get_health_stats(const qrng_ctx *ctx, qrng_health_stats *stats) {
+    if (!ctx) return QRNG_ERROR_NULL_CONTEXT;
+    if (!stats) return QRNG_ERROR_NULL_BUFFER;
+
+    qrng_health_get_stats(ctx->health, stats);
+    return QRNG_SUCCESS;
+}
+
+// Chunk-parallel entanglement. Each 64-byte chunk is keyed from its index
+// alone, so chunks carry no serial dependency and can be spread across
+// vector lanes and pool threads.
+#define QRNG_CHUNK_BYTES (QRNG_LANES * sizeof(uint64_t))
+#define QRNG_ENTANGLE_GRAIN 4096  // Chunks per pool task (256 KB)
+#define QRNG_MEASURE_BLOCK 4096   // Bytes measured per runtime entropy sample
+
+typedef struct {
+    uint8_t **states;
+    size_t k;
+    size_t len;
+    uint64_t key;
+    uint64_t phase_key;
+} entangle_job;
+
+// Entangle one chunk of k buffers. Each state is put into superposition
+// under the shared lane keys, then all of them take the same phase rotation,
+// derived from every state at this position. The first QRNG_ENTANGLE_HELD
+// superpositions stay on the stack; larger groups round-trip through memory.
+#define QRNG_ENTANGLE_HELD 8
+
+// Chunk loads and stores; full chunks take the fixed-size copy the compiler
+// turns into vector moves, partial ones are zero-padded
+static inline void load_chunk(uint64_t *dst, const uint8_t *src, size_t n) {
+    if (n == QRNG_CHUNK_BYTES) {
+        memcpy(dst, src, QRNG_CHUNK_BYTES);
+    } else {
+        memset(dst, 0, QRNG_CHUNK_BYTES);
+        memcpy(dst, src, n);
+    }
+}
+
+static inline void store_chunk(uint8_t *dst, const uint64_t *src, size_t n) {
+    if (n == QRNG_CHUNK_BYTES) {
+        memcpy(dst, src, QRNG_CHUNK_BYTES);
+    } else {
+        memcpy(dst, src, n);
+    }
+}
+
+static inline __attribute__((always_inline))
+void entangle_chunk(uint8_t **states, size_t k, size_t off, size_t n,
+                           uint64_t chunk_key, uint64_t phase_key) {
+    uint64_t held[QRNG_ENTANGLE_HELD][QRNG_LANES], phase[QRNG_LANES];
+
+    for (int l = 0; l < QRNG_LANES; l++) {
+        phase[l] = phase_key ^ ((uint64_t)l * QRNG_PAULI_Z);
+    }
+
+    // Superposition of each state
+    for (size_t i = 0; i < k; i++) {
+        uint64_t spill[QRNG_LANES];
+        uint64_t *s = i < QRNG_ENTANGLE_HELD ? held[i] : spill;
+
+        load_chunk(s, states[i] + off, n);
+        for (int l = 0; l < QRNG_LANES; l++) {
+            s[l] ^= chunk_key + (uint64_t)l * QRNG_GOLDEN_RATIO;
+        }
+        qrng_mix_lanes(s);
+        for (int l = 0; l < QRNG_LANES; l++) {
+            phase[l] ^= s[l];
+        }
+        if (s == spill) store_chunk(states[i] + off, s, n);
+    }
+
+    // Shared phase rotation correlates the group
+    qrng_mix_lanes(phase);
+    for (size_t i = 0; i < k; i++) {
+        uint64_t spill[QRNG_LANES];
+        uint64_t *s = i < QRNG_ENTANGLE_HELD ? held[i] : spill;
+
+        if (s == spill) load_chunk(s, states[i] + off, n);
+        for (int l = 0; l < QRNG_LANES; l++) {
+            s[l] ^= phase[l];
+        }
+        store_chunk(states[i] + off, s, n);
+    }
+}
+
+static void entangle_range(void *arg, size_t begin, size_t end) {
+    entangle_job *job = arg;
+
+    for (size_t c = begin; c < end; c++) {
+        uint64_t chunk_key = splitmix64(job->key ^ (c * QRNG_RYDBERG));
+        size_t off = c * QRNG_CHUNK_BYTES;
+        size_t n = job->len - off;
+        if (n > QRNG_CHUNK_BYTES) n = QRNG_CHUNK_BYTES;
+
+        // Pairs get their own instance with k known at compile time
+        if (job->k == 2) {
+            entangle_chunk(job->states, 2, off, n, chunk_key, job->phase_key);
+        } else {
+            entangle_chunk(job->states, job->k, off, n, chunk_key, job->phase_key);
+        }
+    }
+}
+
+// Shared body of the chunk-parallel entanglement entry points
+static void entangle_parallel(qrng_ctx *ctx, uint8_t **states, size_t k,
+                              size_t len, size_t nthreads) {
+    // One runtime entropy sample keys the whole call
+    ctx->counter++;
+    ctx->runtime_entropy = get_runtime_entropy(ctx);
+
+    entangle_job job = {
+        .states = states,
+        .k = k,
+        .len = len,
+        .key = hadamard_mix(splitmix64(ctx->counter * QRNG_GOLDEN_RATIO) ^ ctx->runtime_entropy),
+        .phase_key = hadamard_mix(ctx->pool_mixer ^ ctx->runtime_entropy ^ QRNG_SQRT2),
+    };
+
+    size_t chunks = (len + QRNG_CHUNK_BYTES - 1) / QRNG_CHUNK_BYTES;
+    qrng_parallel_for(chunks, QRNG_ENTANGLE_GRAIN, nthreads, entangle_range, &job);
+
+    // Update quantum state
+    for (int i = 0; i < QRNG_NUM_QUBITS; i++) {
+        ctx->quantum_state[i] = quantum_noise(
+            ctx->quantum_state[i] +
+            (double)ctx->runtime_entropy / UINT64_MAX
+        );
+    }
+}
+
+qrng_error qrng_entangle_states_parallel(qrng_ctx *ctx, uint8_t *state1, uint8_t *state2,
+                                         size_t len, size_t nthreads) {
+    if (!ctx) return QRNG_ERROR_NULL_CONTEXT;
+    if (!state1 || !state2) return QRNG_ERROR_NULL_BUFFER;
+    if (len == 0) return QRNG_ERROR_INVALID_LENGTH;
+
+    uint8_t *states[2] = { state1, state2 };
+    entangle_parallel(ctx, states, 2, len, nthreads);
+
+    return QRNG_SUCCESS;
+}
+
+qrng_error qrng_entangle_many(qrng_ctx *ctx, uint8_t **states, size_t k, size_t len) {
+    if (!ctx) return QRNG_ERROR_NULL_CONTEXT;
+    if (!states) return QRNG_ERROR_NULL_BUFFER;
+    if (k < 2 || len == 0) return QRNG_ERROR_INVALID_LENGTH;
+    for (size_t i = 0; i < k; i++) {
+        if (!states[i]) return QRNG_ERROR_NULL_BUFFER;
+    }
+
+    entangle_parallel(ctx, states, k, len, 0);
+
+    return QRNG_SUCCESS;
+}
+
+// Collapse a block of state bytes in place. Every 64-bit word is measured
+// against its own lane key, so the block is processed a vector at a time.
+static void collapse_block(uint8_t *state, size_t len, uint64_t key) {
+    uint64_t w[QRNG_LANES];
+    size_t off = 0;
+
+    for (; off < len; off += QRNG_CHUNK_BYTES) {
+        size_t n = len - off;
+        if (n > QRNG_CHUNK_BYTES) n = QRNG_CHUNK_BYTES;
+        load_chunk(w, state + off, n);
+
+        for (int l = 0; l < QRNG_LANES; l++) {
+            w[l] ^= key + (off / sizeof(uint64_t) + (size_t)l) * QRNG_GOLDEN_RATIO;
+        }
+        qrng_mix_lanes(w);
+        for (int l = 0; l < QRNG_LANES; l++) {
+            w[l] ^= key ^ (QRNG_PAULI_Y * (w[l] >> 29));
+        }
+        qrng_mix_lanes(w);
+
+        store_chunk(state + off, w, n);
+    }
+}
+
 qrng_error qrng_measure_state(qrng_ctx *ctx, uint8_t *state, size_t len) {
     if (!ctx) return QRNG_ERROR_NULL_CONTEXT;
     if (!state) return QRNG_ERROR_NULL_BUFFER;
     if (len == 0) return QRNG_ERROR_INVALID_LENGTH;
 
-    // Update runtime entropy
-    ctx->runtime_entropy = get_runtime_entropy(ctx);
-
-    // Measure each byte of the state
     uint64_t mixer = splitmix64(ctx->counter * QRNG_GOLDEN_RATIO);
-    
-    for (size_t i = 0; i < len; i++) {
-        // Create quantum state from byte
-        double quantum_val = quantum_noise(
-            (double)state[i] / 255.0 + 
+
+    // Measure block-wise: one runtime entropy sample and one pool update
+    // per block, then a vectorised collapse of every byte in it
+    for (size_t off = 0; off < len; off += QRNG_MEASURE_BLOCK) {
+        size_t n = len - off;
+        if (n > QRNG_MEASURE_BLOCK) n = QRNG_MEASURE_BLOCK;
+
+        ctx->runtime_entropy = get_runtime_entropy(ctx);
+
+        double collapsed = quantum_noise(
+            (double)state[off] / 255.0 +
             (double)ctx->runtime_entropy / UINT64_MAX
         );
-        
-        // Perform measurement
-        uint64_t measured = measure_state(ctx, quantum_val, mixer);
-        
-        // Collapse state to classical value
-        state[i] = (uint8_t)(measured & 0xFF);
-        
-        // Update mixer for next iteration
-        mixer = splitmix64(mixer ^ measured ^ ctx->runtime_entropy);
+        update_entropy_pool(ctx, collapsed);
+
+        uint64_t key = hadamard_mix(mixer ^ ctx->pool_mixer ^ ctx->runtime_entropy);
+        collapse_block(state + off, n, key);
+
+        // Update mixer for next block
+        mixer = splitmix64(mixer ^ key ^ ctx->runtime_entropy);
     }
 
     // Update quantum context state
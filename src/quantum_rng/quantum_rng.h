@@ -24,6 +24,7 @@
 #define QRNG_STATE_SIZE (QRNG_NUM_QUBITS * QRNG_STATE_MULTIPLIER)  /**< Total state size */
 #define QRNG_BUFFER_SIZE QRNG_STATE_SIZE  /**< Internal buffer size */
 #define QRNG_MIXING_ROUNDS 4           /**< Number of quantum mixing rounds */
+#define QRNG_PARALLEL_MIN_LEN (64 * 1024) /**< Buffer size where the parallel paths pay off */
 
 /**
  * @brief Error codes returned by library functions
@@ -37,6 +38,93 @@ typedef enum {
     QRNG_ERROR_INVALID_RANGE = -5      /**< Invalid range parameters */
 } qrng_error;
 
+/**
+ * @brief What to do when output would exceed the credited entropy
+ */
+typedef enum {
+    QRNG_ENTROPY_POLICY_NONE = 0,      /**< Account only, never hold back output */
+    QRNG_ENTROPY_POLICY_BLOCK = 1,     /**< Block on the OS for the missing entropy */
+    QRNG_ENTROPY_POLICY_RESEED = 2,    /**< Keep serving, reseed on a background thread */
+    QRNG_ENTROPY_POLICY_FAIL = 3       /**< Return QRNG_ERROR_INSUFFICIENT_ENTROPY */
+} qrng_entropy_policy;
+
+#define QRNG_RESEED_BYTES 32           /**< OS entropy pulled per background reseed */
+#define QRNG_MAX_CONDITIONING_RATIO 8  /**< Largest raw-to-output conditioning ratio */
+
+/**
+ * @brief Entropy accounting snapshot
+ */
+typedef struct {
+    uint64_t credited_bits;            /**< Credited by seeds, reseeds and sources */
+    uint64_t drawn_bits;               /**< Drawn by generated output */
+    int64_t available_bits;            /**< credited_bits - drawn_bits */
+    uint64_t reseeds;                  /**< Reseeds triggered by the policy */
+    uint64_t scheduled_reseeds;        /**< Reseeds applied by the schedule */
+    qrng_entropy_policy policy;        /**< Active policy */
+} qrng_entropy_budget;
+
+/**
+ * @brief Continuous health test counters
+ */
+typedef struct {
+    uint64_t windows;          /**< Chi-square windows evaluated */
+    uint64_t rct_failures;     /**< Repetition Count Test failures */
+    uint64_t apt_failures;     /**< Adaptive Proportion Test failures */
+    uint64_t chi_failures;     /**< Windows with p-value below QRNG_PVALUE_THRESH */
+    uint64_t failures;         /**< Refills rejected with QRNG_ERROR_INSUFFICIENT_ENTROPY */
+    double last_chi_square;    /**< Statistic of the last completed window */
+    double last_chi_pvalue;    /**< P-value of the last completed window */
+} qrng_health_stats;
+
+/**
+ * @brief Background refill pool counters
+ */
+typedef struct {
+    uint64_t capacity;         /**< Pool bytes, both halves */
+    uint64_t level;            /**< Bytes ready after the last read */
+    uint64_t low_water;        /**< Lowest level since the previous snapshot */
+    uint64_t high_water;       /**< Highest level since the previous snapshot */
+    uint64_t served;           /**< Bytes served from the pool */
+    uint64_t swaps;            /**< Halves drained and handed back */
+    uint64_t underflows;       /**< Reads that found the pool empty */
+    uint64_t refills;          /**< Halves filled by the producer */
+    uint64_t failures;         /**< Refills abandoned on a generator error */
+    double mean_refill_us;     /**< Mean time to fill one half */
+    int adaptive;              /**< Pool sized from demand */
+    uint64_t demand_bps;       /**< Bytes/s requested, EWMA */
+    uint64_t fill_bps;         /**< Bytes/s one refill thread fills, EWMA */
+    uint64_t target;           /**< Pool bytes the controller last chose */
+    uint64_t max_capacity;     /**< Memory budget, both halves */
+    uint32_t threads;          /**< Refill threads the controller last chose */
+    uint32_t max_threads;      /**< CPU budget */
+    uint64_t grows;            /**< Halves reallocated larger */
+    uint64_t shrinks;          /**< Halves reallocated smaller */
+    uint64_t thread_raises;    /**< Decisions to add refill threads */
+    uint64_t thread_cuts;      /**< Decisions to drop refill threads */
+    uint64_t clipped;          /**< Decisions capped by the memory or CPU budget */
+    uint64_t reclaims;         /**< Unread full halves dropped to shrink */
+} qrng_refill_stats;
+
+#define QRNG_REFILL_TARGET_MS 100  /**< Default demand held by each half */
+
+/**
+ * @brief Limits for demand-adaptive background refill
+ */
+typedef struct {
+    size_t max_bytes;          /**< Memory budget for both halves, clamped to 64 KiB..64 MiB */
+    size_t max_threads;        /**< CPU budget for refill threads, 0 for every usable CPU */
+    uint32_t target_ms;        /**< Demand each half holds, 0 for QRNG_REFILL_TARGET_MS */
+} qrng_refill_budget;
+
+struct qrng_health;
+struct qrng_toeplitz;
+struct qrng_seed_queue;
+struct qrng_core_state;
+struct qrng_state;
+struct qrng_producer;
+struct qrng_block_ring;
+struct qrng_shm_ring;
+
 /**
  * @brief Context structure for the RNG state
  */
@@ -59,13 +147,38 @@ typedef struct qrng_ctx_t {
     uint64_t unique_id;
     uint64_t system_entropy;
     uint64_t runtime_entropy;
+    struct qrng_health *health;        /**< Output estimators, updated on refill */
+    uint64_t credited_bits;            /**< Entropy credited (atomic) */
+    uint64_t drawn_bits;               /**< Entropy drawn by output (atomic) */
+    uint64_t reseed_count;             /**< Policy-driven reseeds (atomic) */
+    qrng_entropy_policy entropy_policy;
+    uint32_t reseed_state;             /**< Background reseed slot state (atomic) */
+    uint8_t reseed_seed[QRNG_RESEED_BYTES];
+    struct qrng_toeplitz *conditioner; /**< Extractor between measurement and buffer */
+    uint32_t conditioning_ratio;       /**< Raw words measured per output word */
+    struct qrng_seed_queue *seed_queue; /**< Conditioned seeds absorbed on refill */
+    uint64_t reseed_every_bytes;       /**< Scheduled reseed after this much output, 0 = off */
+    uint64_t reseed_every_ms;          /**< Scheduled reseed after this long, 0 = off */
+    uint64_t reseed_since_bytes;       /**< Output since the last scheduled reseed */
+    uint64_t reseed_last_ms;           /**< Time of the last scheduled reseed */
+    uint64_t scheduled_reseeds;        /**< Scheduled reseeds applied (atomic) */
+    uint32_t schedule_busy;            /**< Helper thread owns the next reseed (atomic) */
+    struct qrng_core_state *pending_state; /**< Precomputed state awaiting swap (atomic) */
+    uint32_t warmup_pending;           /**< Warm-up mixing deferred to the first refill */
+    struct qrng_state *sim;            /**< Attached state-vector simulator */
+    struct qrng_producer *producer;    /**< Background refill pool */
+    struct qrng_block_ring *block_ring; /**< Shared block supply, not owned */
+    struct qrng_shm_ring *shm_ring;    /**< Host-wide block supply, not owned */
+    uint8_t *ring_block;               /**< Partly served block from either ring */
+    size_t ring_pos;                   /**< Read offset within ring_block */
 } qrng_ctx;
 
 /**
  * @brief Initialize a new RNG context
  *
  * Creates and initializes a new quantum RNG context with the given seed.
- * The context must be freed with qrng_free() when no longer needed.
+ * The context must be freed with qrng_free() when no longer needed. Only
+ * the seed is credited, by its most-common-value min-entropy estimate.
  *
  * @param ctx[out] Pointer to context pointer to initialize
  * @param seed[in] Seed data for initialization
@@ -74,6 +187,56 @@ typedef struct qrng_ctx_t {
  */
 qrng_error qrng_init(qrng_ctx **ctx, const uint8_t *seed, size_t seed_len);
 
+/**
+ * @brief Initialize a new RNG context with minimal startup work
+ *
+ * Seeds the qubit registers from getrandom() and the optional caller seed
+ * through a Keccak sponge instead of simulating the circuit, and defers
+ * the warm-up mixing rounds to the first refill. Credits 256 bits for the
+ * OS seed plus the estimated min-entropy of the caller seed.
+ *
+ * @param ctx[out] Pointer to context pointer to initialize
+ * @param seed[in] Optional extra seed data, may be NULL
+ * @param seed_len Length of seed data in bytes
+ * @return QRNG_SUCCESS on success, error code on failure
+ */
+qrng_error qrng_init_fast(qrng_ctx **ctx, const uint8_t *seed, size_t seed_len);
+
+/**
+ * @brief Create an independent context split from a parent
+ *
+ * The child's registers are a domain-separated substream of the parent for
+ * the given index, the same derivation qrng_bytes_parallel() uses for its
+ * slices. Distinct indices give independent streams; the parent is only
+ * read, so several threads may split from it at once as long as none is
+ * generating from it. The child has its own health tests and entropy
+ * accounting, shares the parent's seed queue, and copies its reseed
+ * schedule and conditioning ratio. The child never runs the deferred
+ * warm-up of qrng_init_fast(); generate from such a parent once before
+ * splitting it.
+ *
+ * @param parent Context to split from
+ * @param index Substream index
+ * @param child[out] Receives the new context, freed with qrng_free()
+ * @return QRNG_SUCCESS on success, error code on failure
+ */
+qrng_error qrng_split(const qrng_ctx *parent, uint64_t index, qrng_ctx **child);
+
+/**
+ * @brief Fold a split context's health counters into its parent's
+ *
+ * For splits kept across requests: the counters and partial window the
+ * split gathered since the last merge move to ctx, so its health stats
+ * cover the output generated on the split. Call from the thread that owns
+ * ctx, while nothing generates from split.
+ *
+ * @param ctx Context the split was taken from
+ * @param split Split context
+ * @return QRNG_SUCCESS, or QRNG_ERROR_INSUFFICIENT_ENTROPY if a window
+ *         closed by the merge failed its chi-square test
+ */
+qrng_error qrng_merge_health(qrng_ctx *ctx, qrng_ctx *split);
+
 /**
  * @brief Free an RNG context
  *
@@ -86,7 +249,9 @@ void qrng_free(qrng_ctx *ctx);
 /**
  * @brief Reseed an existing RNG context
  *
- * Updates the internal state with new seed data.
+ * Absorbs the whole seed through a Keccak sponge, folds the digest into
+ * the internal state and credits the context with the seed's estimated
+ * min-entropy; a seed of repeated bytes credits nothing.
  *
  * @param ctx Context to reseed
  * @param seed New seed data
@@ -99,6 +264,10 @@ qrng_error qrng_reseed(qrng_ctx *ctx, const uint8_t *seed, size_t seed_len);
  * @brief Generate random bytes
  *
  * Fills the output buffer with random bytes generated using quantum simulation.
+ * Returns QRNG_ERROR_INSUFFICIENT_ENTROPY if a refill fails the continuous
+ * health tests; the output is then incomplete and the call may be retried.
+ * Each output byte draws 8 bits from the context's entropy budget, see
+ * qrng_set_entropy_policy().
  *
  * @param ctx RNG context
  * @param out Output buffer to fill
@@ -107,51 +276,548 @@ qrng_error qrng_reseed(qrng_ctx *ctx, const uint8_t *seed, size_t seed_len);
  */
 qrng_error qrng_bytes(qrng_ctx *ctx, uint8_t *out, size_t len);
 
+/**
+ * @brief Generate random bytes on several threads
+ *
+ * Splits large requests into fixed-size slices, each filled by a
+ * domain-separated substream derived from ctx, and fills the slices
+ * concurrently on the shared thread pool. The parent context then advances
+ * past all substreams, independent of scheduling. With a background
+ * refill pool attached, whatever the pool holds is served first and only
+ * the remainder is generated. Requests shorter than QRNG_PARALLEL_MIN_LEN
+ * are served by qrng_bytes().
+ *
+ * @param ctx RNG context
+ * @param out Output buffer to fill
+ * @param len Number of bytes to generate
+ * @param nthreads Maximum threads to use (0 for all pool threads)
+ * @return QRNG_SUCCESS on success, error code on failure
+ */
+qrng_error qrng_bytes_parallel(qrng_ctx *ctx, uint8_t *out, size_t len, size_t nthreads);
+
 /**
  * @brief Generate a random 64-bit unsigned integer
  *
  * @param ctx RNG context
- * @return Random uint64_t value
+ * @return Random uint64_t value, or 0 if generation failed
  */
 uint64_t qrng_uint64(qrng_ctx *ctx);
 
+/**
+ * @brief Generate a random 64-bit unsigned integer, reporting failures
+ *
+ * Fails where qrng_bytes() would, e.g. on a tripped health test or an
+ * overdrawn budget under QRNG_ENTROPY_POLICY_FAIL; out is left untouched.
+ *
+ * @param ctx RNG context
+ * @param out Receives the value
+ * @return QRNG_SUCCESS on success, error code on failure
+ */
+qrng_error qrng_uint64_checked(qrng_ctx *ctx, uint64_t *out);
+
 /**
  * @brief Generate a random double in [0,1)
  *
  * @param ctx RNG context
- * @return Random double between 0 (inclusive) and 1 (exclusive)
+ * @return Random double between 0 (inclusive) and 1 (exclusive), or 0 if
+ *         generation failed
  */
 double qrng_double(qrng_ctx *ctx);
 
+/**
+ * @brief Generate a random double in [0,1), reporting failures
+ *
+ * @param ctx RNG context
+ * @param out Receives the value
+ * @return QRNG_SUCCESS on success, error code on failure
+ */
+qrng_error qrng_double_checked(qrng_ctx *ctx, double *out);
+
+/**
+ * @brief Fill an array with random 32-bit unsigned integers
+ *
+ * Bits are generated directly into caller memory, without the per-value
+ * output mixing of qrng_uint64().
+ *
+ * @param ctx RNG context
+ * @param out Output array
+ * @param n Number of elements
+ * @return QRNG_SUCCESS on success, error code on failure
+ */
+qrng_error qrng_fill_u32(qrng_ctx *ctx, uint32_t *out, size_t n);
+
+/**
+ * @brief Fill an array with random 64-bit unsigned integers
+ *
+ * @param ctx RNG context
+ * @param out Output array
+ * @param n Number of elements
+ * @return QRNG_SUCCESS on success, error code on failure
+ */
+qrng_error qrng_fill_u64(qrng_ctx *ctx, uint64_t *out, size_t n);
+
+/**
+ * @brief Fill an array with random floats in [0,1)
+ *
+ * Each value carries 24 random bits.
+ *
+ * @param ctx RNG context
+ * @param out Output array
+ * @param n Number of elements
+ * @return QRNG_SUCCESS on success, error code on failure
+ */
+qrng_error qrng_fill_f32(qrng_ctx *ctx, float *out, size_t n);
+
+/**
+ * @brief Fill an array with random doubles in [0,1)
+ *
+ * Each value carries 53 random bits, as with qrng_double().
+ *
+ * @param ctx RNG context
+ * @param out Output array
+ * @param n Number of elements
+ * @return QRNG_SUCCESS on success, error code on failure
+ */
+qrng_error qrng_fill_f64(qrng_ctx *ctx, double *out, size_t n);
+
+/**
+ * @brief Fill an array with random doubles in (0,1)
+ *
+ * Never returns 0 or 1, which makes the output safe to pass to log().
+ *
+ * @param ctx RNG context
+ * @param out Output array
+ * @param n Number of elements
+ * @return QRNG_SUCCESS on success, error code on failure
+ */
+qrng_error qrng_fill_f64_open(qrng_ctx *ctx, double *out, size_t n);
+
 /**
  * @brief Generate a random integer in [min,max]
  *
  * @param ctx RNG context
  * @param min Minimum value (inclusive)
  * @param max Maximum value (inclusive)
- * @return Random integer in the specified range
+ * @return Random integer in the specified range, or max on error
  */
 int32_t qrng_range32(qrng_ctx *ctx, int32_t min, int32_t max);
 
+/**
+ * @brief Generate a random integer in [min,max], reporting failures
+ *
+ * @param ctx RNG context
+ * @param min Minimum value (inclusive)
+ * @param max Maximum value (inclusive)
+ * @param out Receives the value
+ * @return QRNG_SUCCESS on success, error code on failure
+ */
+qrng_error qrng_range32_checked(qrng_ctx *ctx, int32_t min, int32_t max, int32_t *out);
+
 /**
  * @brief Generate a random unsigned 64-bit integer in [min,max]
  *
  * @param ctx RNG context
  * @param min Minimum value (inclusive)
  * @param max Maximum value (inclusive)
- * @return Random integer in the specified range, or max+1 on error
+ * @return Random integer in the specified range, or max on error
  */
 uint64_t qrng_range64(qrng_ctx *ctx, uint64_t min, uint64_t max);
 
+/**
+ * @brief Generate a random unsigned 64-bit integer in [min,max], reporting
+ *        failures
+ *
+ * @param ctx RNG context
+ * @param min Minimum value (inclusive)
+ * @param max Maximum value (inclusive)
+ * @param out Receives the value
+ * @return QRNG_SUCCESS on success, error code on failure
+ */
+qrng_error qrng_range64_checked(qrng_ctx *ctx, uint64_t min, uint64_t max, uint64_t *out);
+
+/**
+ * @brief Fill an array with random integers in [min,max]
+ *
+ * Uses Lemire's multiply-shift reduction; the single modulo needed for the
+ * rejection threshold is computed once per call rather than per draw.
+ *
+ * @param ctx RNG context
+ * @param min Minimum value (inclusive)
+ * @param max Maximum value (inclusive)
+ * @param out Output array
+ * @param n Number of elements
+ * @return QRNG_SUCCESS on success, error code on failure
+ */
+qrng_error qrng_range32_array(qrng_ctx *ctx, int32_t min, int32_t max,
+                              int32_t *out, size_t n);
+
+/**
+ * @brief Fill an array with random unsigned 64-bit integers in [min,max]
+ *
+ * @param ctx RNG context
+ * @param min Minimum value (inclusive)
+ * @param max Maximum value (inclusive)
+ * @param out Output array
+ * @param n Number of elements
+ * @return QRNG_SUCCESS on success, error code on failure
+ */
+qrng_error qrng_range64_array(qrng_ctx *ctx, uint64_t min, uint64_t max,
+                              uint64_t *out, size_t n);
+
+/**
+ * @brief Calling thread's own context
+ *
+ * Nothing else in this API may be called on one context from two threads
+ * at once. Each thread instead gets a context of its own, created on first
+ * use by qrng_split() from a process-wide root seeded from the OS, and
+ * freed when the thread exits. After the first call this is a thread-local
+ * load with no locking. A child process forked from a thread that held a
+ * context gets a new root and new contexts, so it never repeats its
+ * parent's output.
+ *
+ * @return Context owned by the calling thread, or NULL if it could not be
+ *         created; do not pass it to qrng_free()
+ */
+qrng_ctx *qrng_tls_ctx(void);
+
+/**
+ * @brief qrng_bytes() on the calling thread's context
+ *
+ * Safe to call from any number of threads.
+ *
+ * @param out Output buffer to fill
+ * @param len Number of bytes to generate
+ * @return QRNG_SUCCESS on success, error code on failure
+ */
+qrng_error qrng_tls_bytes(uint8_t *out, size_t len);
+
+/**
+ * @brief qrng_uint64() on the calling thread's context
+ *
+ * @return Random 64-bit integer, 0 if no context could be created
+ */
+uint64_t qrng_tls_uint64(void);
+
+/**
+ * @brief qrng_double() on the calling thread's context
+ *
+ * @return Random double in [0,1), 0.0 if no context could be created
+ */
+double qrng_tls_double(void);
+
+/**
+ * @brief qrng_range32() on the calling thread's context
+ *
+ * @param min Minimum value (inclusive)
+ * @param max Maximum value (inclusive)
+ * @return Random integer in [min,max]
+ */
+int32_t qrng_tls_range32(int32_t min, int32_t max);
+
+/**
+ * @brief qrng_range64() on the calling thread's context
+ *
+ * @param min Minimum value (inclusive)
+ * @param max Maximum value (inclusive)
+ * @return Random integer in [min,max]
+ */
+uint64_t qrng_tls_range64(uint64_t min, uint64_t max);
+
+/**
+ * @brief qrng_fill_f64() on the calling thread's context
+ *
+ * @param out Output array
+ * @param n Number of doubles
+ * @return QRNG_SUCCESS on success, error code on failure
+ */
+qrng_error qrng_tls_fill_f64(double *out, size_t n);
+
 /**
  * @brief Get entropy estimate
  *
- * Returns an estimate of the entropy per bit in the RNG output.
+ * Returns the most-common-value min-entropy estimate over recent output,
+ * maintained incrementally by the refill path. Under an entropy policy
+ * other than QRNG_ENTROPY_POLICY_NONE, an overdrawn budget scales the
+ * estimate by credited/drawn. Reading it is O(1), lock-free and leaves the
+ * generator state untouched.
  *
  * @param ctx RNG context
  * @return Estimated entropy per bit (between 0 and 1)
  */
-double qrng_get_entropy_estimate(qrng_ctx *ctx);
+double qrng_get_entropy_estimate(const qrng_ctx *ctx);
+
+/**
+ * @brief Set the entropy accounting policy
+ *
+ * Every context tracks entropy credited by seeds and sources against
+ * entropy drawn by output. The policy decides what happens when a request
+ * would overdraw the budget: nothing (the default), block while the missing
+ * entropy is read from the OS, keep serving while a background thread
+ * fetches a reseed, or fail with QRNG_ERROR_INSUFFICIENT_ENTROPY. The
+ * budget carries over across policy changes.
+ *
+ * @param ctx RNG context
+ * @param policy New policy
+ * @return QRNG_SUCCESS on success, error code on failure
+ */
+qrng_error qrng_set_entropy_policy(qrng_ctx *ctx, qrng_entropy_policy policy);
+
+/**
+ * @brief Credit entropy gathered outside the context
+ *
+ * Safe to call from any thread.
+ *
+ * @param ctx RNG context
+ * @param bits Bits of entropy to credit
+ * @return QRNG_SUCCESS on success, error code on failure
+ */
+qrng_error qrng_credit_entropy(qrng_ctx *ctx, uint64_t bits);
+
+/**
+ * @brief Get the entropy budget
+ *
+ * Lock-free snapshot, safe to call from any thread.
+ *
+ * @param ctx RNG context
+ * @param budget[out] Receives the snapshot
+ * @return QRNG_SUCCESS on success, error code on failure
+ */
+qrng_error qrng_get_entropy_budget(const qrng_ctx *ctx, qrng_entropy_budget *budget);
+
+/**
+ * @brief Apply the entropy policy ahead of output generated elsewhere
+ *
+ * For output produced on a context split from this one, e.g. by a worker
+ * thread: the policy is applied here as if len bytes were about to be
+ * served, and the bytes are charged with qrng_charge_entropy() once they
+ * are delivered. Call from the thread that owns the context.
+ *
+ * @param ctx RNG context
+ * @param len Output bytes about to be generated
+ * @return QRNG_SUCCESS, or QRNG_ERROR_INSUFFICIENT_ENTROPY if the policy
+ *         refuses them
+ */
+qrng_error qrng_reserve_entropy(qrng_ctx *ctx, size_t len);
+
+/**
+ * @brief Charge output generated elsewhere against the budget
+ *
+ * Safe to call from any thread.
+ *
+ * @param ctx RNG context
+ * @param len Output bytes delivered
+ * @return QRNG_SUCCESS on success, error code on failure
+ */
+qrng_error qrng_charge_entropy(qrng_ctx *ctx, size_t len);
+
+/**
+ * @brief Reseed automatically by output volume or elapsed time
+ *
+ * When either threshold is crossed, a helper thread reads QRNG_RESEED_BYTES
+ * of OS entropy and runs the full qrng_reseed() mixing on a copy of the
+ * state. At the next refill boundary the finished state is folded into the
+ * live one, keeping whatever the context absorbed in the meantime, so
+ * requests never wait on the reseed. Each scheduled reseed credits
+ * QRNG_RESEED_BYTES * 8 bits.
+ *
+ * @param ctx RNG context
+ * @param bytes Reseed after this many output bytes, 0 to disable
+ * @param interval_ms Reseed after this many milliseconds, 0 to disable
+ * @return QRNG_SUCCESS on success, error code on failure
+ */
+qrng_error qrng_set_reseed_schedule(qrng_ctx *ctx, uint64_t bytes, uint64_t interval_ms);
+
+/**
+ * @brief Absorb seeds from a background entropy collector
+ *
+ * Every refill pops at most one seed from the queue without blocking,
+ * folds it into the state and credits its entropy. The queue is not owned
+ * by the context and must outlive it or be detached first. Several contexts
+ * may share one queue.
+ *
+ * @param ctx RNG context
+ * @param queue Seed queue, or NULL to detach
+ * @return QRNG_SUCCESS on success, error code on failure
+ */
+qrng_error qrng_attach_seed_queue(qrng_ctx *ctx, struct qrng_seed_queue *queue);
+
+/**
+ * @brief Serve output from a shared block ring
+ *
+ * qrng_bytes() and the functions built on it take whole blocks from the
+ * ring, keeping a partly used block for the next call, and generate inline
+ * only when the ring is empty. The ring is not owned by the context and
+ * must outlive it or be detached first. Any number of contexts, one per
+ * thread, may share one ring.
+ *
+ * @param ctx RNG context
+ * @param ring Block ring, or NULL to detach
+ * @return QRNG_SUCCESS on success, error code on failure
+ */
+qrng_error qrng_attach_block_ring(qrng_ctx *ctx, struct qrng_block_ring *ring);
+
+/**
+ * @brief Serve output from a block ring shared between processes
+ *
+ * Works like qrng_attach_block_ring(), with blocks from a shm_ring.h
+ * segment. When both rings are attached the process-local one is tried
+ * first. The ring handle must outlive the context or be detached first.
+ *
+ * @param ctx RNG context
+ * @param ring Shared-memory ring handle, or NULL to detach
+ * @return QRNG_SUCCESS on success, error code on failure
+ */
+qrng_error qrng_attach_shm_ring(qrng_ctx *ctx, struct qrng_shm_ring *ring);
+
+/**
+ * @brief Enable or disable output conditioning
+ *
+ * With a ratio above 1, every refill measures ratio times as many raw words
+ * and compresses them into the buffer with a Toeplitz-hash extractor keyed
+ * from OS entropy. Throughput drops by roughly the ratio. A ratio of 0 or 1
+ * disables conditioning.
+ *
+ * @param ctx RNG context
+ * @param ratio Raw-to-output ratio, at most QRNG_MAX_CONDITIONING_RATIO
+ * @return QRNG_SUCCESS on success, error code on failure
+ */
+qrng_error qrng_set_conditioning(qrng_ctx *ctx, unsigned ratio);
+
+/**
+ * @brief Serve output from a pool filled by a background thread
+ *
+ * A producer thread seeded from this context keeps a double-buffered pool
+ * of pool_bytes filled. qrng_bytes(), qrng_bytes_parallel() and the
+ * functions built on them copy from the pool first and generate inline
+ * only when it runs dry. Call
+ * after configuring the seed queue, schedule and conditioning, which the
+ * producer copies. Not safe while another thread is generating from ctx.
+ *
+ * @param ctx RNG context
+ * @param pool_bytes Pool size, clamped to 64 KiB..64 MiB, or 0 to stop the
+ *                   producer
+ * @return QRNG_SUCCESS on success, error code on failure
+ */
+qrng_error qrng_set_background_refill(qrng_ctx *ctx, size_t pool_bytes);
+
+/**
+ * @brief Serve output from a background pool sized to demand
+ *
+ * As qrng_set_background_refill(), but the pool starts at its minimum and
+ * the producer resizes it and the number of threads filling it from the
+ * measured consumption rate, within the budget. The decisions are
+ * reported by qrng_get_refill_stats().
+ *
+ * @param ctx RNG context
+ * @param budget Memory and CPU limits, or NULL to stop the producer
+ * @return QRNG_SUCCESS on success, error code on failure
+ */
+qrng_error qrng_set_adaptive_refill(qrng_ctx *ctx, const qrng_refill_budget *budget);
+
+/**
+ * @brief Get background refill pool counters
+ *
+ * The watermarks cover the interval since the previous call.
+ *
+ * @param ctx RNG context with background refill enabled
+ * @param stats[out] Receives the counters
+ * @return QRNG_SUCCESS on success, error code on failure
+ */
+qrng_error qrng_get_refill_stats(qrng_ctx *ctx, qrng_refill_stats *stats);
+
+/**
+ * @brief Take whatever the background refill pool and block rings have ready
+ *
+ * For callers that generate the rest of a request elsewhere, e.g. on a
+ * split context, which has neither attached: the pool is read first, then
+ * any attached block ring or shm ring. The whole len counts towards the
+ * demand the pool is sized to, however much is copied. Nothing is charged
+ * against the entropy budget; see qrng_reserve_entropy(). Call from the
+ * thread that owns ctx.
+ *
+ * @param ctx RNG context
+ * @param out Output buffer
+ * @param len Bytes wanted
+ * @return Bytes copied, 0 with neither a pool nor a ring
+ */
+size_t qrng_read_refill(qrng_ctx *ctx, uint8_t *out, size_t len);
+
+/**
+ * @brief Attach a fresh state-vector simulator
+ *
+ * Replaces any attached register with n qubits in |0...0>, reusing its
+ * memory when the size is unchanged. Gates are
+ * applied to qrng_sim_state() with the statevector.h API; measurements go
+ * through the context, which supplies their randomness.
+ *
+ * @param ctx RNG context
+ * @param qubits Register size, 1 to QRNG_SIM_MAX_QUBITS
+ * @return QRNG_SUCCESS on success, error code on failure
+ */
+qrng_error qrng_sim_attach(qrng_ctx *ctx, unsigned qubits);
+
+/**
+ * @brief Free the attached simulator
+ *
+ * @param ctx RNG context
+ */
+void qrng_sim_detach(qrng_ctx *ctx);
+
+/**
+ * @brief Attached simulator register
+ *
+ * @param ctx RNG context
+ * @return Register, or NULL if none is attached
+ */
+struct qrng_state *qrng_sim_state(qrng_ctx *ctx);
+
+/**
+ * @brief Measure one simulated qubit
+ *
+ * @param ctx RNG context with an attached simulator
+ * @param qubit Qubit to measure
+ * @param outcome[out] Receives 0 or 1
+ * @return QRNG_SUCCESS on success, error code on failure
+ */
+qrng_error qrng_sim_measure(qrng_ctx *ctx, unsigned qubit, int *outcome);
+
+/**
+ * @brief Measure the whole simulated register
+ *
+ * @param ctx RNG context with an attached simulator
+ * @param outcome[out] Receives the basis index
+ * @return QRNG_SUCCESS on success, error code on failure
+ */
+qrng_error qrng_sim_measure_all(qrng_ctx *ctx, uint64_t *outcome);
+
+/**
+ * @brief Sample measurement shots from the simulated register
+ *
+ * Draws every shot's uniform in one vectorised qrng_fill_f64() call and
+ * samples them with qrng_state_sample(). The register is left as it was.
+ *
+ * @param ctx RNG context with an attached simulator
+ * @param shots Number of shots
+ * @param out[out] Receives the basis index of each shot
+ * @return QRNG_SUCCESS on success, error code on failure
+ */
+qrng_error qrng_sample_shots(qrng_ctx *ctx, size_t shots, uint64_t *out);
+
+/**
+ * @brief Get continuous health test counters
+ *
+ * Every refill runs the SP 800-90B Repetition Count and Adaptive Proportion
+ * tests, and every QRNG_ESTIMATOR_WINDOW bytes a chi-square test. All
+ * three are tuned to a false positive rate of 2^-QRNG_HEALTH_ALPHA_LOG2;
+ * windows below QRNG_PVALUE_THRESH are counted but do not fail on their
+ * own. A refill that fails is discarded and the generating call returns
+ * QRNG_ERROR_INSUFFICIENT_ENTROPY. Safe to call from any thread.
+ *
+ * @param ctx RNG context
+ * @param stats[out] Receives the counters
+ * @return QRNG_SUCCESS on success, error code on failure
+ */
+qrng_error qrng_get_health_stats(const qrng_ctx *ctx, qrng_health_stats *stats);
 
 /**
  * @brief Entangle two quantum states
@@ -167,11 +833,46 @@ double qrng_get_entropy_estimate(qrng_ctx *ctx);
  */
 qrng_error qrng_entangle_states(qrng_ctx *ctx, uint8_t *state1, uint8_t *state2, size_t len);
 
+/**
+ * @brief Entangle two large quantum states in parallel
+ *
+ * Vectorised, chunk-parallel form of qrng_entangle_states(). Every 64-byte
+ * chunk is keyed independently from its index, so chunks are processed
+ * across SIMD lanes and pool threads with no serial mixer chain. Preferred
+ * for buffers of QRNG_PARALLEL_MIN_LEN bytes or more.
+ *
+ * @param ctx RNG context
+ * @param state1 First state buffer
+ * @param state2 Second state buffer
+ * @param len Length of state buffers
+ * @param nthreads Maximum threads to use (0 for all pool threads)
+ * @return QRNG_SUCCESS on success, error code on failure
+ */
+qrng_error qrng_entangle_states_parallel(qrng_ctx *ctx, uint8_t *state1, uint8_t *state2,
+                                         size_t len, size_t nthreads);
+
+/**
+ * @brief Entangle a group of quantum states
+ *
+ * Correlates k equally sized buffers in a single pass. Every position takes
+ * a phase rotation shared by the whole group, derived from all k states, so
+ * this replaces k-1 pairwise qrng_entangle_states() calls.
+ *
+ * @param ctx RNG context
+ * @param states Array of k state buffers
+ * @param k Number of buffers (at least 2)
+ * @param len Length of each state buffer
+ * @return QRNG_SUCCESS on success, error code on failure
+ */
+qrng_error qrng_entangle_many(qrng_ctx *ctx, uint8_t **states, size_t k, size_t len);
+
 /**
  * @brief Measure a quantum state
  *
  * Performs a quantum measurement on the given state buffer, collapsing
- * superpositions into definite values.
+ * superpositions into definite values. The buffer is measured in blocks,
+ * with one runtime entropy sample per block, so cost scales with memory
+ * bandwidth rather than per-byte clock reads.
  *
  * @param ctx RNG context
  * @param state State buffer to measure
@@ -0,0 +1,109 @@
+#include "quantum_rng.h"
+#include <pthread.h>
+#include <stdlib.h>
+
+// Per-thread contexts split from a process-wide root. The root is only ever
+// split from, never generated from, so concurrent splits need no lock; a
+// distinct index per thread comes from one atomic counter.
+static qrng_ctx *tls_root;             // atomic
+static uint64_t tls_next_index;        // atomic
+static pthread_key_t tls_key;
+static pthread_once_t tls_once = PTHREAD_ONCE_INIT;
+static __thread qrng_ctx *tls_ctx;
+
+// Destructors of other keys may still run on this thread afterwards and
+// reach qrng_tls_ctx(); they get a new context rather than a freed one
+static void tls_destroy(void *ctx) {
+    tls_ctx = NULL;
+    qrng_free(ctx);
+}
+
+// In a forked child only the forking thread survives, holding copies of
+// the parent's root and its own context. Drop both so the child derives
+// fresh streams instead of replaying the parent's.
+static void tls_after_fork(void) {
+    qrng_ctx *root = __atomic_exchange_n(&tls_root, NULL, __ATOMIC_ACQ_REL);
+    qrng_free(root);
+    if (tls_ctx) {
+        pthread_setspecific(tls_key, NULL);
+        qrng_free(tls_ctx);
+        tls_ctx = NULL;
+    }
+}
+
+static void tls_setup(void) {
+    pthread_key_create(&tls_key, tls_destroy);
+    pthread_atfork(NULL, NULL, tls_after_fork);
+}
+
+static qrng_ctx *tls_get_root(void) {
+    qrng_ctx *root = __atomic_load_n(&tls_root, __ATOMIC_ACQUIRE);
+    if (root) return root;
+
+    qrng_ctx *fresh = NULL;
+    if (qrng_init_fast(&fresh, NULL, 0) != QRNG_SUCCESS) return NULL;
+
+    // Splits skip the deferred warm-up, so run it once here, while the
+    // root is still private: the first draw mixes its registers
+    uint64_t discard;
+    if (qrng_bytes(fresh, (uint8_t *)&discard, sizeof(discard)) != QRNG_SUCCESS) {
+        qrng_free(fresh);
+        return NULL;
+    }
+
+    // Racing first callers each build one; a single root is published
+    if (!__atomic_compare_exchange_n(&tls_root, &root, fresh, 0,
+                                     __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE)) {
+        qrng_free(fresh);
+        return root;
+    }
+    return fresh;
+}
+
+static qrng_ctx *tls_create(void) {
+    pthread_once(&tls_once, tls_setup);
+
+    qrng_ctx *root = tls_get_root();
+    if (!root) return NULL;
+
+    qrng_ctx *ctx = NULL;
+    uint64_t index = __atomic_fetch_add(&tls_next_index, 1, __ATOMIC_RELAXED);
+    if (qrng_split(root, index, &ctx) != QRNG_SUCCESS) return NULL;
+
+    if (pthread_setspecific(tls_key, ctx) != 0) {
+        qrng_free(ctx);
+        return NULL;
+    }
+    tls_ctx = ctx;
+    return ctx;
+}
+
+qrng_ctx *qrng_tls_ctx(void) {
+    qrng_ctx *ctx = tls_ctx;
+    if (__builtin_expect(ctx != NULL, 1)) return ctx;
+    return tls_create();
+}
+
+qrng_error qrng_tls_bytes(uint8_t *out, size_t len) {
+    return qrng_bytes(qrng_tls_ctx(), out, len);
+}
+
+uint64_t qrng_tls_uint64(void) {
+    return qrng_uint64(qrng_tls_ctx());
+}
+
+double qrng_tls_double(void) {
+    return qrng_double(qrng_tls_ctx());
+}
+
+int32_t qrng_tls_range32(int32_t min, int32_t max) {
+    return qrng_range32(qrng_tls_ctx(), min, max);
+}
+
+uint64_t qrng_tls_range64(uint64_t min, uint64_t max) {
+    return qrng_range64(qrng_tls_ctx(), min, max);
+}
+
+qrng_error qrng_tls_fill_f64(double *out, size_t n) {
+    return qrng_fill_f64(qrng_tls_ctx(), out, n);
+}
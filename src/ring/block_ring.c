@@ -0,0 +1,225 @@
+#include "block_ring.h"
+#include "region.h"
+#include "futex.h"
+#include <pthread.h>
+#include <sched.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+// One slot. seq == pos: free for the producer claiming pos; seq == pos + 1:
+// filled for the consumer claiming pos; a consumer frees it for the next lap
+// with pos + capacity. The header line keeps neighbouring sequence numbers
+// off each other's cache lines.
+typedef struct {
+    uint64_t seq;                      // atomic
+    uint8_t pad[56];
+    uint8_t data[QRNG_RING_BLOCK];
+} ring_cell;
+
+typedef struct {
+    qrng_block_ring *ring;
+    qrng_ctx *ctx;                     // Used only by this refill thread
+    pthread_t thread;
+} ring_producer;
+
+struct qrng_block_ring {
+    qrng_region mem;
+    ring_cell *cells;
+    size_t mask;
+    unsigned producers;
+    ring_producer *threads;
+
+    uint64_t enqueue_pos __attribute__((aligned(64)));   // atomic
+    uint64_t dequeue_pos __attribute__((aligned(64)));   // atomic
+
+    // Refill threads sleep on wake while the ring is above half full
+    uint32_t wake __attribute__((aligned(64)));          // atomic, futex word
+    uint32_t sleepers;                 // atomic
+    uint32_t stop;                     // atomic
+    uint64_t misses;                   // atomic
+    uint64_t sleeps;                   // atomic
+    uint64_t failures;                 // atomic
+};
+
+static size_t ring_depth(qrng_block_ring *r) {
+    uint64_t head = __atomic_load_n(&r->dequeue_pos, __ATOMIC_SEQ_CST);
+    uint64_t tail = __atomic_load_n(&r->enqueue_pos, __ATOMIC_SEQ_CST);
+    return tail > head ? (size_t)(tail - head) : 0;
+}
+
+int qrng_block_ring_push(qrng_block_ring *r, const uint8_t *block) {
+    uint64_t pos = __atomic_load_n(&r->enqueue_pos, __ATOMIC_RELAXED);
+    ring_cell *cell;
+
+    for (;;) {
+        cell = &r->cells[pos & r->mask];
+        uint64_t seq = __atomic_load_n(&cell->seq, __ATOMIC_ACQUIRE);
+        int64_t diff = (int64_t)(seq - pos);
+        if (diff == 0) {
+            if (__atomic_compare_exchange_n(&r->enqueue_pos, &pos, pos + 1, 1,
+                                            __ATOMIC_RELAXED, __ATOMIC_RELAXED)) {
+                break;
+            }
+        } else if (diff < 0) {
+            return -1;
+        } else {
+            pos = __atomic_load_n(&r->enqueue_pos, __ATOMIC_RELAXED);
+        }
+    }
+
+    memcpy(cell->data, block, QRNG_RING_BLOCK);
+    __atomic_store_n(&cell->seq, pos + 1, __ATOMIC_RELEASE);
+    return 0;
+}
+
+int qrng_block_ring_pop(qrng_block_ring *r, uint8_t *out) {
+    uint64_t pos = __atomic_load_n(&r->dequeue_pos, __ATOMIC_RELAXED);
+    ring_cell *cell;
+
+    for (;;) {
+        cell = &r->cells[pos & r->mask];
+        uint64_t seq = __atomic_load_n(&cell->seq, __ATOMIC_ACQUIRE);
+        int64_t diff = (int64_t)(seq - (pos + 1));
+        if (diff == 0) {
+            if (__atomic_compare_exchange_n(&r->dequeue_pos, &pos, pos + 1, 1,
+                                            __ATOMIC_RELAXED, __ATOMIC_RELAXED)) {
+                break;
+            }
+        } else if (diff < 0) {
+            __atomic_fetch_add(&r->misses, 1, __ATOMIC_RELAXED);
+            return -1;
+        } else {
+            pos = __atomic_load_n(&r->dequeue_pos, __ATOMIC_RELAXED);
+        }
+    }
+
+    memcpy(out, cell->data, QRNG_RING_BLOCK);
+    __atomic_store_n(&cell->seq, pos + r->mask + 1, __ATOMIC_RELEASE);
+
+    // Wake sleeping refill threads once the ring is half drained. The read
+    // of sleepers is a read-modify-write so it is ordered after our cursor
+    // update, pairing with the increment in wait_for_space().
+    if (ring_depth(r) <= (r->mask + 1) / 2) {
+        if (__atomic_fetch_add(&r->sleepers, 0, __ATOMIC_SEQ_CST)) {
+            __atomic_fetch_add(&r->wake, 1, __ATOMIC_RELEASE);
+            qrng_futex_wake(&r->wake, 0);
+        }
+    }
+    return 0;
+}
+
+static void wait_for_space(qrng_block_ring *r) {
+    __atomic_fetch_add(&r->sleepers, 1, __ATOMIC_SEQ_CST);
+    uint32_t seen = __atomic_load_n(&r->wake, __ATOMIC_SEQ_CST);
+
+    if (__atomic_load_n(&r->stop, __ATOMIC_ACQUIRE)) {
+        // Shutting down
+    } else if (ring_depth(r) > (r->mask + 1) / 2) {
+        __atomic_fetch_add(&r->sleeps, 1, __ATOMIC_RELAXED);
+        qrng_futex_wait(&r->wake, seen, 0);
+    } else {
+        // A consumer is still copying out the slot we need
+        sched_yield();
+    }
+    __atomic_fetch_sub(&r->sleepers, 1, __ATOMIC_RELAXED);
+}
+
+static void *refill_thread(void *arg) {
+    ring_producer *rp = arg;
+    qrng_block_ring *r = rp->ring;
+    uint8_t block[QRNG_RING_BLOCK] __attribute__((aligned(64)));
+
+    while (!__atomic_load_n(&r->stop, __ATOMIC_ACQUIRE)) {
+        if (qrng_bytes(rp->ctx, block, sizeof(block)) != QRNG_SUCCESS) {
+            // Generation refused, e.g. by a failing health test; back off
+            __atomic_fetch_add(&r->failures, 1, __ATOMIC_RELAXED);
+            struct timespec pause = { 0, 10 * 1000 * 1000 };
+            nanosleep(&pause, NULL);
+            continue;
+        }
+
+        while (qrng_block_ring_push(r, block) != 0) {
+            if (__atomic_load_n(&r->stop, __ATOMIC_ACQUIRE)) break;
+            wait_for_space(r);
+        }
+    }
+    memset(block, 0, sizeof(block));
+    return NULL;
+}
+
+qrng_block_ring *qrng_block_ring_create(qrng_ctx *root, size_t blocks, unsigned producers) {
+    if (producers > QRNG_RING_MAX_PRODUCERS || (producers && !root)) return NULL;
+
+    size_t capacity = QRNG_RING_MIN_BLOCKS;
+    while (capacity < blocks && capacity < QRNG_RING_MAX_BLOCKS) capacity <<= 1;
+
+    qrng_block_ring *r = aligned_alloc(64, sizeof(qrng_block_ring));
+    if (!r) return NULL;
+    memset(r, 0, sizeof(*r));
+    r->mask = capacity - 1;
+
+    if (qrng_region_alloc(&r->mem, capacity * sizeof(ring_cell), 0) != 0) {
+        free(r);
+        return NULL;
+    }
+    r->cells = r->mem.base;
+    for (size_t i = 0; i < capacity; i++) r->cells[i].seq = i;
+
+    if (producers == 0) return r;
+
+    r->threads = calloc(producers, sizeof(ring_producer));
+    if (!r->threads) {
+        qrng_block_ring_destroy(r);
+        return NULL;
+    }
+
+    // A fresh base keeps rings created from the same root apart
+    uint64_t base;
+    if (qrng_uint64_checked(root, &base) != QRNG_SUCCESS) {
+        qrng_block_ring_destroy(r);
+        return NULL;
+    }
+    for (unsigned i = 0; i < producers; i++) {
+        ring_producer *rp = &r->threads[i];
+        rp->ring = r;
+        if (qrng_split(root, base + i, &rp->ctx) != QRNG_SUCCESS ||
+            pthread_create(&rp->thread, NULL, refill_thread, rp) != 0) {
+            qrng_free(rp->ctx);
+            rp->ctx = NULL;
+            qrng_block_ring_destroy(r);
+            return NULL;
+        }
+        r->producers++;
+    }
+    return r;
+}
+
+void qrng_block_ring_destroy(qrng_block_ring *r) {
+    if (!r) return;
+
+    __atomic_store_n(&r->stop, 1, __ATOMIC_RELEASE);
+    __atomic_fetch_add(&r->wake, 1, __ATOMIC_RELEASE);
+    qrng_futex_wake(&r->wake, 0);
+    for (unsigned i = 0; i < r->producers; i++) {
+        pthread_join(r->threads[i].thread, NULL);
+        qrng_free(r->threads[i].ctx);
+    }
+
+    free(r->threads);
+    qrng_region_free(&r->mem);
+    free(r);
+}
+
+void qrng_block_ring_get_stats(qrng_block_ring *r, qrng_block_ring_stats *stats) {
+    if (!r || !stats) return;
+
+    stats->capacity = r->mask + 1;
+    stats->depth = ring_depth(r);
+    stats->producers = r->producers;
+    stats->pushed = __atomic_load_n(&r->enqueue_pos, __ATOMIC_RELAXED);
+    stats->popped = __atomic_load_n(&r->dequeue_pos, __ATOMIC_RELAXED);
+    stats->misses = __atomic_load_n(&r->misses, __ATOMIC_RELAXED);
+    stats->sleeps = __atomic_load_n(&r->sleeps, __ATOMIC_RELAXED);
+    stats->failures = __atomic_load_n(&r->failures, __ATOMIC_RELAXED);
+}
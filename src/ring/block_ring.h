@@ -0,0 +1,100 @@
+#ifndef QUANTUM_BLOCK_RING_H
+#define QUANTUM_BLOCK_RING_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include "quantum_rng.h"
+
+/**
+ * @file block_ring.h
+ * @brief Lock-free multi-producer multi-consumer ring of random blocks
+ *
+ * A bounded ring of QRNG_RING_BLOCK-byte blocks after Vyukov's MPMC queue:
+ * every cell carries a sequence number that tells producers and consumers
+ * whether it is free or filled for their lap, so a push or pop is one
+ * compare-and-swap on a shared cursor plus a block copy. Refill threads,
+ * each generating from its own qrng_split() substream, keep the ring full
+ * and sleep on a futex once it is, until consumers drain it below half.
+ * Consumers never block; a pop from an empty ring fails and the caller
+ * generates inline instead.
+ */
+
+#define QRNG_RING_BLOCK 4096               /**< Bytes per block */
+#define QRNG_RING_MIN_BLOCKS 2             /**< Smallest ring */
+#define QRNG_RING_MAX_BLOCKS (1 << 16)     /**< Largest ring, 256 MiB */
+#define QRNG_RING_MAX_PRODUCERS 64         /**< Most refill threads */
+
+typedef struct qrng_block_ring qrng_block_ring;
+
+/**
+ * @brief Ring counters
+ */
+typedef struct {
+    size_t capacity;                   /**< Blocks in the ring */
+    size_t depth;                      /**< Filled blocks, approximate */
+    unsigned producers;                /**< Refill threads */
+    uint64_t pushed;                   /**< Blocks pushed */
+    uint64_t popped;                   /**< Blocks popped */
+    uint64_t misses;                   /**< Pops that found the ring empty */
+    uint64_t sleeps;                   /**< Times a refill thread slept on a full ring */
+    uint64_t failures;                 /**< Blocks a refill thread failed to generate */
+} qrng_block_ring_stats;
+
+/**
+ * @brief Create a ring and start its refill threads
+ *
+ * Each refill thread generates from a context split from root with
+ * qrng_split(); root is only used during this call. With no producers the
+ * ring is fed by qrng_block_ring_push() alone.
+ *
+ * @param root Context the refill contexts are split from, may be NULL
+ *             when producers is 0
+ * @param blocks Capacity, rounded up to a power of two and clamped to
+ *               [QRNG_RING_MIN_BLOCKS, QRNG_RING_MAX_BLOCKS]
+ * @param producers Refill threads, at most QRNG_RING_MAX_PRODUCERS
+ * @return New ring, or NULL on failure
+ */
+qrng_block_ring *qrng_block_ring_create(qrng_ctx *root, size_t blocks, unsigned producers);
+
+/**
+ * @brief Stop the refill threads and free the ring
+ *
+ * No thread may be pushing or popping, and no context may still have the
+ * ring attached.
+ *
+ * @param r Ring
+ */
+void qrng_block_ring_destroy(qrng_block_ring *r);
+
+/**
+ * @brief Add a block
+ *
+ * Safe from any number of threads. Never blocks.
+ *
+ * @param r Ring
+ * @param block QRNG_RING_BLOCK bytes to copy in
+ * @return 0 on success, -1 if the ring is full
+ */
+int qrng_block_ring_push(qrng_block_ring *r, const uint8_t *block);
+
+/**
+ * @brief Take a block
+ *
+ * Safe from any number of threads. Never blocks. Each pushed block is
+ * handed to exactly one consumer.
+ *
+ * @param r Ring
+ * @param out Receives QRNG_RING_BLOCK bytes
+ * @return 0 on success, -1 if the ring is empty
+ */
+int qrng_block_ring_pop(qrng_block_ring *r, uint8_t *out);
+
+/**
+ * @brief Snapshot the counters
+ *
+ * @param r Ring
+ * @param stats[out] Receives the counters
+ */
+void qrng_block_ring_get_stats(qrng_block_ring *r, qrng_block_ring_stats *stats);
+
+#endif /* QUANTUM_BLOCK_RING_H */
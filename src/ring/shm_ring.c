@@ -0,0 +1,725 @@
+#include "shm_ring.h"
+#include "futex.h"
+#include <errno.h>
+#include <fcntl.h>
+#include <pthread.h>
+#include <sched.h>
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/file.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#define SHM_RING_MAGIC 0x51524E4753484D52ULL   // "QRNGSHMR"
+#define SHM_RING_VERSION 3
+#define SHM_RING_CHECK_MS 100                  // Liveness checks, at most this often
+#define SHM_RING_STALL_PAUSE_NS (1000 * 1000)  // Producer poll while a cell is stalled
+#define SHM_RING_LOCK_SUFFIX ".lock"
+#define CELL_CLAIMED (1ULL << 63)              // Cell word holds an owner, not a position
+
+// Segment layout: this header, then capacity cells. Everything in it is
+// position independent, since every process maps it at its own address.
+typedef struct {
+    uint64_t magic;
+    uint32_t version;
+    uint32_t block;
+    uint64_t capacity;
+    uint32_t ready;                    // atomic, set once the cells are initialised
+    int32_t producer_pid;              // atomic, for stats; liveness is the segment lock
+
+    uint64_t tail __attribute__((aligned(64)));     // atomic, producer only
+    uint64_t head __attribute__((aligned(64)));     // atomic, consumers
+
+    // The producer sleeps on space while the ring is above half full
+    uint32_t space __attribute__((aligned(64)));    // atomic, futex word
+    uint32_t sleepers;                 // atomic
+    uint64_t misses;                   // atomic
+    uint64_t sleeps;                   // atomic
+    uint64_t failures;                 // atomic
+    uint64_t recoveries;               // atomic
+} __attribute__((aligned(64))) shm_header;
+
+// As in block_ring.c, seq == pos is free for the producer and pos + 1 is
+// filled for the consumer of pos. A consumer claims the cell by swapping its
+// claim_word() into seq, so the claim and its owner appear in one step, and
+// releases it with a swap back from that word to pos + capacity. The
+// producer can therefore tell a slow consumer from a dead one, and a
+// consumer whose cell was taken back finds out instead of releasing it.
+typedef struct {
+    uint64_t seq;                      // atomic
+    uint8_t pad[56];
+    uint8_t data[QRNG_RING_BLOCK];
+} shm_cell;
+
+// One mapping of a segment. A handle that moves to a new segment keeps the
+// old mapping until close, since other threads may still be popping from it.
+typedef struct shm_segment {
+    shm_header *hdr;
+    shm_cell *cells;
+    size_t mask;
+    size_t map_bytes;
+    int fd;                            // Producer holds LOCK_EX on it while running
+    struct shm_segment *retired;       // Previous mapping of this handle
+} shm_segment;
+
+struct qrng_shm_ring {
+    shm_segment *seg;                  // atomic, current mapping
+    char name[QRNG_SHM_RING_NAME_MAX + 2];
+    char lock_name[QRNG_SHM_RING_NAME_MAX + 2 + sizeof(SHM_RING_LOCK_SUFFIX)];
+    uint64_t claim;                    // claim_word() of this process
+
+    // Rejoining after the producer exits
+    pthread_mutex_t rejoin;
+    qrng_ctx *spare;                   // Refill context for a takeover, from join
+    size_t blocks;
+    uint64_t next_check_ms;            // atomic
+    uint64_t rejoins;                  // atomic
+
+    // Producer only
+    int is_producer;                   // atomic
+    shm_segment *own;                  // Segment the refill thread fills
+    qrng_ctx *ctx;
+    pthread_t thread;
+    uint32_t stop;                     // atomic
+    uint64_t stall_pos;                // Refill thread only
+    uint64_t stall_since_ms;
+    uint64_t stall_check_ms;
+    struct qrng_shm_ring *next_producer;
+};
+
+// Producing handles of this process. A child forked without exec would
+// share their segment locks and keep a dead producer looking alive, so it
+// closes its copies of the descriptors.
+static pthread_mutex_t producers_lock = PTHREAD_MUTEX_INITIALIZER;
+static qrng_shm_ring *producers;
+static pthread_once_t fork_once = PTHREAD_ONCE_INIT;
+
+static void producers_before_fork(void) {
+    pthread_mutex_lock(&producers_lock);
+}
+
+static void producers_after_fork_parent(void) {
+    pthread_mutex_unlock(&producers_lock);
+}
+
+static void producers_after_fork_child(void) {
+    for (qrng_shm_ring *r = producers; r; r = r->next_producer) {
+        close(r->own->fd);
+        r->own->fd = -1;
+    }
+    pthread_mutex_unlock(&producers_lock);
+}
+
+static void producers_setup(void) {
+    pthread_atfork(producers_before_fork, producers_after_fork_parent,
+                   producers_after_fork_child);
+}
+
+static void producers_add(qrng_shm_ring *r) {
+    pthread_once(&fork_once, producers_setup);
+    pthread_mutex_lock(&producers_lock);
+    r->next_producer = producers;
+    producers = r;
+    pthread_mutex_unlock(&producers_lock);
+}
+
+static void producers_remove(qrng_shm_ring *r) {
+    pthread_mutex_lock(&producers_lock);
+    for (qrng_shm_ring **p = &producers; *p; p = &(*p)->next_producer) {
+        if (*p == r) {
+            *p = r->next_producer;
+            break;
+        }
+    }
+    pthread_mutex_unlock(&producers_lock);
+}
+
+static uint64_t now_ms(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000 + (uint64_t)ts.tv_nsec / 1000000;
+}
+
+static int ring_name(char *dst, char *lock, const char *name) {
+    if (!name || !*name) return -1;
+    const char *base = name[0] == '/' ? name + 1 : name;
+    size_t len = strlen(base);
+    if (len == 0 || len > QRNG_SHM_RING_NAME_MAX || strchr(base, '/')) return -1;
+
+    dst[0] = '/';
+    memcpy(dst + 1, base, len + 1);
+    memcpy(lock, dst, len + 1);
+    memcpy(lock + len + 1, SHM_RING_LOCK_SUFFIX, sizeof(SHM_RING_LOCK_SUFFIX));
+    return 0;
+}
+
+static int flock_retry(int fd, int op) {
+    int ret;
+    while ((ret = flock(fd, op)) != 0 && errno == EINTR) {}
+    return ret;
+}
+
+// Checking for a live producer and replacing its segment happen under an
+// exclusive lock on a companion object, which is never removed, so only
+// one of several racing processes takes over
+static int lock_name(const qrng_shm_ring *r) {
+    int fd = shm_open(r->lock_name, O_RDWR | O_CREAT, 0600);
+    if (fd < 0) return -1;
+    if (flock_retry(fd, LOCK_EX) != 0) {
+        close(fd);
+        return -1;
+    }
+    return fd;
+}
+
+static void unlock_name(int fd) {
+    if (fd >= 0) close(fd);
+}
+
+static size_t shm_depth(shm_header *h) {
+    uint64_t head = __atomic_load_n(&h->head, __ATOMIC_SEQ_CST);
+    uint64_t tail = __atomic_load_n(&h->tail, __ATOMIC_SEQ_CST);
+    return tail > head ? (size_t)(tail - head) : 0;
+}
+
+// Start time of pid in clock ticks since boot, field 22 of /proc/<pid>/stat;
+// 0 if it cannot be read
+static uint64_t process_start(pid_t pid) {
+    char path[32];
+    snprintf(path, sizeof(path), "/proc/%d/stat", (int)pid);
+    FILE *f = fopen(path, "r");
+    if (!f) return 0;
+
+    char buf[512];
+    size_t n = fread(buf, 1, sizeof(buf) - 1, f);
+    fclose(f);
+    buf[n] = '\0';
+
+    // The command name, field 2, may hold spaces; count from its ')'
+    char *p = strrchr(buf, ')');
+    if (!p) return 0;
+    for (int field = 2; field < 22; field++) {
+        p = strchr(p + 1, ' ');
+        if (!p) return 0;
+    }
+    return strtoull(p + 1, NULL, 10);
+}
+
+// Cell word of a claim: the PID and the low 32 bits of the start time of
+// the claiming process, which never look like a position
+static uint64_t claim_word(pid_t pid, uint64_t start) {
+    return CELL_CLAIMED | (uint64_t)(uint32_t)pid << 32 | (uint32_t)start;
+}
+
+// Whether the process behind a claim still exists. A bare PID can be
+// reused by an unrelated process, so where /proc is readable the start
+// time must match too.
+static int claimant_alive(uint64_t claim) {
+    pid_t pid = (pid_t)((claim & ~CELL_CLAIMED) >> 32);
+    uint32_t start = (uint32_t)claim;
+    if (pid <= 0) return 0;
+    if (kill(pid, 0) != 0 && errno != EPERM) return 0;
+    if (start == 0) return 1;
+
+    uint64_t now = process_start(pid);
+    return now == 0 || (uint32_t)now == start;
+}
+
+// The producer holds an exclusive lock on its segment for as long as it
+// runs, and the kernel drops it however the process exits. Never called on
+// the producer's own descriptor, where it would convert that lock.
+static int producer_alive(const shm_segment *s) {
+    if (flock(s->fd, LOCK_SH | LOCK_NB) == 0) {
+        flock(s->fd, LOCK_UN);
+        return 0;
+    }
+    return errno == EWOULDBLOCK;
+}
+
+// Single producer, so claiming a cell needs no compare-and-swap
+static int shm_push(shm_segment *s, const uint8_t *block) {
+    shm_header *h = s->hdr;
+    uint64_t pos = __atomic_load_n(&h->tail, __ATOMIC_RELAXED);
+    shm_cell *cell = &s->cells[pos & s->mask];
+
+    if (__atomic_load_n(&cell->seq, __ATOMIC_ACQUIRE) != pos) return -1;
+    memcpy(cell->data, block, QRNG_RING_BLOCK);
+    __atomic_store_n(&cell->seq, pos + 1, __ATOMIC_RELEASE);
+    __atomic_store_n(&h->tail, pos + 1, __ATOMIC_RELEASE);
+    return 0;
+}
+
+// Claim the cell at head and copy it out. head only advances past cells
+// already claimed, by their claimant or by whichever consumer finds head
+// lagging behind one.
+static int segment_pop(qrng_shm_ring *r, shm_segment *s, uint8_t *out) {
+    shm_header *h = s->hdr;
+
+    for (;;) {
+        uint64_t pos = __atomic_load_n(&h->head, __ATOMIC_ACQUIRE);
+        // Read before the cell: tail past pos means pos was filled first
+        uint64_t tail = __atomic_load_n(&h->tail, __ATOMIC_ACQUIRE);
+        shm_cell *cell = &s->cells[pos & s->mask];
+        uint64_t seq = __atomic_load_n(&cell->seq, __ATOMIC_ACQUIRE);
+
+        if (seq == pos + 1) {
+            if (!__atomic_compare_exchange_n(&cell->seq, &seq, r->claim, 0,
+                                             __ATOMIC_ACQUIRE, __ATOMIC_RELAXED)) {
+                continue;
+            }
+            __atomic_compare_exchange_n(&h->head, &pos, pos + 1, 0,
+                                        __ATOMIC_RELEASE, __ATOMIC_RELAXED);
+
+            memcpy(out, cell->data, QRNG_RING_BLOCK);
+            uint64_t held = r->claim;
+            if (__atomic_compare_exchange_n(&cell->seq, &held, pos + s->mask + 1, 0,
+                                            __ATOMIC_RELEASE, __ATOMIC_RELAXED)) {
+                break;
+            }
+            // The producer took the cell back, judging this process dead;
+            // the copy may be torn or shared, so drop it
+            memset(out, 0, QRNG_RING_BLOCK);
+            continue;
+        }
+
+        int claimed = (seq & CELL_CLAIMED) ? tail > pos : (int64_t)(seq - (pos + 1)) > 0;
+        if (!claimed) {
+            // Not filled yet, or still held from the previous lap
+            __atomic_fetch_add(&h->misses, 1, __ATOMIC_RELAXED);
+            return -1;
+        }
+        // Claimed by a consumer that has not moved head yet; move it for them
+        __atomic_compare_exchange_n(&h->head, &pos, pos + 1, 0,
+                                    __ATOMIC_RELEASE, __ATOMIC_RELAXED);
+    }
+
+    // Wake the producer once the ring is half drained; see block_ring.c
+    if (shm_depth(h) <= (s->mask + 1) / 2) {
+        if (__atomic_fetch_add(&h->sleepers, 0, __ATOMIC_SEQ_CST)) {
+            __atomic_fetch_add(&h->space, 1, __ATOMIC_RELEASE);
+            qrng_futex_wake(&h->space, 1);
+        }
+    }
+    return 0;
+}
+
+// The cell at tail is still claimed from the previous lap. Once it has
+// been held for QRNG_SHM_RING_STALL_MS, check its owner every
+// SHM_RING_CHECK_MS and take it back only if the owner has exited; a live
+// owner, however slow, keeps it.
+static void recover_cell(qrng_shm_ring *r, shm_segment *s) {
+    shm_header *h = s->hdr;
+    uint64_t pos = __atomic_load_n(&h->tail, __ATOMIC_RELAXED);
+    shm_cell *cell = &s->cells[pos & s->mask];
+    uint64_t seq = __atomic_load_n(&cell->seq, __ATOMIC_ACQUIRE);
+
+    if (!(seq & CELL_CLAIMED)) {
+        sched_yield();
+        return;
+    }
+
+    uint64_t now = now_ms();
+    if (r->stall_pos != pos || r->stall_since_ms == 0) {
+        r->stall_pos = pos;
+        r->stall_since_ms = now;
+        r->stall_check_ms = now + QRNG_SHM_RING_STALL_MS;
+    }
+    if (now - r->stall_since_ms < QRNG_SHM_RING_STALL_MS) {
+        sched_yield();
+        return;
+    }
+
+    if (now >= r->stall_check_ms) {
+        r->stall_check_ms = now + SHM_RING_CHECK_MS;
+        if (!claimant_alive(seq)) {
+            // Fails only if the owner released it after all
+            if (__atomic_compare_exchange_n(&cell->seq, &seq, pos, 0,
+                                            __ATOMIC_ACQ_REL, __ATOMIC_RELAXED)) {
+                __atomic_fetch_add(&h->recoveries, 1, __ATOMIC_RELAXED);
+            }
+            r->stall_since_ms = 0;
+            return;
+        }
+    }
+
+    // Owner alive but stopped; poll slowly rather than spin
+    struct timespec pause = { 0, SHM_RING_STALL_PAUSE_NS };
+    nanosleep(&pause, NULL);
+}
+
+static void wait_for_space(qrng_shm_ring *r) {
+    shm_segment *s = r->own;
+    shm_header *h = s->hdr;
+    __atomic_fetch_add(&h->sleepers, 1, __ATOMIC_SEQ_CST);
+    uint32_t seen = __atomic_load_n(&h->space, __ATOMIC_SEQ_CST);
+
+    if (__atomic_load_n(&r->stop, __ATOMIC_ACQUIRE)) {
+        // Shutting down
+    } else if (shm_depth(h) > (s->mask + 1) / 2) {
+        __atomic_fetch_add(&h->sleeps, 1, __ATOMIC_RELAXED);
+        qrng_futex_wait(&h->space, seen, 1);
+    } else {
+        // A consumer is still copying out the cell we need, or died doing so
+        recover_cell(r, s);
+    }
+    __atomic_fetch_sub(&h->sleepers, 1, __ATOMIC_RELAXED);
+}
+
+static void *refill_thread(void *arg) {
+    qrng_shm_ring *r = arg;
+    uint8_t block[QRNG_RING_BLOCK] __attribute__((aligned(64)));
+
+    while (!__atomic_load_n(&r->stop, __ATOMIC_ACQUIRE)) {
+        if (qrng_bytes(r->ctx, block, sizeof(block)) != QRNG_SUCCESS) {
+            // Generation refused, e.g. by a failing health test; back off
+            __atomic_fetch_add(&r->own->hdr->failures, 1, __ATOMIC_RELAXED);
+            struct timespec pause = { 0, 10 * 1000 * 1000 };
+            nanosleep(&pause, NULL);
+            continue;
+        }
+
+        while (shm_push(r->own, block) != 0) {
+            if (__atomic_load_n(&r->stop, __ATOMIC_ACQUIRE)) break;
+            wait_for_space(r);
+        }
+    }
+    memset(block, 0, sizeof(block));
+    return NULL;
+}
+
+static size_t map_size(size_t capacity) {
+    return sizeof(shm_header) + capacity * sizeof(shm_cell);
+}
+
+static void segment_unmap(shm_segment *s) {
+    while (s) {
+        shm_segment *older = s->retired;
+        munmap(s->hdr, s->map_bytes);
+        if (s->fd >= 0) close(s->fd);
+        free(s);
+        s = older;
+    }
+}
+
+// Create and initialise a segment produced by r, locked but not yet marked
+// ready. errno is EEXIST if the name is taken. Called under lock_name().
+static shm_segment *segment_create(const qrng_shm_ring *r, size_t blocks) {
+    size_t capacity = QRNG_RING_MIN_BLOCKS;
+    while (capacity < blocks && capacity < QRNG_RING_MAX_BLOCKS) capacity <<= 1;
+
+    shm_segment *s = calloc(1, sizeof(shm_segment));
+    if (!s) return NULL;
+    s->mask = capacity - 1;
+    s->map_bytes = map_size(capacity);
+
+    s->fd = shm_open(r->name, O_RDWR | O_CREAT | O_EXCL, 0600);
+    if (s->fd < 0) {
+        int saved = errno;
+        free(s);
+        errno = saved;
+        return NULL;
+    }
+    void *base = MAP_FAILED;
+    if (flock_retry(s->fd, LOCK_EX) == 0 && ftruncate(s->fd, (off_t)s->map_bytes) == 0) {
+        base = mmap(NULL, s->map_bytes, PROT_READ | PROT_WRITE, MAP_SHARED, s->fd, 0);
+    }
+    if (base == MAP_FAILED) {
+        shm_unlink(r->name);
+        close(s->fd);
+        free(s);
+        errno = ENOMEM;
+        return NULL;
+    }
+
+    // The segment arrives zeroed; openers wait for ready
+    s->hdr = base;
+    s->cells = (shm_cell *)((uint8_t *)base + sizeof(shm_header));
+    for (size_t i = 0; i < capacity; i++) s->cells[i].seq = i;
+    s->hdr->magic = SHM_RING_MAGIC;
+    s->hdr->version = SHM_RING_VERSION;
+    s->hdr->block = QRNG_RING_BLOCK;
+    s->hdr->capacity = capacity;
+    s->hdr->producer_pid = getpid();
+    return s;
+}
+
+// Map the segment under the ring's name. With wait, give a creator that is
+// still initialising it up to a second; under lock_name() nobody can be.
+static shm_segment *segment_open(const qrng_shm_ring *r, int wait) {
+    int fd = shm_open(r->name, O_RDWR, 0);
+    if (fd < 0) return NULL;
+    int tries_max = wait ? 1000 : 1;
+
+    // The creator sizes the segment before initialising it
+    struct stat st;
+    void *base = MAP_FAILED;
+    for (int tries = 0; tries < tries_max; tries++) {
+        if (fstat(fd, &st) != 0) break;
+        if ((size_t)st.st_size > sizeof(shm_header)) {
+            base = mmap(NULL, (size_t)st.st_size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+            break;
+        }
+        if (wait) usleep(1000);
+    }
+    if (base == MAP_FAILED) {
+        close(fd);
+        return NULL;
+    }
+
+    shm_segment *s = calloc(1, sizeof(shm_segment));
+    if (!s) {
+        munmap(base, (size_t)st.st_size);
+        close(fd);
+        return NULL;
+    }
+    s->hdr = base;
+    s->map_bytes = (size_t)st.st_size;
+    s->fd = fd;
+
+    for (int tries = 1; tries < tries_max && !__atomic_load_n(&s->hdr->ready, __ATOMIC_ACQUIRE); tries++) {
+        usleep(1000);
+    }
+    shm_header *h = s->hdr;
+    if (!__atomic_load_n(&h->ready, __ATOMIC_ACQUIRE) || h->magic != SHM_RING_MAGIC ||
+        h->version != SHM_RING_VERSION || h->block != QRNG_RING_BLOCK ||
+        map_size(h->capacity) != s->map_bytes) {
+        segment_unmap(s);
+        return NULL;
+    }
+
+    s->cells = (shm_cell *)((uint8_t *)base + sizeof(shm_header));
+    s->mask = h->capacity - 1;
+    return s;
+}
+
+// Start filling s from ctx, which the handle then owns, and publish it
+static int start_producer(qrng_shm_ring *r, shm_segment *s, qrng_ctx *ctx) {
+    r->own = s;
+    r->ctx = ctx;
+    if (pthread_create(&r->thread, NULL, refill_thread, r) != 0) {
+        r->own = NULL;
+        r->ctx = NULL;
+        return -1;
+    }
+    producers_add(r);
+    __atomic_store_n(&r->is_producer, 1, __ATOMIC_RELEASE);
+    __atomic_store_n(&s->hdr->ready, 1, __ATOMIC_RELEASE);
+    return 0;
+}
+
+static qrng_shm_ring *ring_alloc(const char *name, size_t blocks) {
+    qrng_shm_ring *r = calloc(1, sizeof(qrng_shm_ring));
+    if (!r) return NULL;
+    if (ring_name(r->name, r->lock_name, name) != 0) {
+        free(r);
+        return NULL;
+    }
+    pid_t pid = getpid();
+    r->claim = claim_word(pid, process_start(pid));
+    r->blocks = blocks;
+    pthread_mutex_init(&r->rejoin, NULL);
+    return r;
+}
+
+static void ring_free(qrng_shm_ring *r) {
+    segment_unmap(r->seg);
+    qrng_free(r->spare);
+    pthread_mutex_destroy(&r->rejoin);
+    free(r);
+}
+
+// Context for a refill thread, split from root at a fresh index
+static qrng_ctx *refill_ctx(qrng_ctx *root) {
+    uint64_t index;
+    qrng_ctx *ctx = NULL;
+    if (qrng_uint64_checked(root, &index) != QRNG_SUCCESS ||
+        qrng_split(root, index, &ctx) != QRNG_SUCCESS) {
+        return NULL;
+    }
+    return ctx;
+}
+
+qrng_shm_ring *qrng_shm_ring_create(const char *name, size_t blocks, qrng_ctx *root) {
+    if (!root) return NULL;
+
+    qrng_shm_ring *r = ring_alloc(name, blocks);
+    if (!r) return NULL;
+
+    qrng_ctx *ctx = refill_ctx(root);
+    int lock = ctx ? lock_name(r) : -1;
+    shm_segment *s = lock >= 0 ? segment_create(r, blocks) : NULL;
+    if (!s) {
+        int saved = errno;
+        unlock_name(lock);
+        qrng_free(ctx);
+        ring_free(r);
+        errno = saved;
+        return NULL;
+    }
+
+    if (start_producer(r, s, ctx) != 0) {
+        shm_unlink(r->name);
+        unlock_name(lock);
+        segment_unmap(s);
+        qrng_free(ctx);
+        ring_free(r);
+        return NULL;
+    }
+    unlock_name(lock);
+    r->seg = s;
+    return r;
+}
+
+qrng_shm_ring *qrng_shm_ring_open(const char *name) {
+    qrng_shm_ring *r = ring_alloc(name, 0);
+    if (!r) return NULL;
+
+    r->seg = segment_open(r, 1);
+    if (!r->seg) {
+        ring_free(r);
+        return NULL;
+    }
+    return r;
+}
+
+// Find a live segment under the ring's name, creating it and becoming its
+// producer with *spare when nobody else produces. Without a spare context
+// the handle can only consume. Runs under lock_name(), so a segment seen
+// dead here cannot be replaced by another process in the meantime.
+static shm_segment *find_live(qrng_shm_ring *r, qrng_ctx **spare) {
+    int lock = lock_name(r);
+    if (lock < 0) return NULL;
+
+    // A segment that is not ready here was left by a creator that died
+    shm_segment *s = segment_open(r, 0);
+    if (s && !producer_alive(s)) {
+        segment_unmap(s);
+        s = NULL;
+    }
+    if (!s && *spare) {
+        // Missing, or left behind by a producer that died without closing
+        shm_unlink(r->name);
+        s = segment_create(r, r->blocks);
+        if (s && start_producer(r, s, *spare) == 0) {
+            *spare = NULL;
+        } else if (s) {
+            shm_unlink(r->name);
+            segment_unmap(s);
+            s = NULL;
+        }
+    }
+    unlock_name(lock);
+    return s;
+}
+
+qrng_shm_ring *qrng_shm_ring_join(const char *name, size_t blocks, qrng_ctx *root) {
+    if (!root) return NULL;
+
+    qrng_shm_ring *r = ring_alloc(name, blocks);
+    if (!r) return NULL;
+
+    // Split now, while the caller owns root, so a takeover can happen later
+    // from whichever thread notices the producer has gone
+    qrng_ctx *ctx = refill_ctx(root);
+    if (!ctx) {
+        ring_free(r);
+        return NULL;
+    }
+    r->seg = find_live(r, &ctx);
+    if (!r->seg) {
+        qrng_free(ctx);
+        ring_free(r);
+        return NULL;
+    }
+    r->spare = ctx;
+    return r;
+}
+
+// Move from a segment whose producer has gone to a live one. Only one thread
+// rejoins at a time; the others keep missing until the new segment is up.
+static int rejoin(qrng_shm_ring *r, shm_segment *dead) {
+    if (pthread_mutex_trylock(&r->rejoin) != 0) return -1;
+
+    int ret = 0;
+    if (__atomic_load_n(&r->seg, __ATOMIC_ACQUIRE) == dead) {
+        shm_segment *s = find_live(r, &r->spare);
+        if (s) {
+            s->retired = dead;
+            __atomic_store_n(&r->seg, s, __ATOMIC_RELEASE);
+            __atomic_fetch_add(&r->rejoins, 1, __ATOMIC_RELAXED);
+        } else {
+            ret = -1;
+        }
+    }
+    pthread_mutex_unlock(&r->rejoin);
+    return ret;
+}
+
+// Whether s has lost its producer, checked at most every SHM_RING_CHECK_MS
+static int producer_gone(qrng_shm_ring *r, shm_segment *s) {
+    if (__atomic_load_n(&r->is_producer, __ATOMIC_ACQUIRE)) return 0;
+
+    uint64_t now = now_ms();
+    uint64_t next = __atomic_load_n(&r->next_check_ms, __ATOMIC_RELAXED);
+    if (now < next || !__atomic_compare_exchange_n(&r->next_check_ms, &next,
+                                                   now + SHM_RING_CHECK_MS, 0,
+                                                   __ATOMIC_RELAXED, __ATOMIC_RELAXED)) {
+        return 0;
+    }
+    return !producer_alive(s);
+}
+
+int qrng_shm_ring_pop(qrng_shm_ring *r, uint8_t *out) {
+    shm_segment *s = __atomic_load_n(&r->seg, __ATOMIC_ACQUIRE);
+    if (segment_pop(r, s, out) == 0) return 0;
+
+    // Empty. If nobody will refill it, move to a segment somebody does.
+    if (!producer_gone(r, s) || rejoin(r, s) != 0) return -1;
+    return segment_pop(r, __atomic_load_n(&r->seg, __ATOMIC_ACQUIRE), out);
+}
+
+void qrng_shm_ring_close(qrng_shm_ring *r) {
+    if (!r) return;
+
+    if (r->is_producer) {
+        shm_header *h = r->own->hdr;
+        __atomic_store_n(&r->stop, 1, __ATOMIC_RELEASE);
+        __atomic_fetch_add(&h->space, 1, __ATOMIC_RELEASE);
+        qrng_futex_wake(&h->space, 1);
+        pthread_join(r->thread, NULL);
+        qrng_free(r->ctx);
+        producers_remove(r);
+
+        // The name is still ours: nobody replaces it while our lock is held
+        int lock = lock_name(r);
+        __atomic_store_n(&h->producer_pid, 0, __ATOMIC_RELEASE);
+        shm_unlink(r->name);
+        unlock_name(lock);
+    }
+    // Closing the segment descriptors drops the producer lock
+    ring_free(r);
+}
+
+void qrng_shm_ring_get_stats(qrng_shm_ring *r, qrng_shm_ring_stats *stats) {
+    if (!r || !stats) return;
+
+    shm_segment *s = __atomic_load_n(&r->seg, __ATOMIC_ACQUIRE);
+    shm_header *h = s->hdr;
+    stats->capacity = s->mask + 1;
+    stats->depth = shm_depth(h);
+    stats->pushed = __atomic_load_n(&h->tail, __ATOMIC_RELAXED);
+    stats->popped = __atomic_load_n(&h->head, __ATOMIC_RELAXED);
+    stats->misses = __atomic_load_n(&h->misses, __ATOMIC_RELAXED);
+    stats->sleeps = __atomic_load_n(&h->sleeps, __ATOMIC_RELAXED);
+    stats->failures = __atomic_load_n(&h->failures, __ATOMIC_RELAXED);
+    stats->recoveries = __atomic_load_n(&h->recoveries, __ATOMIC_RELAXED);
+    stats->rejoins = __atomic_load_n(&r->rejoins, __ATOMIC_RELAXED);
+    stats->producer_pid = __atomic_load_n(&h->producer_pid, __ATOMIC_RELAXED);
+    stats->producer_alive = __atomic_load_n(&r->is_producer, __ATOMIC_ACQUIRE) && s == r->own
+        ? 1 : producer_alive(s);
+    stats->is_producer = __atomic_load_n(&r->is_producer, __ATOMIC_ACQUIRE);
+}
@@ -0,0 +1,133 @@
+#ifndef QUANTUM_SHM_RING_H
+#define QUANTUM_SHM_RING_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <sys/types.h>
+#include "quantum_rng.h"
+#include "block_ring.h"
+
+/**
+ * @file shm_ring.h
+ * @brief Block ring shared between processes through POSIX shared memory
+ *
+ * One process on the host creates a named shm_open() segment holding a
+ * ring of QRNG_RING_BLOCK-byte blocks and runs a refill thread that keeps
+ * it full. Any process of the same user maps the segment by name and pops
+ * blocks; every cell carries a sequence number as in block_ring.h, and a
+ * consumer claims a block by swapping its PID and start time into that
+ * number, so each block goes to exactly one consumer. The producer sleeps
+ * on a process-shared futex in the segment while the ring is more than
+ * half full, and consumers wake it.
+ *
+ * Consumers never block: when the ring is empty a pop fails and the
+ * caller generates inline. The producer holds an flock() on the segment
+ * while it runs, which the kernel releases however it exits; a consumer
+ * that finds the ring empty and that lock free moves to a live segment
+ * under the same name, taking over production if it joined with a
+ * context. Takeovers are serialised on a companion "<name>.lock" object,
+ * which is never removed. A cell held for QRNG_SHM_RING_STALL_MS is
+ * given back to the producer only once its consumer has exited; should
+ * that consumer still be copying, its release fails and it discards the
+ * block and pops again.
+ */
+
+#define QRNG_SHM_RING_NAME_MAX 64          /**< Longest segment name */
+#define QRNG_SHM_RING_STALL_MS 1000        /**< Claimed cell age before its owner is checked */
+
+typedef struct qrng_shm_ring qrng_shm_ring;
+
+/**
+ * @brief Shared ring counters
+ */
+typedef struct {
+    size_t capacity;                   /**< Blocks in the ring */
+    size_t depth;                      /**< Filled blocks, approximate */
+    uint64_t pushed;                   /**< Blocks pushed by the producer */
+    uint64_t popped;                   /**< Blocks popped by all processes */
+    uint64_t misses;                   /**< Pops that found the ring empty */
+    uint64_t sleeps;                   /**< Times the producer slept on a full ring */
+    uint64_t failures;                 /**< Blocks the producer failed to generate */
+    uint64_t recoveries;               /**< Cells taken back from dead consumers */
+    uint64_t rejoins;                  /**< Times this handle moved to a new segment */
+    pid_t producer_pid;                /**< Producing process, 0 once it has closed */
+    int producer_alive;                /**< Producer still holds the segment lock */
+    int is_producer;                   /**< This handle runs the refill thread */
+} qrng_shm_ring_stats;
+
+/**
+ * @brief Create a named segment and become its producer
+ *
+ * Fails if the name already exists. The refill thread generates from a
+ * context split from root, which is only used during this call.
+ *
+ * @param name Segment name, with or without the leading '/'
+ * @param blocks Capacity, rounded up to a power of two and clamped to
+ *               [QRNG_RING_MIN_BLOCKS, QRNG_RING_MAX_BLOCKS]
+ * @param root Context the refill context is split from
+ * @return New ring, or NULL on failure
+ */
+qrng_shm_ring *qrng_shm_ring_create(const char *name, size_t blocks, qrng_ctx *root);
+
+/**
+ * @brief Map an existing segment as a consumer
+ *
+ * Waits up to a second for a producer that is still initialising it.
+ *
+ * @param name Segment name, with or without the leading '/'
+ * @return New ring handle, or NULL on failure
+ */
+qrng_shm_ring *qrng_shm_ring_open(const char *name);
+
+/**
+ * @brief Consume from the named segment, producing it if nobody does
+ *
+ * Opens the segment if it exists and its producer is alive. Otherwise
+ * removes any stale segment and creates it; the companion lock makes
+ * exactly one of several processes racing here the producer. A consumer
+ * keeps the context split from root, and uses it to take over production
+ * if the producer later exits.
+ *
+ * @param name Segment name, with or without the leading '/'
+ * @param blocks Capacity used if this handle creates the segment
+ * @param root Context the refill context is split from, only used during
+ *             this call
+ * @return New ring handle, or NULL on failure
+ */
+qrng_shm_ring *qrng_shm_ring_join(const char *name, size_t blocks, qrng_ctx *root);
+
+/**
+ * @brief Unmap the segment
+ *
+ * The producer also stops its refill thread and removes the name, so a
+ * later qrng_shm_ring_join() creates a fresh segment; processes that
+ * still map the old one keep draining it. No thread may be popping, and
+ * no context may still have the ring attached. A child forked from a
+ * producer does not inherit its segment lock.
+ *
+ * @param r Ring handle
+ */
+void qrng_shm_ring_close(qrng_shm_ring *r);
+
+/**
+ * @brief Take a block
+ *
+ * Safe from any number of threads in any number of processes. Never
+ * blocks. On an empty ring whose producer has gone, moves the handle to
+ * a live segment and retries once; this is checked at most every 100 ms.
+ *
+ * @param r Ring handle
+ * @param out Receives QRNG_RING_BLOCK bytes
+ * @return 0 on success, -1 if the ring is empty
+ */
+int qrng_shm_ring_pop(qrng_shm_ring *r, uint8_t *out);
+
+/**
+ * @brief Snapshot the counters
+ *
+ * @param r Ring handle
+ * @param stats[out] Receives the counters
+ */
+void qrng_shm_ring_get_stats(qrng_shm_ring *r, qrng_shm_ring_stats *stats);
+
+#endif /* QUANTUM_SHM_RING_H */
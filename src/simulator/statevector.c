@@ -0,0 +1,717 @@
+#include "statevector.h"
+#include "simd.h"
+#include "parallel.h"
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+#define QRNG_SIM_ALIGN 64
+#define QRNG_SIM_BLOCK_QUBITS 12        // 4096 amplitudes, 64 KiB per block
+#define QRNG_SIM_FUSE_HIGH 3            // High qubits mixed per sweep
+#define QRNG_SIM_PARALLEL_QUBITS 16     // Smaller registers stay on one thread
+
+// Amplitudes per vector register. The AVX2 kernels also need FMA.
+#if defined(QRNG_SIMD_AVX512)
+#define QRNG_SIM_WIDTH 8
+#elif defined(QRNG_SIMD_AVX2) && defined(__FMA__)
+#define QRNG_SIM_AVX2 1
+#define QRNG_SIM_WIDTH 4
+#else
+#define QRNG_SIM_WIDTH 1
+#endif
+
+static unsigned block_qubits(const qrng_state *s);
+static void sim_parallel(const qrng_state *s, size_t n, size_t max_threads,
+                         qrng_range_fn fn, void *arg);
+
+qrng_state *qrng_state_create(unsigned qubits) {
+    if (qubits == 0 || qubits > QRNG_SIM_MAX_QUBITS) return NULL;
+
+    qrng_state *s = calloc(1, sizeof(qrng_state));
+    if (!s) return NULL;
+
+    s->qubits = qubits;
+    s->dim = (size_t)1 << qubits;
+
+    // Imaginary parts follow the real parts, padded to keep them aligned
+    size_t half = s->dim * sizeof(double);
+    half = (half + QRNG_SIM_ALIGN - 1) & ~(size_t)(QRNG_SIM_ALIGN - 1);
+    if (qrng_region_alloc(&s->mem, 2 * half, 0) != 0) {
+        free(s);
+        return NULL;
+    }
+    s->re = s->mem.base;
+    s->im = (double *)((char *)s->mem.base + half);
+
+    qrng_state_reset(s);
+    return s;
+}
+
+void qrng_state_destroy(qrng_state *s) {
+    if (s) {
+        qrng_region_free(&s->mem);
+        free(s);
+    }
+}
+
+static void zero_range(void *arg, size_t begin, size_t end) {
+    qrng_state *s = arg;
+    size_t len = (size_t)1 << block_qubits(s);
+    memset(s->re + begin * len, 0, (end - begin) * len * sizeof(double));
+    memset(s->im + begin * len, 0, (end - begin) * len * sizeof(double));
+}
+
+// Zeroed block by block with the same static split as a low-qubit sweep, so
+// pages of a fresh allocation are first touched by the worker that takes
+// that slice in low-qubit passes. This is a placement hint only: workers are
+// not pinned and may migrate, and high-qubit passes pair amplitudes from
+// different slices, so they read memory placed by other workers.
+void qrng_state_reset(qrng_state *s) {
+    if (!s) return;
+    sim_parallel(s, (size_t)1 << (s->qubits - block_qubits(s)), 0, zero_range, s);
+    s->re[0] = 1.0;
+}
+
+qrng_error qrng_gate_matrix(qrng_gate_kind kind, double theta, double u[8]) {
+    const double r2 = 0.70710678118654752440;
+    double c = cos(theta / 2), sn = sin(theta / 2);
+
+    // Identity, then overwrite what differs
+    double m[8] = { 1, 0, 0, 0, 0, 0, 1, 0 };
+
+    switch (kind) {
+    case QRNG_GATE_H:
+        m[0] = r2; m[2] = r2; m[4] = r2; m[6] = -r2;
+        break;
+    case QRNG_GATE_X:
+        m[0] = 0; m[2] = 1; m[4] = 1; m[6] = 0;
+        break;
+    case QRNG_GATE_Y:
+        m[0] = 0; m[3] = -1; m[5] = 1; m[6] = 0;
+        break;
+    case QRNG_GATE_Z:
+        m[6] = -1;
+        break;
+    case QRNG_GATE_S:
+        m[6] = 0; m[7] = 1;
+        break;
+    case QRNG_GATE_T:
+        m[6] = r2; m[7] = r2;
+        break;
+    case QRNG_GATE_PHASE:
+        m[6] = cos(theta); m[7] = sin(theta);
+        break;
+    case QRNG_GATE_RX:
+        m[0] = c; m[3] = -sn; m[5] = -sn; m[6] = c;
+        break;
+    case QRNG_GATE_RY:
+        m[0] = c; m[2] = -sn; m[4] = sn; m[6] = c;
+        break;
+    case QRNG_GATE_RZ:
+        m[0] = c; m[1] = -sn; m[6] = c; m[7] = sn;
+        break;
+    default:
+        return QRNG_ERROR_INVALID_RANGE;
+    }
+
+    memcpy(u, m, sizeof(m));
+    return QRNG_SUCCESS;
+}
+
+// Apply u to the pairs (a[j], b[j]) for j < len
+static inline void apply_pairs(double *ar, double *ai, double *br, double *bi,
+                               size_t len, const double u[8]) {
+    size_t j = 0;
+#if defined(QRNG_SIMD_AVX512)
+    __m512d u0r = _mm512_set1_pd(u[0]), u0i = _mm512_set1_pd(u[1]);
+    __m512d u1r = _mm512_set1_pd(u[2]), u1i = _mm512_set1_pd(u[3]);
+    __m512d u2r = _mm512_set1_pd(u[4]), u2i = _mm512_set1_pd(u[5]);
+    __m512d u3r = _mm512_set1_pd(u[6]), u3i = _mm512_set1_pd(u[7]);
+
+    for (; j + 8 <= len; j += 8) {
+        __m512d xr = _mm512_load_pd(ar + j), xi = _mm512_load_pd(ai + j);
+        __m512d yr = _mm512_load_pd(br + j), yi = _mm512_load_pd(bi + j);
+
+        __m512d nr = _mm512_fmsub_pd(u0r, xr, _mm512_mul_pd(u0i, xi));
+        nr = _mm512_fmadd_pd(u1r, yr, nr);
+        nr = _mm512_fnmadd_pd(u1i, yi, nr);
+        __m512d ni = _mm512_fmadd_pd(u0r, xi, _mm512_mul_pd(u0i, xr));
+        ni = _mm512_fmadd_pd(u1r, yi, ni);
+        ni = _mm512_fmadd_pd(u1i, yr, ni);
+
+        __m512d mr = _mm512_fmsub_pd(u2r, xr, _mm512_mul_pd(u2i, xi));
+        mr = _mm512_fmadd_pd(u3r, yr, mr);
+        mr = _mm512_fnmadd_pd(u3i, yi, mr);
+        __m512d mi = _mm512_fmadd_pd(u2r, xi, _mm512_mul_pd(u2i, xr));
+        mi = _mm512_fmadd_pd(u3r, yi, mi);
+        mi = _mm512_fmadd_pd(u3i, yr, mi);
+
+        _mm512_store_pd(ar + j, nr);
+        _mm512_store_pd(ai + j, ni);
+        _mm512_store_pd(br + j, mr);
+        _mm512_store_pd(bi + j, mi);
+    }
+#elif defined(QRNG_SIM_AVX2)
+    __m256d u0r = _mm256_set1_pd(u[0]), u0i = _mm256_set1_pd(u[1]);
+    __m256d u1r = _mm256_set1_pd(u[2]), u1i = _mm256_set1_pd(u[3]);
+    __m256d u2r = _mm256_set1_pd(u[4]), u2i = _mm256_set1_pd(u[5]);
+    __m256d u3r = _mm256_set1_pd(u[6]), u3i = _mm256_set1_pd(u[7]);
+
+    for (; j + 4 <= len; j += 4) {
+        __m256d xr = _mm256_load_pd(ar + j), xi = _mm256_load_pd(ai + j);
+        __m256d yr = _mm256_load_pd(br + j), yi = _mm256_load_pd(bi + j);
+
+        __m256d nr = _mm256_fmsub_pd(u0r, xr, _mm256_mul_pd(u0i, xi));
+        nr = _mm256_fmadd_pd(u1r, yr, nr);
+        nr = _mm256_fnmadd_pd(u1i, yi, nr);
+        __m256d ni = _mm256_fmadd_pd(u0r, xi, _mm256_mul_pd(u0i, xr));
+        ni = _mm256_fmadd_pd(u1r, yi, ni);
+        ni = _mm256_fmadd_pd(u1i, yr, ni);
+
+        __m256d mr = _mm256_fmsub_pd(u2r, xr, _mm256_mul_pd(u2i, xi));
+        mr = _mm256_fmadd_pd(u3r, yr, mr);
+        mr = _mm256_fnmadd_pd(u3i, yi, mr);
+        __m256d mi = _mm256_fmadd_pd(u2r, xi, _mm256_mul_pd(u2i, xr));
+        mi = _mm256_fmadd_pd(u3r, yi, mi);
+        mi = _mm256_fmadd_pd(u3i, yr, mi);
+
+        _mm256_store_pd(ar + j, nr);
+        _mm256_store_pd(ai + j, ni);
+        _mm256_store_pd(br + j, mr);
+        _mm256_store_pd(bi + j, mi);
+    }
+#endif
+    for (; j < len; j++) {
+        double xr = ar[j], xi = ai[j];
+        double yr = br[j], yi = bi[j];
+        ar[j] = u[0] * xr - u[1] * xi + u[2] * yr - u[3] * yi;
+        ai[j] = u[0] * xi + u[1] * xr + u[2] * yi + u[3] * yr;
+        br[j] = u[4] * xr - u[5] * xi + u[6] * yr - u[7] * yi;
+        bi[j] = u[4] * xi + u[5] * xr + u[6] * yi + u[7] * yr;
+    }
+}
+
+#if defined(QRNG_SIMD_AVX512)
+// Partner amplitudes share the vector: each lane takes its own coefficient
+// and its partner's, selected by the lane's target bit
+static void apply_lane(double *re, double *im, size_t len, unsigned target,
+                       const double u[8]) {
+    double sr[8], si[8], pr[8], pi[8];
+    long long perm[8];
+    for (int l = 0; l < 8; l++) {
+        int bit = (l >> target) & 1;
+        sr[l] = bit ? u[6] : u[0];
+        si[l] = bit ? u[7] : u[1];
+        pr[l] = bit ? u[4] : u[2];
+        pi[l] = bit ? u[5] : u[3];
+        perm[l] = l ^ (1 << target);
+    }
+    __m512d csr = _mm512_loadu_pd(sr), csi = _mm512_loadu_pd(si);
+    __m512d cpr = _mm512_loadu_pd(pr), cpi = _mm512_loadu_pd(pi);
+    __m512i idx = _mm512_loadu_si512(perm);
+
+    for (size_t j = 0; j < len; j += 8) {
+        __m512d vr = _mm512_load_pd(re + j), vi = _mm512_load_pd(im + j);
+        __m512d wr = _mm512_permutexvar_pd(idx, vr), wi = _mm512_permutexvar_pd(idx, vi);
+
+        __m512d nr = _mm512_fmsub_pd(csr, vr, _mm512_mul_pd(csi, vi));
+        nr = _mm512_fmadd_pd(cpr, wr, nr);
+        nr = _mm512_fnmadd_pd(cpi, wi, nr);
+        __m512d ni = _mm512_fmadd_pd(csr, vi, _mm512_mul_pd(csi, vr));
+        ni = _mm512_fmadd_pd(cpr, wi, ni);
+        ni = _mm512_fmadd_pd(cpi, wr, ni);
+
+        _mm512_store_pd(re + j, nr);
+        _mm512_store_pd(im + j, ni);
+    }
+}
+#endif
+
+// Apply u to a qubit whose pairs lie inside [0, len) of re/im
+static void apply_local(double *re, double *im, size_t len, unsigned target,
+                        const double u[8]) {
+    size_t stride = (size_t)1 << target;
+#if defined(QRNG_SIMD_AVX512)
+    if (stride < QRNG_SIM_WIDTH && len >= QRNG_SIM_WIDTH) {
+        apply_lane(re, im, len, target, u);
+        return;
+    }
+#endif
+    for (size_t base = 0; base < len; base += 2 * stride) {
+        apply_pairs(re + base, im + base, re + base + stride, im + base + stride, stride, u);
+    }
+}
+
+// Runs a range body over n indices, on the pool once the register is big
+// enough to repay the fork
+static void sim_parallel(const qrng_state *s, size_t n, size_t max_threads,
+                         qrng_range_fn fn, void *arg) {
+    if (s->qubits < QRNG_SIM_PARALLEL_QUBITS) {
+        fn(arg, 0, n);
+    } else {
+        qrng_parallel_for_static(n, max_threads, fn, arg);
+    }
+}
+
+// Single-qubit unitary scheduled into a pass
+typedef struct {
+    unsigned qubit;
+    double u[8];
+} sim_op;
+
+// One sweep over the register. Low ops act inside a block; each high op
+// pairs whole blocks. A tile is the 2^nhigh blocks a set of high ops mixes,
+// so every op of the pass is applied while the tile is in cache.
+typedef struct {
+    qrng_state *s;
+    unsigned block_qubits;
+    const sim_op *low;
+    size_t nlow;
+    const sim_op *high;                 // Sorted by qubit
+    size_t nhigh;
+} sim_pass;
+
+// First block of a tile: the tile index with a zero bit inserted at each
+// high qubit's block-index position
+static size_t tile_block(const sim_pass *p, size_t tile) {
+    for (size_t k = 0; k < p->nhigh; k++) {
+        unsigned pos = p->high[k].qubit - p->block_qubits;
+        size_t low = tile & (((size_t)1 << pos) - 1);
+        tile = ((tile >> pos) << (pos + 1)) | low;
+    }
+    return tile;
+}
+
+static void pass_range(void *arg, size_t begin, size_t end) {
+    const sim_pass *p = arg;
+    double *re = p->s->re, *im = p->s->im;
+    size_t len = (size_t)1 << p->block_qubits;
+    size_t nblocks = (size_t)1 << p->nhigh;
+
+    for (size_t t = begin; t < end; t++) {
+        size_t first = tile_block(p, t) << p->block_qubits;
+
+        for (size_t k = 0; k < p->nhigh; k++) {
+            size_t stride = (size_t)1 << p->high[k].qubit;
+            for (size_t m = 0; m < nblocks; m++) {
+                if (m & ((size_t)1 << k)) continue;
+                size_t a = first;
+                for (size_t b = 0; b < p->nhigh; b++) {
+                    if (m & ((size_t)1 << b)) a += (size_t)1 << p->high[b].qubit;
+                }
+                apply_pairs(re + a, im + a, re + a + stride, im + a + stride, len, p->high[k].u);
+            }
+        }
+
+        for (size_t m = 0; m < nblocks && p->nlow > 0; m++) {
+            size_t a = first;
+            for (size_t b = 0; b < p->nhigh; b++) {
+                if (m & ((size_t)1 << b)) a += (size_t)1 << p->high[b].qubit;
+            }
+            for (size_t k = 0; k < p->nlow; k++) {
+                apply_local(re + a, im + a, len, p->low[k].qubit, p->low[k].u);
+            }
+        }
+    }
+}
+
+static unsigned block_qubits(const qrng_state *s) {
+    return s->qubits < QRNG_SIM_BLOCK_QUBITS ? s->qubits : QRNG_SIM_BLOCK_QUBITS;
+}
+
+// Apply single-qubit ops on distinct qubits in as few sweeps as possible:
+// all low ops and up to QRNG_SIM_FUSE_HIGH high ops per sweep
+static void run_fused(qrng_state *s, sim_op *ops, size_t nops, size_t max_threads) {
+    unsigned bq = block_qubits(s);
+    sim_op low[QRNG_SIM_MAX_QUBITS], high[QRNG_SIM_MAX_QUBITS];
+    size_t nlow = 0, nhigh = 0;
+
+    for (size_t i = 0; i < nops; i++) {
+        if (ops[i].qubit < bq) {
+            low[nlow++] = ops[i];
+        } else {
+            // Insertion sort by qubit keeps tile_block() simple
+            size_t k = nhigh++;
+            while (k > 0 && high[k - 1].qubit > ops[i].qubit) {
+                high[k] = high[k - 1];
+                k--;
+            }
+            high[k] = ops[i];
+        }
+    }
+
+    size_t done = 0;
+    do {
+        size_t take = nhigh - done < QRNG_SIM_FUSE_HIGH ? nhigh - done : QRNG_SIM_FUSE_HIGH;
+        sim_pass pass = {
+            .s = s,
+            .block_qubits = bq,
+            .low = low,
+            .nlow = done == 0 ? nlow : 0,
+            .high = high + done,
+            .nhigh = take,
+        };
+        size_t tiles = ((size_t)1 << (s->qubits - bq)) >> take;
+        sim_parallel(s, tiles, max_threads, pass_range, &pass);
+        done += take;
+    } while (done < nhigh);
+}
+
+qrng_error qrng_state_apply_u(qrng_state *s, unsigned target, const double u[8]) {
+    if (!s) return QRNG_ERROR_NULL_CONTEXT;
+    if (!u) return QRNG_ERROR_NULL_BUFFER;
+    if (target >= s->qubits) return QRNG_ERROR_INVALID_RANGE;
+
+    sim_op op = { .qubit = target };
+    memcpy(op.u, u, sizeof(op.u));
+    run_fused(s, &op, 1, 0);
+    return QRNG_SUCCESS;
+}
+
+typedef struct {
+    qrng_state *s;
+    size_t cmask;
+    size_t tmask;
+    size_t run;
+} cnot_job;
+
+// Swap the target pair wherever the control bit is set. Amplitudes below
+// the lower of the two bits form contiguous runs, so the inner loop is a
+// straight vectorisable swap.
+static void cnot_range(void *arg, size_t begin, size_t end) {
+    const cnot_job *job = arg;
+    double *re = job->s->re, *im = job->s->im;
+    size_t run = job->run;
+
+    for (size_t r = begin; r < end; r++) {
+        size_t base = r * run;
+        if (!(base & job->cmask) || (base & job->tmask)) continue;
+        double *r0 = re + base, *r1 = re + (base | job->tmask);
+        double *i0 = im + base, *i1 = im + (base | job->tmask);
+        for (size_t j = 0; j < run; j++) {
+            double t = r0[j]; r0[j] = r1[j]; r1[j] = t;
+            t = i0[j]; i0[j] = i1[j]; i1[j] = t;
+        }
+    }
+}
+
+static void apply_cnot(qrng_state *s, unsigned control, unsigned target,
+                       size_t max_threads) {
+    cnot_job job = {
+        .s = s,
+        .cmask = (size_t)1 << control,
+        .tmask = (size_t)1 << target,
+        .run = (size_t)1 << (control < target ? control : target),
+    };
+    sim_parallel(s, s->dim / job.run, max_threads, cnot_range, &job);
+}
+
+qrng_error qrng_state_apply(qrng_state *s, qrng_gate_kind kind, unsigned target,
+                            unsigned control, double theta) {
+    if (!s) return QRNG_ERROR_NULL_CONTEXT;
+    if (target >= s->qubits) return QRNG_ERROR_INVALID_RANGE;
+
+    if (kind == QRNG_GATE_CNOT) {
+        if (control >= s->qubits || control == target) return QRNG_ERROR_INVALID_RANGE;
+        apply_cnot(s, control, target, 0);
+        return QRNG_SUCCESS;
+    }
+
+    double u[8];
+    qrng_error err = qrng_gate_matrix(kind, theta, u);
+    if (err != QRNG_SUCCESS) return err;
+    return qrng_state_apply_u(s, target, u);
+}
+
+typedef struct {
+    const qrng_state *s;
+    const double *uniforms;
+    uint64_t *out;                      // Holds each shot's block until resolved
+    const double *cdf;                  // Inclusive prefix of block sums
+    const size_t *first;                // Shots of block b: order[first[b]..first[b+1])
+    const size_t *order;
+    double total;
+    double *sums;
+} sample_job;
+
+// First index in the nondecreasing a[0..n) whose value exceeds r, or n.
+// Branch-free so random shots do not pay a mispredict per step.
+static size_t upper_bound(const double *a, size_t n, double r) {
+    const double *base = a;
+    while (n > 1) {
+        size_t half = n / 2;
+        base = base[half] <= r ? base + half : base;
+        n -= half;
+    }
+    return (size_t)(base - a) + (*base <= r);
+}
+
+static void block_sum_range(void *arg, size_t begin, size_t end) {
+    sample_job *job = arg;
+    size_t len = (size_t)1 << block_qubits(job->s);
+    for (size_t b = begin; b < end; b++) {
+        const double *re = job->s->re + b * len, *im = job->s->im + b * len;
+        double sum = 0.0;
+        for (size_t j = 0; j < len; j++) sum += re[j] * re[j] + im[j] * im[j];
+        job->sums[b] = sum;
+    }
+}
+
+// Resolve every shot that landed in blocks [begin, end) against a local
+// cumulative table of the block, summed in the same order as its total
+static void resolve_range(void *arg, size_t begin, size_t end) {
+    const sample_job *job = arg;
+    unsigned bq = block_qubits(job->s);
+    size_t len = (size_t)1 << bq;
+    double local[(size_t)1 << QRNG_SIM_BLOCK_QUBITS];
+
+    for (size_t b = begin; b < end; b++) {
+        if (job->first[b] == job->first[b + 1]) continue;
+
+        const double *re = job->s->re + (b << bq), *im = job->s->im + (b << bq);
+        double acc = 0.0;
+        size_t last = 0;
+        for (size_t j = 0; j < len; j++) {
+            double p = re[j] * re[j] + im[j] * im[j];
+            acc += p;
+            local[j] = acc;
+            if (p > 0.0) last = j;
+        }
+
+        double before = b > 0 ? job->cdf[b - 1] : 0.0;
+        for (size_t k = job->first[b]; k < job->first[b + 1]; k++) {
+            size_t shot = job->order[k];
+            double r = job->uniforms[shot] * job->total - before;
+
+            // First amplitude whose running sum passes r; rounding past the
+            // end falls back to the last nonzero amplitude
+            size_t lo = upper_bound(local, len, r);
+            if (lo > last) lo = last;
+            job->out[shot] = ((uint64_t)b << bq) | lo;
+        }
+    }
+}
+
+qrng_error qrng_state_sample(const qrng_state *s, const double *uniforms,
+                             size_t shots, uint64_t *out) {
+    if (!s) return QRNG_ERROR_NULL_CONTEXT;
+    if (!uniforms || !out) return QRNG_ERROR_NULL_BUFFER;
+    if (shots == 0) return QRNG_SUCCESS;
+
+    size_t nblocks = (size_t)1 << (s->qubits - block_qubits(s));
+    double *cdf = malloc(nblocks * sizeof(double));
+    size_t *first = calloc(nblocks + 1, sizeof(size_t));
+    size_t *order = malloc(shots * sizeof(size_t));
+    if (!cdf || !first || !order) {
+        free(cdf);
+        free(first);
+        free(order);
+        return QRNG_ERROR_NULL_BUFFER;
+    }
+
+    sample_job job = { .s = s, .uniforms = uniforms, .out = out, .sums = cdf };
+    sim_parallel(s, nblocks, 0, block_sum_range, &job);
+
+    size_t last = 0;
+    for (size_t b = 0; b < nblocks; b++) {
+        if (cdf[b] > 0.0) last = b;
+        if (b > 0) cdf[b] += cdf[b - 1];
+    }
+    double total = cdf[nblocks - 1];
+
+    // Bucket shots by block: binary search the block table, then a
+    // counting sort so each block's shots are contiguous in order[]
+    for (size_t i = 0; i < shots; i++) {
+        size_t lo = upper_bound(cdf, nblocks, uniforms[i] * total);
+        if (lo > last) lo = last;
+        out[i] = lo;
+        first[lo]++;
+    }
+    for (size_t b = 1; b < nblocks; b++) first[b] += first[b - 1];
+    first[nblocks] = shots;
+    for (size_t i = shots; i-- > 0;) {
+        order[--first[out[i]]] = i;
+    }
+
+    job.cdf = cdf;
+    job.first = first;
+    job.order = order;
+    job.total = total;
+    sim_parallel(s, nblocks, 0, resolve_range, &job);
+
+    free(cdf);
+    free(first);
+    free(order);
+    return QRNG_SUCCESS;
+}
+
+typedef struct {
+    qrng_gate_kind kind;
+    unsigned target;
+    unsigned control;
+    double theta;
+} circuit_gate;
+
+struct qrng_circuit {
+    circuit_gate *gates;
+    size_t length;
+    size_t capacity;
+};
+
+qrng_circuit *qrng_circuit_create(void) {
+    return calloc(1, sizeof(qrng_circuit));
+}
+
+void qrng_circuit_destroy(qrng_circuit *c) {
+    if (c) {
+        free(c->gates);
+        free(c);
+    }
+}
+
+qrng_error qrng_circuit_add(qrng_circuit *c, qrng_gate_kind kind, unsigned target,
+                            unsigned control, double theta) {
+    if (!c) return QRNG_ERROR_NULL_CONTEXT;
+    if (kind < QRNG_GATE_H || kind > QRNG_GATE_CNOT) return QRNG_ERROR_INVALID_RANGE;
+    if (kind == QRNG_GATE_CNOT && control == target) return QRNG_ERROR_INVALID_RANGE;
+
+    if (c->length == c->capacity) {
+        size_t capacity = c->capacity ? c->capacity * 2 : 16;
+        circuit_gate *gates = realloc(c->gates, capacity * sizeof(circuit_gate));
+        if (!gates) return QRNG_ERROR_NULL_BUFFER;
+        c->gates = gates;
+        c->capacity = capacity;
+    }
+
+    c->gates[c->length++] = (circuit_gate){ kind, target, control, theta };
+    return QRNG_SUCCESS;
+}
+
+size_t qrng_circuit_length(const qrng_circuit *c) {
+    return c ? c->length : 0;
+}
+
+// p = g * p, i.e. g applied after p
+static void matrix_mul(const double g[8], double p[8]) {
+    double r[8];
+    for (int row = 0; row < 2; row++) {
+        for (int col = 0; col < 2; col++) {
+            const double *a = g + row * 4, *b0 = p + col * 2, *b1 = p + 4 + col * 2;
+            r[row * 4 + col * 2] = a[0] * b0[0] - a[1] * b0[1] + a[2] * b1[0] - a[3] * b1[1];
+            r[row * 4 + col * 2 + 1] = a[0] * b0[1] + a[1] * b0[0] + a[2] * b1[1] + a[3] * b1[0];
+        }
+    }
+    memcpy(p, r, sizeof(r));
+}
+
+qrng_error qrng_circuit_run(const qrng_circuit *c, qrng_state *s, size_t max_threads) {
+    if (!c || !s) return QRNG_ERROR_NULL_CONTEXT;
+
+    for (size_t i = 0; i < c->length; i++) {
+        const circuit_gate *g = &c->gates[i];
+        if (g->target >= s->qubits) return QRNG_ERROR_INVALID_RANGE;
+        if (g->kind == QRNG_GATE_CNOT && g->control >= s->qubits) return QRNG_ERROR_INVALID_RANGE;
+    }
+
+    // Pending single-qubit matrices, at most one per qubit
+    sim_op pending[QRNG_SIM_MAX_QUBITS];
+    int slot[QRNG_SIM_MAX_QUBITS];
+    size_t npending = 0;
+    for (unsigned q = 0; q < s->qubits; q++) slot[q] = -1;
+
+    for (size_t i = 0; i < c->length; i++) {
+        const circuit_gate *g = &c->gates[i];
+
+        if (g->kind == QRNG_GATE_CNOT) {
+            // Pending gates on other qubits commute with the CNOT
+            if (slot[g->target] >= 0 || slot[g->control] >= 0) {
+                run_fused(s, pending, npending, max_threads);
+                for (size_t k = 0; k < npending; k++) slot[pending[k].qubit] = -1;
+                npending = 0;
+            }
+            apply_cnot(s, g->control, g->target, max_threads);
+            continue;
+        }
+
+        double u[8];
+        qrng_gate_matrix(g->kind, g->theta, u);
+        if (slot[g->target] < 0) {
+            slot[g->target] = (int)npending;
+            pending[npending].qubit = g->target;
+            memcpy(pending[npending].u, u, sizeof(u));
+            npending++;
+        } else {
+            matrix_mul(u, pending[slot[g->target]].u);
+        }
+    }
+
+    if (npending > 0) run_fused(s, pending, npending, max_threads);
+    return QRNG_SUCCESS;
+}
+
+double qrng_state_probability(const qrng_state *s, unsigned qubit) {
+    if (!s || qubit >= s->qubits) return 0.0;
+
+    size_t stride = (size_t)1 << qubit;
+    double zero = 0.0, one = 0.0;
+    for (size_t base = 0; base < s->dim; base += 2 * stride) {
+        const double *r0 = s->re + base, *i0 = s->im + base;
+        const double *r1 = r0 + stride, *i1 = i0 + stride;
+        for (size_t j = 0; j < stride; j++) {
+            zero += r0[j] * r0[j] + i0[j] * i0[j];
+            one += r1[j] * r1[j] + i1[j] * i1[j];
+        }
+    }
+    return zero + one > 0 ? one / (zero + one) : 0.0;
+}
+
+int qrng_state_measure(qrng_state *s, unsigned qubit, double r) {
+    if (!s || qubit >= s->qubits) return -1;
+
+    double p1 = qrng_state_probability(s, qubit);
+    int outcome = r < p1;
+    double p = outcome ? p1 : 1.0 - p1;
+    double scale = p > 0 ? 1.0 / sqrt(p) : 0.0;
+
+    // Zero the rejected half and renormalise the kept one
+    size_t stride = (size_t)1 << qubit;
+    for (size_t base = 0; base < s->dim; base += 2 * stride) {
+        double *keep_r = s->re + base + (outcome ? stride : 0);
+        double *keep_i = s->im + base + (outcome ? stride : 0);
+        double *drop_r = s->re + base + (outcome ? 0 : stride);
+        double *drop_i = s->im + base + (outcome ? 0 : stride);
+        for (size_t j = 0; j < stride; j++) {
+            keep_r[j] *= scale;
+            keep_i[j] *= scale;
+            drop_r[j] = 0.0;
+            drop_i[j] = 0.0;
+        }
+    }
+    return outcome;
+}
+
+uint64_t qrng_state_measure_all(qrng_state *s, double r) {
+    if (!s) return 0;
+
+    double total = 0.0;
+    for (size_t i = 0; i < s->dim; i++) {
+        total += s->re[i] * s->re[i] + s->im[i] * s->im[i];
+    }
+
+    // Walk the cumulative distribution; rounding leaves the last nonzero
+    // amplitude as the fallback
+    double target = r * total, acc = 0.0;
+    size_t outcome = 0;
+    for (size_t i = 0; i < s->dim; i++) {
+        double p = s->re[i] * s->re[i] + s->im[i] * s->im[i];
+        if (p == 0.0) continue;
+        outcome = i;
+        acc += p;
+        if (acc > target) break;
+    }
+
+    qrng_state_reset(s);
+    s->re[0] = 0.0;
+    s->re[outcome] = 1.0;
+    return outcome;
+}
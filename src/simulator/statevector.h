@@ -0,0 +1,217 @@
+#ifndef QUANTUM_STATEVECTOR_H
+#define QUANTUM_STATEVECTOR_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include "quantum_rng.h"
+#include "region.h"
+
+/**
+ * @file statevector.h
+ * @brief State-vector quantum circuit simulator
+ *
+ * Holds all 2^n complex amplitudes of an n-qubit register, with real and
+ * imaginary parts in separate 64-byte aligned arrays so gate kernels load
+ * whole vectors of amplitudes. Basis index bit q is qubit q. Single-qubit
+ * gates on qubits whose partner amplitudes share a vector are applied with
+ * in-register permutes; higher qubits pair whole vectors. Both arrays live
+ * in one region, on hugepages from 2 MiB up to keep TLB misses off the
+ * high-qubit strides.
+ *
+ * Registers of 2^16 amplitudes and up are swept on the shared thread pool
+ * with a fixed split, and zeroed with the same split, so low-qubit passes
+ * mostly touch pages their worker placed. Workers are not pinned and
+ * high-qubit passes cross slices, so NUMA locality is best-effort. A
+ * qrng_circuit batches gates so runs of single-qubit gates are fused into
+ * as few sweeps over memory as possible.
+ */
+
+#define QRNG_SIM_MAX_QUBITS 28         /**< 2^28 amplitudes, 4 GiB */
+
+/**
+ * @brief Gates understood by qrng_state_apply()
+ */
+typedef enum {
+    QRNG_GATE_H = 0,                   /**< Hadamard */
+    QRNG_GATE_X,                       /**< Pauli X */
+    QRNG_GATE_Y,                       /**< Pauli Y */
+    QRNG_GATE_Z,                       /**< Pauli Z */
+    QRNG_GATE_S,                       /**< Phase pi/2 */
+    QRNG_GATE_T,                       /**< Phase pi/4 */
+    QRNG_GATE_PHASE,                   /**< diag(1, e^(i theta)) */
+    QRNG_GATE_RX,                      /**< exp(-i theta X / 2) */
+    QRNG_GATE_RY,                      /**< exp(-i theta Y / 2) */
+    QRNG_GATE_RZ,                      /**< exp(-i theta Z / 2) */
+    QRNG_GATE_CNOT                     /**< Controlled X */
+} qrng_gate_kind;
+
+/**
+ * @brief Simulated register
+ */
+typedef struct qrng_state {
+    unsigned qubits;
+    size_t dim;                        /**< 2^qubits */
+    double *re;                        /**< Real parts, 64-byte aligned */
+    double *im;                        /**< Imaginary parts, 64-byte aligned */
+    qrng_region mem;                   /**< Backing memory of re and im */
+} qrng_state;
+
+/**
+ * @brief Allocate a register in |0...0>
+ *
+ * @param qubits Number of qubits, 1 to QRNG_SIM_MAX_QUBITS
+ * @return New register, or NULL on invalid size or allocation failure
+ */
+qrng_state *qrng_state_create(unsigned qubits);
+
+/**
+ * @brief Free a register
+ *
+ * @param s Register to free
+ */
+void qrng_state_destroy(qrng_state *s);
+
+/**
+ * @brief Return a register to |0...0>
+ *
+ * @param s Register
+ */
+void qrng_state_reset(qrng_state *s);
+
+/**
+ * @brief Build the 2x2 unitary of a single-qubit gate
+ *
+ * @param kind Gate, not QRNG_GATE_CNOT
+ * @param theta Angle for PHASE and rotations, ignored otherwise
+ * @param u[out] Row-major matrix as re/im pairs: u00, u01, u10, u11
+ * @return QRNG_SUCCESS, or QRNG_ERROR_INVALID_RANGE for an unknown gate
+ */
+qrng_error qrng_gate_matrix(qrng_gate_kind kind, double theta, double u[8]);
+
+/**
+ * @brief Apply an arbitrary single-qubit unitary
+ *
+ * @param s Register
+ * @param target Qubit
+ * @param u Matrix in the qrng_gate_matrix() layout
+ * @return QRNG_SUCCESS on success, error code on failure
+ */
+qrng_error qrng_state_apply_u(qrng_state *s, unsigned target, const double u[8]);
+
+/**
+ * @brief Apply a gate
+ *
+ * @param s Register
+ * @param kind Gate
+ * @param target Target qubit
+ * @param control Control qubit, used by QRNG_GATE_CNOT only
+ * @param theta Angle for PHASE and rotations
+ * @return QRNG_SUCCESS on success, error code on failure
+ */
+qrng_error qrng_state_apply(qrng_state *s, qrng_gate_kind kind, unsigned target,
+                            unsigned control, double theta);
+
+/**
+ * @brief Probability of measuring a qubit as 1
+ *
+ * @param s Register
+ * @param qubit Qubit
+ * @return Probability, or 0 for an invalid qubit
+ */
+double qrng_state_probability(const qrng_state *s, unsigned qubit);
+
+/**
+ * @brief Measure one qubit and collapse the register
+ *
+ * @param s Register
+ * @param qubit Qubit
+ * @param r Uniform sample in [0, 1) that decides the outcome
+ * @return Outcome 0 or 1, or -1 for an invalid qubit
+ */
+int qrng_state_measure(qrng_state *s, unsigned qubit, double r);
+
+/**
+ * @brief Measure every qubit and collapse to a basis state
+ *
+ * @param s Register
+ * @param r Uniform sample in [0, 1) that decides the outcome
+ * @return Basis index of the outcome
+ */
+uint64_t qrng_state_measure_all(qrng_state *s, double r);
+
+/**
+ * @brief Draw measurement outcomes without collapsing the register
+ *
+ * Sums |amplitude|^2 per cache block into a cumulative table, locates each
+ * shot's block in it, then walks only the blocks that received shots,
+ * building a local cumulative table once per block. The register is not
+ * modified, so any number of batches can be drawn from one prepared state.
+ *
+ * @param s Register
+ * @param uniforms One uniform sample in [0, 1) per shot
+ * @param shots Number of shots
+ * @param out[out] Receives the basis index of each shot
+ * @return QRNG_SUCCESS on success, error code on failure
+ */
+qrng_error qrng_state_sample(const qrng_state *s, const double *uniforms,
+                             size_t shots, uint64_t *out);
+
+/**
+ * @brief Gate list applied to a register in one call
+ */
+typedef struct qrng_circuit qrng_circuit;
+
+/**
+ * @brief Allocate an empty circuit
+ *
+ * @return New circuit, or NULL on allocation failure
+ */
+qrng_circuit *qrng_circuit_create(void);
+
+/**
+ * @brief Free a circuit
+ *
+ * @param c Circuit to free
+ */
+void qrng_circuit_destroy(qrng_circuit *c);
+
+/**
+ * @brief Append a gate
+ *
+ * Qubit indices are checked against the register when the circuit runs.
+ *
+ * @param c Circuit
+ * @param kind Gate
+ * @param target Target qubit
+ * @param control Control qubit, used by QRNG_GATE_CNOT only
+ * @param theta Angle for PHASE and rotations
+ * @return QRNG_SUCCESS on success, error code on failure
+ */
+qrng_error qrng_circuit_add(qrng_circuit *c, qrng_gate_kind kind, unsigned target,
+                            unsigned control, double theta);
+
+/**
+ * @brief Number of gates in a circuit
+ *
+ * @param c Circuit
+ * @return Gate count
+ */
+size_t qrng_circuit_length(const qrng_circuit *c);
+
+/**
+ * @brief Apply a circuit to a register
+ *
+ * Consecutive single-qubit gates on one qubit are multiplied into a single
+ * matrix, and single-qubit gates are carried past CNOTs on other qubits.
+ * Each resulting group is applied in one sweep covering every qubit below
+ * the cache block plus up to three above it. Nothing is applied if any gate
+ * is out of range for the register.
+ *
+ * @param c Circuit
+ * @param s Register
+ * @param max_threads Upper bound on threads used (0 for all)
+ * @return QRNG_SUCCESS on success, error code on failure
+ */
+qrng_error qrng_circuit_run(const qrng_circuit *c, qrng_state *s, size_t max_threads);
+
+#endif /* QUANTUM_STATEVECTOR_H */